@@ -31,15 +31,55 @@
  * OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "bench.h"
+#include <rfc7748_precomputed.h>
 #include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "clocks.h"
 
-int main(void) {
-  printf("== Start of Benchmark ===\n");
+/**
+ * Usage: bench [--latency [--csv]] [--perf]
+ * By default every operation reports its average cost; --latency times
+ * each call and reports percentiles, as CSV rows with --csv. --perf adds
+ * hardware counters per operation to the averages.
+ */
+int main(int argc, char *argv[]) {
+  int i;
+  for (i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--latency") == 0 && latency_mode == 0) {
+      latency_mode = LATENCY_TEXT;
+    } else if (strcmp(argv[i], "--csv") == 0) {
+      latency_mode = LATENCY_CSV;
+    } else if (strcmp(argv[i], "--perf") == 0) {
+      if (counters_init() == 0) {
+        fprintf(stderr, "--perf: no hardware counters available\n");
+      }
+    } else {
+      fprintf(stderr, "usage: %s [--latency [--csv]] [--perf]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (latency_mode != LATENCY_CSV) {
+    printf("== Start of Benchmark ===\n");
+  }
   bench_fp25519_x64();
+  if (RFC7748_HasImpl(RFC7748_IMPL_BMI2)) {
+    bench_fp25519_x64_bmi2();
+  }
+  if (RFC7748_HasImpl(RFC7748_IMPL_ADX)) {
+    bench_fp25519_x64_adx();
+  }
   bench_x25519();
   bench_fp448_x64();
+  if (RFC7748_HasImpl(RFC7748_IMPL_BMI2)) {
+    bench_fp448_x64_bmi2();
+  }
+  if (RFC7748_HasImpl(RFC7748_IMPL_ADX)) {
+    bench_fp448_x64_adx();
+  }
   bench_x448();
-  printf("== End of Benchmark =====\n");
+  if (latency_mode != LATENCY_CSV) {
+    printf("== End of Benchmark =====\n");
+  }
   return 0;
 }
@@ -35,8 +35,12 @@
 #define BENCH_H
 
 void bench_fp25519_x64();
+void bench_fp25519_x64_bmi2();
+void bench_fp25519_x64_adx();
 void bench_x25519();
 void bench_fp448_x64();
+void bench_fp448_x64_bmi2();
+void bench_fp448_x64_adx();
 void bench_x448();
 
 #endif /* BENCH_H */
@@ -32,6 +32,7 @@
  */
 
 #include <fp25519_x64.h>
+#include <safegcd_x64.h>
 #include <stdio.h>
 #include "clocks.h"
 #include "random.h"
@@ -40,11 +41,60 @@ static void random_EltFp25519_1w_x64(uint64_t *A) {
   random_bytes((uint8_t *)A, SIZE_BYTES_FP25519);
 }
 
-void bench_fp25519_x64(void) {
+#ifdef X64_VARIANT
+#define STR_(x) #x
+#define STR(x) STR_(x)
+#define VARIANT STR(X64_VARIANT)
+#else
+#define VARIANT ""
+#endif
+
+/**
+ * The ladder step as a sequence of calls to the field functions, as it was
+ * computed before ladder_step_EltFp25519_x64; used as a baseline.
+ */
+static void ladder_step_calls(uint64_t *const P, uint64_t *const X1,
+                              uint64_t swap) {
+  EltFp25519_2w_Buffer_x64 buffer;
+  ALIGN uint64_t workspace[6 * NUM_WORDS_ELTFP25519_X64];
+  uint64_t *const buffer_1w = buffer;
+  uint64_t *const buffer_2w = buffer;
+  uint64_t *const X2 = P + 0, *const Z2 = P + 4;
+  uint64_t *const X3 = P + 8, *const Z3 = P + 12;
+  uint64_t *const A = workspace + 0, *const B = workspace + 4;
+  uint64_t *const D = workspace + 8, *const C = workspace + 12;
+  uint64_t *const DA = workspace + 16, *const CB = workspace + 20;
+  const uint64_t mask = -swap;
+  int i;
+
+  add_EltFp25519_1w_x64(A, X2, Z2);
+  sub_EltFp25519_1w_x64(B, X2, Z2);
+  add_EltFp25519_1w_x64(C, X3, Z3);
+  sub_EltFp25519_1w_x64(D, X3, Z3);
+  mul_EltFp25519_2w_x64(DA, A, D);
+  for (i = 0; i < NUM_WORDS_ELTFP25519_X64; i++) {
+    A[i] ^= (A[i] ^ C[i]) & mask;
+    B[i] ^= (B[i] ^ D[i]) & mask;
+  }
+  sqr_EltFp25519_2w_x64(A);
+  add_EltFp25519_1w_x64(X3, DA, CB);
+  sub_EltFp25519_1w_x64(Z3, DA, CB);
+  sqr_EltFp25519_2w_x64(X3);
+  copy_EltFp25519_1w_x64(X2, B);
+  sub_EltFp25519_1w_x64(Z2, A, B);
+  mul_a24_EltFp25519_1w_x64(B, Z2);
+  add_EltFp25519_1w_x64(B, B, X2);
+  mul_EltFp25519_2w_x64(X2, X2, A);
+  mul_EltFp25519_1w_x64(Z3, Z3, X1);
+}
+
+void X64_SYMBOL(bench_fp25519_x64)(void) {
+  int i;
   int BENCH = 3000;
 
   EltFp25519_1w_x64 a, b, c;
   EltFp25519_2w_x64 BB, CC;
+  ALIGN uint64_t P[4 * NUM_WORDS_ELTFP25519_X64];
   EltFp25519_1w_Buffer_x64 buffer_1w;
   EltFp25519_2w_Buffer_x64 buffer_2w;
 
@@ -52,8 +102,8 @@ void bench_fp25519_x64(void) {
   random_EltFp25519_1w_x64(b);
   random_EltFp25519_1w_x64(c);
 
-  printf("=== GF(2^255-19) ===\n");
-  printf("== 1-way x64 \n");
+  bench_section("=== GF(2^255-19) ===");
+  bench_section("== 1-way x64%s", VARIANT);
   CLOCKS("add", add_EltFp25519_1w_x64(c, a, b));
   CLOCKS("sub", sub_EltFp25519_1w_x64(c, a, b));
   CLOCKS("mul", mul_EltFp25519_1w_x64(c, c, b));
@@ -61,10 +111,20 @@ void bench_fp25519_x64(void) {
   CLOCKS("sqr", sqr_EltFp25519_1w_x64(c));
 
   BENCH /= 10;
+  CLOCKS("sqr x100", for (i = 0; i < 100; i++) { sqr_EltFp25519_1w_x64(c); });
+  CLOCKS("sqrn 100", sqrn_EltFp25519_1w_x64(c, c, 100));
   CLOCKS("inv", inv_EltFp25519_1w_x64(c, a));
+  CLOCKS("inv gcd", inv_safegcd_EltFp25519_1w_x64(c, a));
   BENCH *= 10;
 
-  printf("== 2-way x64 \n");
+  bench_section("== 2-way x64%s", VARIANT);
   CLOCKS("mul", mul_EltFp25519_2w_x64(CC, CC, BB));
   CLOCKS("sqr", sqr_EltFp25519_2w_x64(CC));
+
+  for (i = 0; i < 4; i++) {
+    random_EltFp25519_1w_x64(P + NUM_WORDS_ELTFP25519_X64 * i);
+  }
+  bench_section("== Ladder step x64%s", VARIANT);
+  CLOCKS("calls", ladder_step_calls(P, a, 1));
+  CLOCKS("fused", ladder_step_EltFp25519_x64(P, a, 1));
 }
@@ -32,6 +32,7 @@
  */
 
 #include <fp448_x64.h>
+#include <safegcd_x64.h>
 #include <stdio.h>
 #include "clocks.h"
 #include "random.h"
@@ -40,18 +41,29 @@ static void random_EltFp448_1w_x64(uint64_t *A) {
   random_bytes((uint8_t *)A, SIZE_BYTES_FP448);
 }
 
-void bench_fp448_x64(void) {
+#ifdef X64_VARIANT
+#define STR_(x) #x
+#define STR(x) STR_(x)
+#define VARIANT STR(X64_VARIANT)
+#else
+#define VARIANT ""
+#endif
+
+void X64_SYMBOL(bench_fp448_x64)(void) {
+  int i;
   int BENCH = 3000;
 
   EltFp448_1w_x64 a, b, c;
+  EltFp448_2w_x64 BB, CC;
   EltFp448_1w_Buffer_x64 buffer_1w;
+  EltFp448_2w_Buffer_x64 buffer_2w;
 
   random_EltFp448_1w_x64(a);
   random_EltFp448_1w_x64(b);
   random_EltFp448_1w_x64(c);
 
-  printf("= GF(2^448-2^224-1) =\n");
-  printf("== 1-way x64 \n");
+  bench_section("= GF(2^448-2^224-1) =");
+  bench_section("== 1-way x64%s", VARIANT);
   CLOCKS("add", add_EltFp448_1w_x64(c, a, b));
   CLOCKS("sub", sub_EltFp448_1w_x64(c, a, b));
   CLOCKS("mul", mul_EltFp448_1w_x64(c, c, b));
@@ -59,5 +71,13 @@ void bench_fp448_x64(void) {
   CLOCKS("sqr", sqr_EltFp448_1w_x64(c));
 
   BENCH /= 10;
+  CLOCKS("sqr x100", for (i = 0; i < 100; i++) { sqr_EltFp448_1w_x64(c); });
+  CLOCKS("sqrn 100", sqrn_EltFp448_1w_x64(c, c, 100));
   CLOCKS("inv", inv_EltFp448_1w_x64(c, a));
+  CLOCKS("inv gcd", inv_safegcd_EltFp448_1w_x64(c, a));
+  BENCH *= 10;
+
+  bench_section("== 2-way x64%s", VARIANT);
+  CLOCKS("mul", mul_EltFp448_2w_x64(CC, CC, BB));
+  CLOCKS("sqr", sqr_EltFp448_2w_x64(CC));
 }
@@ -43,11 +43,26 @@ void bench_x25519(void) {
   X25519_KEY secret_key;
   X25519_KEY public_key;
   X25519_KEY shared_secret;
+  static X25519_PEER_TABLE peer_table;
 
-  printf("===== X225519  =====\n");
+  bench_section("===== X225519  =====");
   oper_second(random_X25519_key(secret_key), "KeyGen",
               X25519_KeyGen(public_key, secret_key));
   oper_second(random_X25519_key(secret_key);
               random_X25519_key(public_key), "Shared",
               X25519_Shared(shared_secret, public_key, secret_key));
+
+  RFC7748_SetTable(RFC7748_TABLE_NONE);
+  oper_second(random_X25519_key(secret_key), "KeyGen no table",
+              X25519_KeyGen(public_key, secret_key));
+  RFC7748_SetTable(RFC7748_TABLE_COMB);
+  oper_second(random_X25519_key(secret_key), "KeyGen comb",
+              X25519_KeyGen(public_key, secret_key));
+  RFC7748_SetTable(RFC7748_TABLE_LADDER);
+
+  oper_second(random_X25519_key(secret_key);
+              X25519_KeyGen(public_key, secret_key), "Precompute",
+              X25519_Precompute(peer_table, public_key));
+  oper_second(random_X25519_key(secret_key), "Shared peer",
+              X25519_Shared_peer(shared_secret, peer_table, secret_key));
 }
@@ -44,11 +44,26 @@ void bench_x448(void) {
   X448_KEY secret_key;
   X448_KEY public_key;
   X448_KEY shared_secret;
+  static X448_PEER_TABLE peer_table;
 
-  printf("===== X448  =====\n");
+  bench_section("===== X448  =====");
   oper_second(random_X448_key(secret_key), "KeyGen",
               X448_KeyGen(public_key, secret_key));
   oper_second(random_X448_key(secret_key);
               random_X448_key(public_key), "Shared",
               X448_Shared(shared_secret, public_key, secret_key));
+
+  RFC7748_SetTable(RFC7748_TABLE_NONE);
+  oper_second(random_X448_key(secret_key), "KeyGen no table",
+              X448_KeyGen(public_key, secret_key));
+  RFC7748_SetTable(RFC7748_TABLE_COMB);
+  oper_second(random_X448_key(secret_key), "KeyGen comb",
+              X448_KeyGen(public_key, secret_key));
+  RFC7748_SetTable(RFC7748_TABLE_LADDER);
+
+  oper_second(random_X448_key(secret_key);
+              X448_KeyGen(public_key, secret_key), "Precompute",
+              X448_Precompute(peer_table, public_key));
+  oper_second(random_X448_key(secret_key), "Shared peer",
+              X448_Shared_peer(shared_secret, peer_table, secret_key));
 }
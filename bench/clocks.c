@@ -32,7 +32,12 @@
  */
 
 #include "clocks.h"
+#include "perf.h"
+#include <inttypes.h>
+#include <stdarg.h>
+#include <string.h>
 #include <sys/time.h>
+#include <time.h>
 
 uint64_t time_now() {
   struct timeval tv;
@@ -62,3 +67,170 @@ uint64_t cycles_now(void) {
   return 0; /* Undefined for now; should be obvious in the output */
 #endif
 }
+
+int latency_mode = 0;
+
+/* Titles given to bench_section, reported in the CSV columns */
+static char group[64], section[64];
+
+/**
+ * Prints a title of the benchmark ("=== GF(2^255-19) ===" or "== 1-way
+ * x64"), and keeps it for the CSV rows that follow; in CSV mode only the
+ * rows are printed.
+ */
+void bench_section(const char *format, ...) {
+  char line[64];
+  char *title = line, *end;
+  va_list args;
+
+  va_start(args, format);
+  vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+  if (latency_mode != LATENCY_CSV) {
+    printf("%s\n", line);
+  }
+  while (*title == '=') {
+    title++;
+  }
+  /* Titles of a part within a field or curve start with "==" */
+  const int top = title - line != 2;
+  while (*title == ' ') {
+    title++;
+  }
+  end = title + strlen(title);
+  while (end > title && (end[-1] == '=' || end[-1] == ' ')) {
+    end--;
+  }
+  *end = 0;
+  if (top) {
+    strcpy(group, title);
+    section[0] = 0;
+  } else {
+    strcpy(section, title);
+  }
+}
+
+/* Cycles taken by a pair of rdtscp_fenced() around nothing */
+static uint64_t timer_overhead(void) {
+  static uint64_t overhead = UINT64_MAX;
+  uint64_t t;
+  int i;
+
+  for (i = 0; overhead == UINT64_MAX && i < 10000; i++) {
+    t = rdtscp_fenced();
+    t = rdtscp_fenced() - t;
+    overhead = t < overhead ? t : overhead;
+  }
+  return overhead;
+}
+
+/* Time stamp counter ticks per nanosecond, measured over 50 ms */
+static double tsc_per_ns(void) {
+  static double ratio = 0;
+  struct timespec start, now;
+  uint64_t start_c, ns;
+
+  if (ratio == 0) {
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    start_c = rdtscp_fenced();
+    do {
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      ns = (now.tv_sec - start.tv_sec) * 1000000000ULL + now.tv_nsec -
+           start.tv_nsec;
+    } while (ns < 50000000);
+    ratio = (double)(rdtscp_fenced() - start_c) / ns;
+  }
+  return ratio;
+}
+
+static int compare_u64(const void *a, const void *b) {
+  const uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * Sorts the cycles taken by each of the n operations, less the overhead
+ * of the timer, and prints min/p50/p90/p99/p99.9/max in cycles and ns.
+ */
+void latency_report(const char *label, uint64_t *samples, long n) {
+  static const double ranks[] = {0, 0.50, 0.90, 0.99, 0.999, 1};
+  static int header = 0;
+  const uint64_t overhead = timer_overhead();
+  const double ratio = tsc_per_ns();
+  uint64_t cycles[6];
+  long i, rank;
+
+  for (i = 0; i < n; i++) {
+    samples[i] = samples[i] > overhead ? samples[i] - overhead : 0;
+  }
+  qsort(samples, n, sizeof(uint64_t), compare_u64);
+  for (i = 0; i < 6; i++) {
+    /* Nearest rank */
+    rank = (long)(ranks[i] * n + 0.999999) - 1;
+    cycles[i] = samples[rank < 0 ? 0 : rank];
+  }
+  if (latency_mode == LATENCY_CSV) {
+    if (!header) {
+      printf("group,section,operation,samples,"
+             "min_cc,p50_cc,p90_cc,p99_cc,p999_cc,max_cc,"
+             "min_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n");
+      header = 1;
+    }
+    printf("\"%s\",\"%s\",\"%s\",%ld", group, section, label, n);
+    for (i = 0; i < 6; i++) {
+      printf(",%" PRIu64, cycles[i]);
+    }
+    for (i = 0; i < 6; i++) {
+      printf(",%.1f", cycles[i] / ratio);
+    }
+    printf("\n");
+  } else {
+    printf("%-8s: min/p50/p90/p99/p99.9/max %" PRIu64 "/%" PRIu64
+           "/%" PRIu64 "/%" PRIu64 "/%" PRIu64 "/%" PRIu64 " cc, "
+           "%.0f/%.0f/%.0f/%.0f/%.0f/%.0f ns\n",
+           label, cycles[0], cycles[1], cycles[2], cycles[3], cycles[4],
+           cycles[5], cycles[0] / ratio, cycles[1] / ratio, cycles[2] / ratio,
+           cycles[3] / ratio, cycles[4] / ratio, cycles[5] / ratio);
+  }
+}
+
+static PerfCounters counters;
+static double counts[PERF_NUM_EVENTS];
+static int counters_on = 0;
+
+int counters_init(void) {
+  const int available = perf_open(&counters);
+  counters_on = available > 0;
+  return available;
+}
+
+void counters_begin(void) {
+  if (counters_on) {
+    perf_start(&counters);
+  }
+}
+
+void counters_end(void) {
+  if (counters_on) {
+    perf_stop(&counters, counts);
+  }
+}
+
+void counters_print(uint64_t ops) {
+  static const char *const labels[PERF_NUM_EVENTS] = {
+      "insn", "cycles", "br-miss", "L1D-miss", "LLC-miss"};
+  int i;
+
+  for (i = 0; counters_on && i < PERF_NUM_EVENTS; i++) {
+    if (counts[i] >= 0) {
+      printf(", %.1f %s", counts[i] / ops, labels[i]);
+    } else {
+      printf(", n/a %s", labels[i]);
+    }
+  }
+  if (counters_on && counts[PERF_INSTRUCTIONS] >= 0 &&
+      counts[PERF_CYCLES] > 0) {
+    printf(", %.2f IPC", counts[PERF_INSTRUCTIONS] / counts[PERF_CYCLES]);
+  }
+  printf("\n");
+}
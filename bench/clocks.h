@@ -44,8 +44,58 @@
 #define BARRIER __asm__ __volatile__("" ::: "memory")
 #endif
 
+/**
+ * Reads the time stamp counter once every earlier instruction has
+ * executed (RDTSCP), and before any later one starts (LFENCE).
+ */
+static inline uint64_t rdtscp_fenced(void) {
+  uint32_t lo, hi;
+  __asm__ __volatile__(
+      "rdtscp\n\t"
+      "lfence"
+      : "=a"(lo), "=d"(hi)::"%rcx", "memory");
+  return ((uint64_t)hi << 32) | lo;
+}
+
+/**
+ * Set by bench --latency (LATENCY_TEXT) or --latency --csv (LATENCY_CSV):
+ * CLOCKS and oper_second then time every operation on its own.
+ */
+#define LATENCY_TEXT 1
+#define LATENCY_CSV 2
+extern int latency_mode;
+
+#define LATENCY_SAMPLES 100000
+
+#define LATENCY(RANDOM, LABEL, FUNCTION, SAMPLES)                         \
+  do {                                                                    \
+    uint64_t *samples_ = (uint64_t *)malloc(SAMPLES * sizeof(uint64_t)); \
+    uint64_t t_;                                                          \
+    long s_;                                                              \
+    if (samples_ == NULL) {                                               \
+      fprintf(stderr, "%s: no memory for %ld samples\n", LABEL,           \
+              (long)(SAMPLES));                                           \
+      break;                                                              \
+    }                                                                     \
+    RANDOM;                                                               \
+    for (s_ = 0; s_ < SAMPLES / 10; s_++) {                               \
+      FUNCTION;                                                           \
+    }                                                                     \
+    for (s_ = 0; s_ < SAMPLES; s_++) {                                    \
+      t_ = rdtscp_fenced();                                               \
+      FUNCTION;                                                           \
+      samples_[s_] = rdtscp_fenced() - t_;                                \
+    }                                                                     \
+    latency_report(LABEL, samples_, SAMPLES);                             \
+    free(samples_);                                                       \
+  } while (0)
+
 #define CLOCKS_RANDOM(RANDOM, LABEL, FUNCTION)                           \
   do {                                                                   \
+    if (latency_mode) {                                                  \
+      LATENCY(RANDOM, LABEL, FUNCTION, LATENCY_SAMPLES);                 \
+      break;                                                             \
+    }                                                                    \
     uint64_t start, end;                                                 \
     int64_t i_bench, j_bench;                                            \
     unsigned cycles_high0, cycles_low0;                                  \
@@ -58,6 +108,7 @@
         : "=r"(cycles_high0), "=r"(cycles_low0)::"%rax", "%rbx", "%rcx", \
           "%rdx");                                                       \
     BARRIER;                                                             \
+    counters_begin();                                                    \
     i_bench = BENCH;                                                     \
     do {                                                                 \
       j_bench = BENCH;                                                   \
@@ -68,6 +119,7 @@
       } while (j_bench != 0);                                            \
       i_bench--;                                                         \
     } while (i_bench != 0);                                              \
+    counters_end();                                                      \
     BARRIER;                                                             \
     __asm__ __volatile__(                                                \
         "RDTSCP\n\t"                                                     \
@@ -78,13 +130,18 @@
           "%rdx");                                                       \
     start = (((uint64_t)cycles_high0) << 32) | cycles_low0;              \
     end = (((uint64_t)cycles_high1) << 32) | cycles_low1;                \
-    printf("%-8s: %5lu cc\n", LABEL, (end - start) / (BENCH * BENCH));   \
+    printf("%-8s: %5lu cc", LABEL, (end - start) / (BENCH * BENCH));     \
+    counters_print(BENCH * BENCH);                                       \
   } while (0)
 
 #define CLOCKS(LABEL, FUNCTION) CLOCKS_RANDOM(while (0), LABEL, FUNCTION)
 
 #define oper_second(RANDOM, LABEL, FUNCTION)                 \
   do {                                                       \
+    if (latency_mode) {                                      \
+      LATENCY(RANDOM, LABEL, FUNCTION, 10000);               \
+      break;                                                 \
+    }                                                        \
     printf("%-8s: ", LABEL);                                 \
     RANDOM;                                                  \
                                                              \
@@ -100,19 +157,36 @@
                                                              \
     start = time_now();                                      \
     start_c = cycles_now();                                  \
+    counters_begin();                                        \
     for (i = 0; i < iterations; ++i) {                       \
       FUNCTION;                                              \
     }                                                        \
+    counters_end();                                          \
     end = time_now();                                        \
     end_c = cycles_now();                                    \
                                                              \
-    printf("%3lu µs, %8.1f oper/s, %6lu cycles/op\n",        \
+    printf("%3lu µs, %8.1f oper/s, %6lu cycles/op",          \
            (uint64_t)((end - start) / iterations),      \
            iterations*(double)1e6 / (end - start),           \
            (uint64_t)((end_c - start_c) / iterations)); \
+    counters_print(iterations);                              \
   } while (0)
 
 uint64_t time_now();
 uint64_t cycles_now(void);
+void latency_report(const char *label, uint64_t *samples, long n);
+
+/**
+ * Hardware counters of bench --perf (see perf.h): counters_init opens
+ * them and returns how many are available, counters_begin and
+ * counters_end run them around a benchmark loop, and counters_print
+ * ends the line of the benchmark with their counts per operation. They
+ * do nothing unless counters_init succeeded.
+ */
+int counters_init(void);
+void counters_begin(void);
+void counters_end(void);
+void counters_print(uint64_t ops);
+void bench_section(const char *format, ...);
 
 #endif /* CLOCKS_H */
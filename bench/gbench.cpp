@@ -32,13 +32,93 @@
  */
 
 #include "benchmark/benchmark.h"
+#include "gbench_perf.h"
+#include "perf.h"
 #include "random.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <immintrin.h>
+#include <pthread.h>
+#include <rfc7748_bulk.h>
+#include <rfc7748_coalescer.hpp>
+#include <rfc7748_keypool.h>
 #include <rfc7748_precomputed.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+bool perf_enabled = false;
+
+/**
+ * Forces the x64 variant given by state.range(0), labelling the benchmark
+ * with it; the benchmark is skipped if the processor does not support it.
+ */
+static bool set_impl(benchmark::State &state) {
+  static const char *const names[] = {"auto", "mulq", "bmi2", "adx"};
+  const Rfc7748Impl impl = static_cast<Rfc7748Impl>(state.range(0));
+  if (RFC7748_SetImpl(impl) != 0) {
+    state.SkipWithError("not supported by the processor");
+    return false;
+  }
+  state.SetLabel(names[impl]);
+  return true;
+}
+
+/**
+ * Unless bytes is 0, a second thread keeps writing a buffer of that size;
+ * one larger than the last-level cache evicts the KeyGen tables from the
+ * caches it shares with the benchmark thread.
+ */
+class CachePolluter {
+ public:
+  explicit CachePolluter(size_t bytes) : stop_(false), buffer_(bytes) {
+    if (bytes != 0) {
+      thread_ = std::thread(&CachePolluter::run, this);
+    }
+  }
+
+  ~CachePolluter() {
+    stop_ = true;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+ private:
+  void run() {
+    while (!stop_) {
+      for (size_t i = 0; i < buffer_.size(); i += 64) {
+        buffer_[i]++;
+      }
+    }
+  }
+
+  std::atomic<bool> stop_;
+  std::vector<uint8_t> buffer_;
+  std::thread thread_;
+};
+
+/**
+ * Selects the KeyGen precomputation given by state.range(0); the label
+ * also tells whether the cache polluter, state.range(1), is running.
+ */
+static void set_table(benchmark::State &state) {
+  static const char *const names[] = {"ladder", "none", "comb"};
+  const Rfc7748Table table = static_cast<Rfc7748Table>(state.range(0));
+  RFC7748_SetTable(table);
+  state.SetLabel(std::string(names[table]) +
+                 (state.range(1) ? "/polluted" : ""));
+}
 
 static void BM_X25519_KeyGen(benchmark::State &state) {
   X25519_KEY secret_key;
   X25519_KEY public_key;
   random_bytes(secret_key, X25519_KEYSIZE_BYTES);
+  PerfScope perf(state, 1);
   for (auto _ : state) {
     X25519_KeyGen(public_key, secret_key);
   }
@@ -50,15 +130,543 @@ static void BM_X25519_Shared(benchmark::State &state) {
   X25519_KEY shared_key;
   random_bytes(secret_key, X25519_KEYSIZE_BYTES);
   random_bytes(public_key, X25519_KEYSIZE_BYTES);
+  PerfScope perf(state, 1);
   for (auto _ : state) {
     X25519_Shared(shared_key, public_key, secret_key);
   }
 }
 
+static void BM_X25519_KeyGen_impl(benchmark::State &state) {
+  if (set_impl(state)) {
+    BM_X25519_KeyGen(state);
+  }
+  RFC7748_SetImpl(RFC7748_IMPL_AUTO);
+}
+
+static void BM_X25519_Shared_impl(benchmark::State &state) {
+  if (set_impl(state)) {
+    BM_X25519_Shared(state);
+  }
+  RFC7748_SetImpl(RFC7748_IMPL_AUTO);
+}
+
+static void BM_X25519_KeyGen_table(benchmark::State &state) {
+  set_table(state);
+  CachePolluter polluter(state.range(1) ? 64 << 20 : 0);
+  BM_X25519_KeyGen(state);
+  RFC7748_SetTable(RFC7748_TABLE_LADDER);
+}
+
+static void BM_X25519_Precompute(benchmark::State &state) {
+  static X25519_PEER_TABLE table;
+  X25519_KEY secret_key;
+  X25519_KEY public_key;
+  random_bytes(secret_key, X25519_KEYSIZE_BYTES);
+  X25519_KeyGen(public_key, secret_key);
+  PerfScope perf(state, 1);
+  for (auto _ : state) {
+    X25519_Precompute(table, public_key);
+  }
+}
+
+static void BM_X25519_Shared_peer(benchmark::State &state) {
+  static X25519_PEER_TABLE table;
+  X25519_KEY secret_key;
+  X25519_KEY public_key;
+  X25519_KEY shared_key;
+  random_bytes(secret_key, X25519_KEYSIZE_BYTES);
+  X25519_KeyGen(public_key, secret_key);
+  X25519_Precompute(table, public_key);
+  random_bytes(secret_key, X25519_KEYSIZE_BYTES);
+  PerfScope perf(state, 1);
+  for (auto _ : state) {
+    X25519_Shared_peer(shared_key, table, secret_key);
+  }
+}
+
+/**
+ * Pops state.range(0) pairs from a full key pool per iteration. The time
+ * is measured manually so that waiting for the refill is not counted, and
+ * ns_per_pop compares directly with BM_X25519_KeyGen and BM_X448_KeyGen.
+ */
+static void pool_pop(benchmark::State &state, Rfc7748PoolCurve curve) {
+  const unsigned int n = state.range(0);
+  Rfc7748PoolConfig config = {};
+  Rfc7748PoolStats stats;
+  X448_KEY public_key, private_key;
+  double seconds = 0;
+
+  config.capacity = n;
+  config.random = random_bytes;
+  Rfc7748KeyPool *pool = RFC7748_PoolCreate(curve, &config);
+  for (auto _ : state) {
+    do {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      RFC7748_PoolGetStats(pool, &stats);
+    } while (stats.ready < n);
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < n; i++) {
+      RFC7748_PoolPop(pool, public_key, private_key);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    state.SetIterationTime(elapsed.count());
+    seconds += elapsed.count();
+  }
+  RFC7748_PoolGetStats(pool, &stats);
+  RFC7748_PoolDestroy(pool);
+  state.SetItemsProcessed(state.iterations() * n);
+  state.counters["ns_per_pop"] = 1e9 * seconds / (state.iterations() * n);
+  state.counters["misses"] = stats.misses;
+}
+
+/* Evicts [data, data + size) from every level of the cache hierarchy */
+static void flush(const void *data, size_t size) {
+  const uint8_t *const bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; i += 64) {
+    _mm_clflush(bytes + i);
+  }
+  _mm_mfence();
+}
+
+/**
+ * Evicts the stack below the caller, where the frames of the functions it
+ * calls next will be, by flushing a local array of this frame.
+ */
+__attribute__((noinline)) static void flush_stack() {
+  uint8_t area[16 << 10];
+  benchmark::DoNotOptimize(area);
+  flush(area, sizeof(area));
+}
+
+/**
+ * Times a KeyGen (or Shared) that does not find its data in the caches.
+ * KeyGen takes the precomputation from state.range(0); then a non-zero
+ * flush argument evicts the KeyGen table, the keys and the stack with
+ * clflush before every call, and corunner_kb sets the buffer of a
+ * CachePolluter running next to it (0: none). Only the calls are timed.
+ */
+static void cold(benchmark::State &state, KeyGen keygen, Shared shared,
+                 size_t (*table_memory)(const void **)) {
+  static const char *const names[] = {"ladder", "none", "comb"};
+  const int arg = keygen != nullptr ? 1 : 0;
+  const bool flushed = state.range(arg) != 0;
+  const size_t corunner = state.range(arg + 1) << 10;
+  const Rfc7748Table saved = RFC7748_GetTable();
+  X448_KEY secret_key, public_key, shared_key;
+  const void *table = nullptr;
+  size_t table_size = 0;
+  std::string label;
+
+  if (keygen != nullptr) {
+    RFC7748_SetTable(static_cast<Rfc7748Table>(state.range(0)));
+    table_size = table_memory(&table);
+    label = names[state.range(0)];
+  }
+  random_bytes(secret_key, sizeof(secret_key));
+  random_bytes(public_key, sizeof(public_key));
+  CachePolluter polluter(corunner);
+  for (auto _ : state) {
+    if (flushed) {
+      flush(table, table_size);
+      flush(secret_key, sizeof(secret_key));
+      flush(public_key, sizeof(public_key));
+      flush(shared_key, sizeof(shared_key));
+      flush_stack();
+    }
+    auto start = std::chrono::steady_clock::now();
+    if (keygen != nullptr) {
+      keygen(public_key, secret_key);
+    } else {
+      shared(shared_key, public_key, secret_key);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    state.SetIterationTime(elapsed.count());
+  }
+  RFC7748_SetTable(saved);
+  if (flushed) {
+    label += label.empty() ? "flushed" : "/flushed";
+  }
+  if (corunner != 0) {
+    label += (label.empty() ? "corunner:" : "/corunner:") +
+             std::to_string(corunner >> 10) + "KB";
+  }
+  state.SetLabel(label);
+}
+
+/**
+ * Cache scenarios of the BM_*_cold benchmarks: hot, flushed before every
+ * call, and next to co-runners of 1 MB (about an L2) and 64 MB (beyond
+ * the last-level cache); KeyGen runs each of them with every table.
+ */
+static void cold_args(benchmark::internal::Benchmark *b, bool tables) {
+  const std::vector<std::vector<int64_t>> modes = {
+      {0, 0}, {1, 0}, {0, 1 << 10}, {0, 64 << 10}};
+  if (!tables) {
+    b->ArgNames({"flush", "corunner_kb"});
+    for (const std::vector<int64_t> &mode : modes) {
+      b->Args(mode);
+    }
+    return;
+  }
+  b->ArgNames({"table", "flush", "corunner_kb"});
+  for (int64_t t : {RFC7748_TABLE_LADDER, RFC7748_TABLE_NONE,
+                    RFC7748_TABLE_COMB}) {
+    for (const std::vector<int64_t> &mode : modes) {
+      b->Args({t, mode[0], mode[1]});
+    }
+  }
+}
+
+static void cold_keygen_args(benchmark::internal::Benchmark *b) {
+  cold_args(b, true);
+}
+
+static void cold_shared_args(benchmark::internal::Benchmark *b) {
+  cold_args(b, false);
+}
+
+/* Placement of the threads of the BM_*_threads benchmarks */
+enum Placement { PLACE_ANY, PLACE_CORES, PLACE_SIBLINGS };
+
+static int read_topology(int cpu, const char *name) {
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                     "/topology/" + name);
+  int value = -1;
+  file >> value;
+  return value;
+}
+
+/**
+ * Lists the CPUs available to the process in the order the threads are
+ * pinned to them: PLACE_CORES takes one logical CPU of every physical core
+ * before any SMT sibling, whereas PLACE_SIBLINGS fills all the siblings of
+ * a core before moving to the next one.
+ */
+static std::vector<int> cpu_order(Placement placement) {
+  std::vector<std::vector<int>> cores;
+  std::vector<std::pair<int, int>> ids;
+  std::vector<int> order;
+  cpu_set_t available;
+
+  CPU_ZERO(&available);
+  sched_getaffinity(0, sizeof(available), &available);
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (!CPU_ISSET(cpu, &available)) {
+      continue;
+    }
+    std::pair<int, int> id(read_topology(cpu, "physical_package_id"),
+                           read_topology(cpu, "core_id"));
+    size_t core = std::find(ids.begin(), ids.end(), id) - ids.begin();
+    if (id.second < 0 || core == ids.size()) {
+      ids.push_back(id);
+      cores.push_back(std::vector<int>());
+      core = cores.size() - 1;
+    }
+    cores[core].push_back(cpu);
+  }
+  for (size_t sibling = 0; placement == PLACE_CORES; sibling++) {
+    size_t taken = order.size();
+    for (const std::vector<int> &core : cores) {
+      if (sibling < core.size()) {
+        order.push_back(core[sibling]);
+      }
+    }
+    if (order.size() == taken) {
+      break;
+    }
+  }
+  for (const std::vector<int> &core : cores) {
+    if (placement == PLACE_SIBLINGS) {
+      order.insert(order.end(), core.begin(), core.end());
+    }
+  }
+  return order;
+}
+
+/**
+ * Runs a 1-way KeyGen (or Shared) on every benchmark thread, pinned as
+ * state.range(0) says. items_per_second is the aggregate throughput,
+ * ops_per_thread the average throughput of one thread, and efficiency
+ * compares the latter with the single thread run of the same placement,
+ * so that 1.0 means linear scaling.
+ */
+static void scaling(benchmark::State &state, double *single, KeyGen keygen,
+                    Shared shared) {
+  static const char *const names[] = {"any", "cores", "siblings"};
+  const Placement placement = static_cast<Placement>(state.range(0));
+  X448_KEY secret_key, public_key, shared_key;
+  cpu_set_t saved;
+
+  pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved);
+  if (placement != PLACE_ANY) {
+    std::vector<int> order = cpu_order(placement);
+    cpu_set_t cpu;
+    CPU_ZERO(&cpu);
+    CPU_SET(order[state.thread_index % order.size()], &cpu);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu), &cpu);
+  }
+  random_bytes(secret_key, sizeof(secret_key));
+  random_bytes(public_key, sizeof(public_key));
+  auto start = std::chrono::steady_clock::now();
+  for (auto _ : state) {
+    if (keygen != nullptr) {
+      keygen(public_key, secret_key);
+    } else {
+      shared(shared_key, public_key, secret_key);
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved);
+
+  const double rate = state.iterations() / elapsed.count();
+  if (state.threads == 1) {
+    single[placement] = rate;
+  }
+  state.SetLabel(names[placement]);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["ops_per_thread"] =
+      benchmark::Counter(rate, benchmark::Counter::kAvgThreads);
+  if (single[placement] > 0) {
+    state.counters["efficiency"] = benchmark::Counter(
+        rate / single[placement], benchmark::Counter::kAvgThreads);
+  }
+}
+
+/**
+ * Placements and thread counts of the BM_*_threads benchmarks: powers of
+ * two up to all CPUs, starting from one thread to get the baseline.
+ */
+static void scaling_args(benchmark::internal::Benchmark *b) {
+  const unsigned int cpus = std::max(1u, std::thread::hardware_concurrency());
+  b->DenseRange(PLACE_ANY, PLACE_SIBLINGS);
+  for (unsigned int t = 1; t < cpus; t *= 2) {
+    b->Threads(t);
+  }
+  b->Threads(cpus);
+}
+
+/**
+ * Runs a bulk function over n keys of the given size on state.range(0)
+ * pinned workers; keygen selects the KeyGen signature, which has no
+ * session keys as input.
+ */
+static void bulk(benchmark::State &state, unsigned int n, unsigned int size,
+                 void (*shared)(Rfc7748Bulk *, argKey *, argKey *, argKey *,
+                                unsigned int),
+                 void (*keygen)(Rfc7748Bulk *, argKey *, argKey *,
+                                unsigned int)) {
+  std::vector<uint8_t> secret_keys(n * size);
+  std::vector<uint8_t> public_keys(n * size);
+  std::vector<uint8_t> shared_keys(n * size);
+  std::vector<argKey> secret_key(n), public_key(n), shared_key(n);
+  random_bytes(secret_keys.data(), n * size);
+  random_bytes(public_keys.data(), n * size);
+  for (unsigned int i = 0; i < n; i++) {
+    secret_key[i] = &secret_keys[i * size];
+    public_key[i] = &public_keys[i * size];
+    shared_key[i] = &shared_keys[i * size];
+  }
+  Rfc7748Bulk *engine = RFC7748_BulkCreate(state.range(0), 1);
+  for (auto _ : state) {
+    if (keygen != nullptr) {
+      keygen(engine, public_key.data(), secret_key.data(), n);
+    } else {
+      shared(engine, shared_key.data(), public_key.data(), secret_key.data(),
+             n);
+    }
+  }
+  RFC7748_BulkDestroy(engine);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Number of workers of the bulk benchmarks: powers of two up to all CPUs */
+static void bulk_threads(benchmark::internal::Benchmark *b) {
+  const unsigned int cpus = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned int t = 1; t < cpus; t *= 2) {
+    b->Arg(t);
+  }
+  b->Arg(cpus);
+}
+
+/**
+ * Closed-loop clients of a Coalescer: each benchmark thread submits one
+ * Shared request at a time and waits for it, so the number of threads is
+ * the offered load. state.range(0) is the batch size and state.range(1)
+ * the max_delay in microseconds. Every thread records its latencies in
+ * its own slot, and thread 0 computes the percentiles of all of them once
+ * the loop, which ends on a barrier, is over; items_per_second adds up to
+ * the throughput.
+ */
+template <typename Curve>
+static void coalesce(benchmark::State &state) {
+  typedef rfc7748::Coalescer<Curve> Coalescer;
+  static Coalescer *coalescer;
+  static std::vector<std::vector<double>> latencies;
+  typename Coalescer::Key secret_key, public_key, shared_key;
+
+  if (state.thread_index == 0) {
+    typename Coalescer::Options options;
+    options.batch_size = state.range(0);
+    options.max_delay = std::chrono::microseconds(state.range(1));
+    coalescer = new Coalescer(options);
+    latencies.assign(state.threads, std::vector<double>());
+  }
+  random_bytes(secret_key.data(), secret_key.size());
+  random_bytes(public_key.data(), public_key.size());
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    shared_key = coalescer->Shared(public_key, secret_key).get();
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    latencies[state.thread_index].push_back(elapsed.count());
+    benchmark::DoNotOptimize(shared_key);
+  }
+  if (state.thread_index == 0) {
+    typename Coalescer::Stats stats = coalescer->GetStats();
+    delete coalescer;
+    state.counters["batch_avg"] =
+        stats.batches ? static_cast<double>(stats.requests) / stats.batches
+                      : 0;
+
+    std::vector<double> all;
+    for (const auto &l : latencies) {
+      all.insert(all.end(), l.begin(), l.end());
+    }
+    latencies.clear();
+    std::sort(all.begin(), all.end());
+    const char *names[] = {"p50_us", "p90_us", "p99_us"};
+    const double ranks[] = {0.50, 0.90, 0.99};
+    for (unsigned int i = 0; i < 3 && !all.empty(); i++) {
+      state.counters[names[i]] =
+          all[static_cast<size_t>(ranks[i] * (all.size() - 1))];
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/* Batch sizes of 1 (no coalescing), 4 and 8 under two latency caps */
+static void coalesce_args(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"batch", "delay_us"});
+  for (int batch : {1, 4, 8}) {
+    for (int delay : {50, 500}) {
+      b->Args({batch, delay});
+    }
+  }
+  b->ThreadRange(1, 16);
+}
+
+static void BM_X25519_KeyGen_bulk(benchmark::State &state) {
+  bulk(state, 4096, X25519_KEYSIZE_BYTES, nullptr, RFC7748_BulkX25519_KeyGen);
+}
+
+static void BM_X25519_Shared_bulk(benchmark::State &state) {
+  bulk(state, 4096, X25519_KEYSIZE_BYTES, RFC7748_BulkX25519_Shared, nullptr);
+}
+
+static void BM_X25519_Shared_coalesce(benchmark::State &state) {
+  coalesce<rfc7748::X25519>(state);
+}
+
+static void BM_X25519_KeyGen_threads(benchmark::State &state) {
+  static double single[3];
+  scaling(state, single, X25519_KeyGen, nullptr);
+}
+
+static void BM_X25519_Shared_threads(benchmark::State &state) {
+  static double single[3];
+  scaling(state, single, nullptr, X25519_Shared);
+}
+
+static void BM_X25519_KeyGen_cold(benchmark::State &state) {
+  cold(state, X25519_KeyGen, nullptr, RFC7748_X25519_TableMemory);
+}
+
+static void BM_X25519_Shared_cold(benchmark::State &state) {
+  cold(state, nullptr, X25519_Shared, nullptr);
+}
+
+static void BM_X25519_PoolPop(benchmark::State &state) {
+  pool_pop(state, RFC7748_POOL_X25519);
+}
+
+static void BM_X25519_KeyGen_batch(benchmark::State &state) {
+  const unsigned int n = state.range(0);
+  std::vector<uint8_t> secret_keys(n * X25519_KEYSIZE_BYTES);
+  std::vector<uint8_t> public_keys(n * X25519_KEYSIZE_BYTES);
+  std::vector<argKey> secret_key(n), public_key(n);
+  random_bytes(secret_keys.data(), n * X25519_KEYSIZE_BYTES);
+  for (unsigned int i = 0; i < n; i++) {
+    secret_key[i] = &secret_keys[i * X25519_KEYSIZE_BYTES];
+    public_key[i] = &public_keys[i * X25519_KEYSIZE_BYTES];
+  }
+  PerfScope perf(state, n);
+  for (auto _ : state) {
+    X25519_KeyGen_batch(public_key.data(), secret_key.data(), n);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_X25519_Shared_batch(benchmark::State &state) {
+  const unsigned int n = state.range(0);
+  std::vector<uint8_t> secret_keys(n * X25519_KEYSIZE_BYTES);
+  std::vector<uint8_t> public_keys(n * X25519_KEYSIZE_BYTES);
+  std::vector<uint8_t> shared_keys(n * X25519_KEYSIZE_BYTES);
+  std::vector<argKey> secret_key(n), public_key(n), shared_key(n);
+  random_bytes(secret_keys.data(), n * X25519_KEYSIZE_BYTES);
+  random_bytes(public_keys.data(), n * X25519_KEYSIZE_BYTES);
+  for (unsigned int i = 0; i < n; i++) {
+    secret_key[i] = &secret_keys[i * X25519_KEYSIZE_BYTES];
+    public_key[i] = &public_keys[i * X25519_KEYSIZE_BYTES];
+    shared_key[i] = &shared_keys[i * X25519_KEYSIZE_BYTES];
+  }
+  PerfScope perf(state, n);
+  for (auto _ : state) {
+    X25519_Shared_batch(shared_key.data(), public_key.data(),
+                        secret_key.data(), n);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_X25519_KeyGen_4w(benchmark::State &state) {
+  X25519_KEY secret_keys[4], public_keys[4];
+  argKey secret_key[4], public_key[4];
+  for (int i = 0; i < 4; i++) {
+    random_bytes(secret_keys[i], X25519_KEYSIZE_BYTES);
+    secret_key[i] = secret_keys[i];
+    public_key[i] = public_keys[i];
+  }
+  PerfScope perf(state, 4);
+  for (auto _ : state) {
+    X25519_KeyGen_4w(public_key, secret_key);
+  }
+  state.SetItemsProcessed(state.iterations() * 4);
+}
+
+static void BM_X25519_Shared_4w(benchmark::State &state) {
+  X25519_KEY secret_keys[4], public_keys[4], shared_keys[4];
+  argKey secret_key[4], public_key[4], shared_key[4];
+  for (int i = 0; i < 4; i++) {
+    random_bytes(secret_keys[i], X25519_KEYSIZE_BYTES);
+    random_bytes(public_keys[i], X25519_KEYSIZE_BYTES);
+    secret_key[i] = secret_keys[i];
+    public_key[i] = public_keys[i];
+    shared_key[i] = shared_keys[i];
+  }
+  PerfScope perf(state, 4);
+  for (auto _ : state) {
+    X25519_Shared_4w(shared_key, public_key, secret_key);
+  }
+  state.SetItemsProcessed(state.iterations() * 4);
+}
+
 static void BM_X448_KeyGen(benchmark::State &state) {
   X448_KEY secret_key;
   X448_KEY public_key;
   random_bytes(secret_key, X448_KEYSIZE_BYTES);
+  PerfScope perf(state, 1);
   for (auto _ : state) {
     X448_KeyGen(public_key, secret_key);
   }
@@ -70,14 +678,302 @@ static void BM_X448_Shared(benchmark::State &state) {
   X448_KEY shared_key;
   random_bytes(secret_key, X448_KEYSIZE_BYTES);
   random_bytes(public_key, X448_KEYSIZE_BYTES);
+  PerfScope perf(state, 1);
   for (auto _ : state) {
     X448_Shared(shared_key, public_key, secret_key);
   }
 }
 
+static void BM_X448_KeyGen_impl(benchmark::State &state) {
+  if (set_impl(state)) {
+    BM_X448_KeyGen(state);
+  }
+  RFC7748_SetImpl(RFC7748_IMPL_AUTO);
+}
+
+static void BM_X448_Shared_impl(benchmark::State &state) {
+  if (set_impl(state)) {
+    BM_X448_Shared(state);
+  }
+  RFC7748_SetImpl(RFC7748_IMPL_AUTO);
+}
+
+static void BM_X448_KeyGen_table(benchmark::State &state) {
+  set_table(state);
+  CachePolluter polluter(state.range(1) ? 64 << 20 : 0);
+  BM_X448_KeyGen(state);
+  RFC7748_SetTable(RFC7748_TABLE_LADDER);
+}
+
+static void BM_X448_Precompute(benchmark::State &state) {
+  static X448_PEER_TABLE table;
+  X448_KEY secret_key;
+  X448_KEY public_key;
+  random_bytes(secret_key, X448_KEYSIZE_BYTES);
+  X448_KeyGen(public_key, secret_key);
+  PerfScope perf(state, 1);
+  for (auto _ : state) {
+    X448_Precompute(table, public_key);
+  }
+}
+
+static void BM_X448_Shared_peer(benchmark::State &state) {
+  static X448_PEER_TABLE table;
+  X448_KEY secret_key;
+  X448_KEY public_key;
+  X448_KEY shared_key;
+  random_bytes(secret_key, X448_KEYSIZE_BYTES);
+  X448_KeyGen(public_key, secret_key);
+  X448_Precompute(table, public_key);
+  random_bytes(secret_key, X448_KEYSIZE_BYTES);
+  PerfScope perf(state, 1);
+  for (auto _ : state) {
+    X448_Shared_peer(shared_key, table, secret_key);
+  }
+}
+
+static void BM_X448_KeyGen_bulk(benchmark::State &state) {
+  bulk(state, 1024, X448_KEYSIZE_BYTES, nullptr, RFC7748_BulkX448_KeyGen);
+}
+
+static void BM_X448_Shared_bulk(benchmark::State &state) {
+  bulk(state, 1024, X448_KEYSIZE_BYTES, RFC7748_BulkX448_Shared, nullptr);
+}
+
+static void BM_X448_Shared_coalesce(benchmark::State &state) {
+  coalesce<rfc7748::X448>(state);
+}
+
+static void BM_X448_KeyGen_threads(benchmark::State &state) {
+  static double single[3];
+  scaling(state, single, X448_KeyGen, nullptr);
+}
+
+static void BM_X448_Shared_threads(benchmark::State &state) {
+  static double single[3];
+  scaling(state, single, nullptr, X448_Shared);
+}
+
+static void BM_X448_KeyGen_cold(benchmark::State &state) {
+  cold(state, X448_KeyGen, nullptr, RFC7748_X448_TableMemory);
+}
+
+static void BM_X448_Shared_cold(benchmark::State &state) {
+  cold(state, nullptr, X448_Shared, nullptr);
+}
+
+static void BM_X448_PoolPop(benchmark::State &state) {
+  pool_pop(state, RFC7748_POOL_X448);
+}
+
+static void BM_X448_KeyGen_batch(benchmark::State &state) {
+  const unsigned int n = state.range(0);
+  std::vector<uint8_t> secret_keys(n * X448_KEYSIZE_BYTES);
+  std::vector<uint8_t> public_keys(n * X448_KEYSIZE_BYTES);
+  std::vector<argKey> secret_key(n), public_key(n);
+  random_bytes(secret_keys.data(), n * X448_KEYSIZE_BYTES);
+  for (unsigned int i = 0; i < n; i++) {
+    secret_key[i] = &secret_keys[i * X448_KEYSIZE_BYTES];
+    public_key[i] = &public_keys[i * X448_KEYSIZE_BYTES];
+  }
+  PerfScope perf(state, n);
+  for (auto _ : state) {
+    X448_KeyGen_batch(public_key.data(), secret_key.data(), n);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_X448_Shared_batch(benchmark::State &state) {
+  const unsigned int n = state.range(0);
+  std::vector<uint8_t> secret_keys(n * X448_KEYSIZE_BYTES);
+  std::vector<uint8_t> public_keys(n * X448_KEYSIZE_BYTES);
+  std::vector<uint8_t> shared_keys(n * X448_KEYSIZE_BYTES);
+  std::vector<argKey> secret_key(n), public_key(n), shared_key(n);
+  random_bytes(secret_keys.data(), n * X448_KEYSIZE_BYTES);
+  random_bytes(public_keys.data(), n * X448_KEYSIZE_BYTES);
+  for (unsigned int i = 0; i < n; i++) {
+    secret_key[i] = &secret_keys[i * X448_KEYSIZE_BYTES];
+    public_key[i] = &public_keys[i * X448_KEYSIZE_BYTES];
+    shared_key[i] = &shared_keys[i * X448_KEYSIZE_BYTES];
+  }
+  PerfScope perf(state, n);
+  for (auto _ : state) {
+    X448_Shared_batch(shared_key.data(), public_key.data(), secret_key.data(),
+                      n);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_X448_KeyGen_4w(benchmark::State &state) {
+  uint8_t secret_keys[4][X448_KEYSIZE_BYTES];
+  uint8_t public_keys[4][X448_KEYSIZE_BYTES];
+  argKey secret_key[4], public_key[4];
+  for (int i = 0; i < 4; i++) {
+    random_bytes(secret_keys[i], X448_KEYSIZE_BYTES);
+    secret_key[i] = secret_keys[i];
+    public_key[i] = public_keys[i];
+  }
+  PerfScope perf(state, 4);
+  for (auto _ : state) {
+    X448_KeyGen_4w(public_key, secret_key);
+  }
+  state.SetItemsProcessed(state.iterations() * 4);
+}
+
+static void BM_X448_Shared_4w(benchmark::State &state) {
+  uint8_t secret_keys[4][X448_KEYSIZE_BYTES];
+  uint8_t public_keys[4][X448_KEYSIZE_BYTES];
+  uint8_t shared_keys[4][X448_KEYSIZE_BYTES];
+  argKey secret_key[4], public_key[4], shared_key[4];
+  for (int i = 0; i < 4; i++) {
+    random_bytes(secret_keys[i], X448_KEYSIZE_BYTES);
+    random_bytes(public_keys[i], X448_KEYSIZE_BYTES);
+    secret_key[i] = secret_keys[i];
+    public_key[i] = public_keys[i];
+    shared_key[i] = shared_keys[i];
+  }
+  PerfScope perf(state, 4);
+  for (auto _ : state) {
+    X448_Shared_4w(shared_key, public_key, secret_key);
+  }
+  state.SetItemsProcessed(state.iterations() * 4);
+}
+
 BENCHMARK(BM_X25519_KeyGen)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_X25519_Shared)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_KeyGen_impl)
+    ->DenseRange(RFC7748_IMPL_MULQ, RFC7748_IMPL_ADX)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_Shared_impl)
+    ->DenseRange(RFC7748_IMPL_MULQ, RFC7748_IMPL_ADX)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_KeyGen_table)
+    ->Ranges({{RFC7748_TABLE_LADDER, RFC7748_TABLE_COMB}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_KeyGen_cold)
+    ->Apply(cold_keygen_args)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_Shared_cold)
+    ->Apply(cold_shared_args)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_KeyGen_threads)
+    ->Apply(scaling_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_Shared_threads)
+    ->Apply(scaling_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_Precompute)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_Shared_peer)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_PoolPop)
+    ->Arg(256)
+    ->Iterations(200)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_KeyGen_batch)
+    ->RangeMultiplier(2)
+    ->Range(1, 256)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_Shared_batch)
+    ->RangeMultiplier(2)
+    ->Range(1, 256)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_KeyGen_4w)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_Shared_4w)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X25519_KeyGen_bulk)
+    ->Apply(bulk_threads)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_X25519_Shared_bulk)
+    ->Apply(bulk_threads)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_X25519_Shared_coalesce)
+    ->Apply(coalesce_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_X448_KeyGen)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_X448_Shared)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_KeyGen_impl)
+    ->DenseRange(RFC7748_IMPL_MULQ, RFC7748_IMPL_ADX)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_Shared_impl)
+    ->DenseRange(RFC7748_IMPL_MULQ, RFC7748_IMPL_ADX)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_KeyGen_table)
+    ->Ranges({{RFC7748_TABLE_LADDER, RFC7748_TABLE_COMB}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_KeyGen_cold)
+    ->Apply(cold_keygen_args)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_Shared_cold)
+    ->Apply(cold_shared_args)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_KeyGen_threads)
+    ->Apply(scaling_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_Shared_threads)
+    ->Apply(scaling_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_Precompute)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_Shared_peer)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_PoolPop)
+    ->Arg(256)
+    ->Iterations(50)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_KeyGen_batch)
+    ->RangeMultiplier(2)
+    ->Range(1, 256)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_Shared_batch)
+    ->RangeMultiplier(2)
+    ->Range(1, 256)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_KeyGen_4w)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_Shared_4w)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_X448_KeyGen_bulk)
+    ->Apply(bulk_threads)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_X448_Shared_bulk)
+    ->Apply(bulk_threads)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_X448_Shared_coalesce)
+    ->Apply(coalesce_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
 
-BENCHMARK_MAIN();
+/**
+ * BENCHMARK_MAIN with one more flag: --perf adds hardware counters to the
+ * benchmarks of the primitives (see PerfScope).
+ */
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--perf") == 0) {
+      PerfCounters counters;
+      perf_enabled = perf_open(&counters) > 0;
+      perf_close(&counters);
+      if (!perf_enabled) {
+        std::fprintf(stderr, "--perf: no hardware counters available\n");
+      }
+      std::copy(argv + i + 1, argv + argc + 1, argv + i);
+      argc--;
+      break;
+    }
+  }
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
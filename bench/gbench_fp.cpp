@@ -0,0 +1,317 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark/benchmark.h"
+#include "random.h"
+#include "gbench_perf.h"
+#include <cstring>
+#include <fp25519_avx2.h>
+#include <fp25519_x64.h>
+#include <fp448_avx2.h>
+#include <fp448_x64.h>
+#include <rfc7748_precomputed.h>
+#include <safegcd_x64.h>
+#include <string>
+
+/**
+ * Benchmarks of every field kernel. This file is compiled once per x64
+ * variant, like bench_fp25519_x64.c, so that the names of the kernels
+ * resolve to the build given by X64_VARIANT (see x64_variant.h).
+ */
+#ifdef X64_VARIANT
+#define STR_(x) #x
+#define STR(x) STR_(x)
+#define VARIANT STR(X64_VARIANT)
+#else
+#define VARIANT ""
+#endif
+
+/* Words reserved for any operand, large enough for a 4-way fp448 element */
+#define WORDS 64
+
+/* Squarings of sqrn and elements of inv_batch per call */
+#define SQRN_TIMES 100
+#define INV_BATCH 4
+
+/* Calls per iteration, in a chain or in independent streams */
+#define STREAMS 8
+
+/* One call of a kernel: reads a and writes c */
+typedef void (*Kernel)(uint64_t *c, uint64_t *a);
+
+/* Second operand of the kernels that take two */
+alignas(32) static uint64_t operand[WORDS];
+
+#define FIELD_KERNELS(F, INT)                                    \
+  static void fp##F##_mul_integer(uint64_t *c, uint64_t *a) {    \
+    mul_##INT##_integer_x64(c, a, operand);                      \
+  }                                                              \
+  static void fp##F##_sqr_integer(uint64_t *c, uint64_t *a) {    \
+    sqr_##INT##_integer_x64(c, a);                               \
+  }                                                              \
+  static void fp##F##_red(uint64_t *c, uint64_t *a) {            \
+    red_EltFp##F##_1w_x64(c, a);                                 \
+  }                                                              \
+  static void fp##F##_add(uint64_t *c, uint64_t *a) {            \
+    add_EltFp##F##_1w_x64(c, a, operand);                        \
+  }                                                              \
+  static void fp##F##_sub(uint64_t *c, uint64_t *a) {            \
+    sub_EltFp##F##_1w_x64(c, a, operand);                        \
+  }                                                              \
+  static void fp##F##_mul_a24(uint64_t *c, uint64_t *a) {        \
+    mul_a24_EltFp##F##_1w_x64(c, a);                             \
+  }                                                              \
+  static void fp##F##_mul(uint64_t *c, uint64_t *a) {            \
+    alignas(32) uint64_t buffer[WORDS];                          \
+    mul_##INT##_integer_x64(buffer, a, operand);                 \
+    red_EltFp##F##_1w_x64(c, buffer);                            \
+  }                                                              \
+  static void fp##F##_sqr(uint64_t *c, uint64_t *a) {            \
+    alignas(32) uint64_t buffer[WORDS];                          \
+    sqr_##INT##_integer_x64(buffer, a);                          \
+    red_EltFp##F##_1w_x64(c, buffer);                            \
+  }                                                              \
+  static void fp##F##_sqrn(uint64_t *c, uint64_t *a) {           \
+    sqrn_EltFp##F##_1w_x64(c, a, SQRN_TIMES);                    \
+  }                                                              \
+  static void fp##F##_inv(uint64_t *c, uint64_t *a) {            \
+    inv_EltFp##F##_1w_x64(c, a);                                 \
+  }                                                              \
+  static void fp##F##_sqrt(uint64_t *c, uint64_t *a) {           \
+    sqrt_EltFp##F##_1w_x64(c, a);                                \
+  }                                                              \
+  static void fp##F##_inv_batch(uint64_t *c, uint64_t *a) {      \
+    inv_batch_EltFp##F##_1w_x64(c, a, INV_BATCH);                \
+  }                                                              \
+  static void fp##F##_fred(uint64_t *c, uint64_t *) {            \
+    fred_EltFp##F##_1w_x64(c);                                   \
+  }                                                              \
+  static void fp##F##_mul2_integer(uint64_t *c, uint64_t *a) {   \
+    mul2_##INT##_integer_x64(c, a, operand);                     \
+  }                                                              \
+  static void fp##F##_sqr2_integer(uint64_t *c, uint64_t *a) {   \
+    sqr2_##INT##_integer_x64(c, a);                              \
+  }                                                              \
+  static void fp##F##_red2(uint64_t *c, uint64_t *a) {           \
+    red_EltFp##F##_2w_x64(c, a);                                 \
+  }                                                              \
+  static void fp##F##_mul2(uint64_t *c, uint64_t *a) {           \
+    alignas(32) uint64_t buffer[WORDS];                          \
+    mul2_##INT##_integer_x64(buffer, a, operand);                \
+    red_EltFp##F##_2w_x64(c, buffer);                            \
+  }                                                              \
+  static void fp##F##_sqr2(uint64_t *c, uint64_t *a) {           \
+    alignas(32) uint64_t buffer[WORDS];                          \
+    sqr2_##INT##_integer_x64(buffer, a);                         \
+    red_EltFp##F##_2w_x64(c, buffer);                            \
+  }
+
+FIELD_KERNELS(25519, 256x256)
+FIELD_KERNELS(448, 448x448)
+
+/* Works in place on the four coordinates [X2|Z2|X3|Z3] */
+static void fp25519_ladder_step(uint64_t *c, uint64_t *) {
+  ladder_step_EltFp25519_x64(c, operand, 0);
+}
+
+#ifndef X64_VARIANT
+/* The 4-way AVX2 arithmetic is built once too, outside of the variants */
+#define AVX2_KERNELS(F)                                             \
+  static void fp##F##_load4(uint64_t *c, uint64_t *a) {             \
+    load_EltFp##F##_4w_avx2(c, a);                                  \
+  }                                                                 \
+  static void fp##F##_store4(uint64_t *c, uint64_t *a) {            \
+    store_EltFp##F##_4w_avx2(c, a);                                 \
+  }                                                                 \
+  static void fp##F##_broadcast4(uint64_t *c, uint64_t *a) {        \
+    broadcast_EltFp##F##_4w_avx2(c, a);                             \
+  }                                                                 \
+  static void fp##F##_add4(uint64_t *c, uint64_t *a) {              \
+    add_EltFp##F##_4w_avx2(c, a, operand);                          \
+  }                                                                 \
+  static void fp##F##_sub4(uint64_t *c, uint64_t *a) {              \
+    sub_EltFp##F##_4w_avx2(c, a, operand);                          \
+  }                                                                 \
+  static void fp##F##_carry4(uint64_t *c, uint64_t *) {             \
+    carry_EltFp##F##_4w_avx2(c);                                    \
+  }                                                                 \
+  static void fp##F##_mul4(uint64_t *c, uint64_t *a) {              \
+    mul_EltFp##F##_4w_avx2(c, a, operand);                          \
+  }                                                                 \
+  static void fp##F##_sqr4(uint64_t *c, uint64_t *a) {              \
+    sqr_EltFp##F##_4w_avx2(c, a);                                   \
+  }                                                                 \
+  static void fp##F##_mul_a24_4(uint64_t *c, uint64_t *a) {         \
+    mul_a24_EltFp##F##_4w_avx2(c, a);                               \
+  }                                                                 \
+  static void fp##F##_cswap4(uint64_t *c, uint64_t *a) {            \
+    alignas(32) static uint64_t mask[4] = {~0ull, 0, ~0ull, 0};     \
+    cswap_EltFp##F##_4w_avx2(mask, c, a);                           \
+  }
+
+AVX2_KERNELS(25519)
+AVX2_KERNELS(448)
+
+/* The safegcd inversion is built once, outside of the x64 variants */
+static void fp25519_inv_safegcd(uint64_t *c, uint64_t *a) {
+  inv_safegcd_EltFp25519_1w_x64(c, a);
+}
+
+static void fp448_inv_safegcd(uint64_t *c, uint64_t *a) {
+  inv_safegcd_EltFp448_1w_x64(c, a);
+}
+#endif
+
+/* Returns whether the processor runs the variant of this build */
+static bool supported(bool avx2) {
+  if (avx2) {
+    return __builtin_cpu_supports("avx2");
+  }
+#ifdef X64_VARIANT
+  return RFC7748_HasImpl(std::strcmp(VARIANT, "_adx") == 0
+                             ? RFC7748_IMPL_ADX
+                             : RFC7748_IMPL_BMI2);
+#else
+  return true;
+#endif
+}
+
+/**
+ * Runs STREAMS calls of a kernel per iteration. With state.range(0) = 0
+ * (latency), each call takes the output of the previous one, so the time
+ * per call is the latency of the kernel; with 1 (throughput), the calls
+ * work on independent operands that the processor can overlap. Kernels
+ * working in place (fred, ladder_step, carry4) read and write the same
+ * operand. The AVX2 kernels are skipped on processors without AVX2.
+ * items_per_second and the --perf counters are both per call.
+ */
+static void field(benchmark::State &state, Kernel kernel, bool in_place,
+                  bool avx2) {
+  alignas(32) static uint64_t x[STREAMS][2][WORDS];
+  const bool latency = state.range(0) == 0;
+
+  if (!supported(avx2)) {
+    state.SkipWithError("not supported by the processor");
+    return;
+  }
+  random_bytes(reinterpret_cast<uint8_t *>(x), sizeof(x));
+  random_bytes(reinterpret_cast<uint8_t *>(operand), sizeof(operand));
+  PerfScope perf(state, STREAMS);
+  for (auto _ : state) {
+    if (latency) {
+      for (int i = 0; i < STREAMS; i += 2) {
+        kernel(x[0][!in_place], x[0][0]);
+        kernel(x[0][0], x[0][!in_place]);
+      }
+    } else {
+      for (int i = 0; i < STREAMS; i++) {
+        kernel(x[i][!in_place], x[i][0]);
+      }
+    }
+  }
+  state.SetLabel(latency ? "latency" : "throughput");
+  state.SetItemsProcessed(state.iterations() * STREAMS);
+}
+
+/* A kernel with its name and the way field() calls it */
+struct FieldKernel {
+  const char *name;
+  Kernel kernel;
+  bool in_place;
+};
+
+static void register_field(const FieldKernel &k, const char *suffix,
+                           bool avx2) {
+  const std::string name = std::string("BM_") + k.name + suffix;
+  benchmark::RegisterBenchmark(name.c_str(), field, k.kernel, k.in_place,
+                               avx2)
+      ->ArgName("mode")
+      ->DenseRange(0, 1);
+}
+
+static int register_kernels() {
+#define KERNEL(f) \
+  { #f, f, false }
+#define KERNEL_IN_PLACE(f) \
+  { #f, f, true }
+  static const FieldKernel kernels[] = {
+      KERNEL(fp25519_mul_integer),  KERNEL(fp25519_sqr_integer),
+      KERNEL(fp25519_red),          KERNEL(fp25519_add),
+      KERNEL(fp25519_sub),          KERNEL(fp25519_mul_a24),
+      KERNEL(fp25519_mul),          KERNEL(fp25519_sqr),
+      KERNEL(fp25519_sqrn),         KERNEL(fp25519_inv),
+      KERNEL(fp25519_sqrt),         KERNEL(fp25519_inv_batch),
+      KERNEL_IN_PLACE(fp25519_fred),
+      KERNEL_IN_PLACE(fp25519_ladder_step),
+      KERNEL(fp25519_mul2_integer), KERNEL(fp25519_sqr2_integer),
+      KERNEL(fp25519_red2),         KERNEL(fp25519_mul2),
+      KERNEL(fp25519_sqr2),         KERNEL(fp448_mul_integer),
+      KERNEL(fp448_sqr_integer),    KERNEL(fp448_red),
+      KERNEL(fp448_add),            KERNEL(fp448_sub),
+      KERNEL(fp448_mul_a24),        KERNEL(fp448_mul),
+      KERNEL(fp448_sqr),            KERNEL(fp448_sqrn),
+      KERNEL(fp448_inv),            KERNEL(fp448_sqrt),
+      KERNEL(fp448_inv_batch),      KERNEL_IN_PLACE(fp448_fred),
+      KERNEL(fp448_mul2_integer),   KERNEL(fp448_sqr2_integer),
+      KERNEL(fp448_red2),           KERNEL(fp448_mul2),
+      KERNEL(fp448_sqr2),
+#ifndef X64_VARIANT
+      KERNEL(fp25519_inv_safegcd),  KERNEL(fp448_inv_safegcd),
+#endif
+  };
+  for (const auto &k : kernels) {
+    register_field(k, "_x64" VARIANT, false);
+  }
+#ifndef X64_VARIANT
+  static const FieldKernel kernels_avx2[] = {
+      KERNEL(fp25519_load4),        KERNEL(fp25519_store4),
+      KERNEL(fp25519_broadcast4),   KERNEL(fp25519_add4),
+      KERNEL(fp25519_sub4),         KERNEL_IN_PLACE(fp25519_carry4),
+      KERNEL(fp25519_mul4),         KERNEL(fp25519_sqr4),
+      KERNEL(fp25519_mul_a24_4),    KERNEL(fp25519_cswap4),
+      KERNEL(fp448_load4),          KERNEL(fp448_store4),
+      KERNEL(fp448_broadcast4),     KERNEL(fp448_add4),
+      KERNEL(fp448_sub4),           KERNEL_IN_PLACE(fp448_carry4),
+      KERNEL(fp448_mul4),           KERNEL(fp448_sqr4),
+      KERNEL(fp448_mul_a24_4),      KERNEL(fp448_cswap4),
+  };
+  for (const auto &k : kernels_avx2) {
+    register_field(k, "_avx2", true);
+  }
+#endif
+#undef KERNEL_IN_PLACE
+#undef KERNEL
+  return 0;
+}
+
+static int registered BENCHMARK_UNUSED = register_kernels();
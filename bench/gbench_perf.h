@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GBENCH_PERF_H
+#define GBENCH_PERF_H
+
+#include "benchmark/benchmark.h"
+#include "perf.h"
+#include <algorithm>
+
+/* Set by gbench --perf */
+extern bool perf_enabled;
+
+/**
+ * With gbench --perf, counts hardware events from construction to
+ * destruction and reports them per operation, along with the IPC, as
+ * counters of the benchmark; ops is the number of operations of each
+ * iteration, the same factor given to SetItemsProcessed. Events the
+ * kernel does not provide are left out.
+ */
+class PerfScope {
+ public:
+  PerfScope(benchmark::State &state, double ops)
+      : state_(state),
+        ops_(ops),
+        open_(perf_enabled && perf_open(&counters_) > 0) {
+    if (open_) {
+      perf_start(&counters_);
+    }
+  }
+
+  ~PerfScope() {
+    double counts[PERF_NUM_EVENTS];
+    if (!open_) {
+      return;
+    }
+    perf_stop(&counters_, counts);
+    perf_close(&counters_);
+    const double n = std::max<double>(1, state_.iterations()) * ops_;
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+      if (counts[i] >= 0) {
+        state_.counters[perf_event_names[i]] = counts[i] / n;
+      }
+    }
+    if (counts[PERF_INSTRUCTIONS] >= 0 && counts[PERF_CYCLES] > 0) {
+      state_.counters["ipc"] = counts[PERF_INSTRUCTIONS] / counts[PERF_CYCLES];
+    }
+  }
+
+ private:
+  benchmark::State &state_;
+  const double ops_;
+  PerfCounters counters_;
+  const bool open_;
+};
+
+#endif /* GBENCH_PERF_H */
@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "perf.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char *const perf_event_names[PERF_NUM_EVENTS] = {
+    "instructions", "cycles", "branch_misses", "l1d_misses", "llc_misses"};
+
+#ifdef __linux__
+
+#define CACHE_READ_MISS(cache)                                    \
+  ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) |                 \
+   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+/**
+ * L2 misses have no generic event, and raw events depend on the
+ * processor model, so the last-level cache misses are counted instead.
+ */
+static const struct {
+  uint32_t type;
+  uint64_t config;
+} events[PERF_NUM_EVENTS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+};
+
+int perf_open(PerfCounters *counters) {
+  struct perf_event_attr attr;
+  int i, available = 0;
+
+  for (i = 0; i < PERF_NUM_EVENTS; i++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = events[i].type;
+    attr.config = events[i].config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    counters->fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    available += counters->fd[i] >= 0;
+  }
+  return available;
+}
+
+void perf_start(PerfCounters *counters) {
+  int i;
+  for (i = 0; i < PERF_NUM_EVENTS; i++) {
+    if (counters->fd[i] >= 0) {
+      ioctl(counters->fd[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(counters->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+void perf_stop(PerfCounters *counters, double counts[PERF_NUM_EVENTS]) {
+  /* value, time enabled, time running */
+  uint64_t data[3];
+  int i;
+
+  for (i = 0; i < PERF_NUM_EVENTS; i++) {
+    if (counters->fd[i] >= 0) {
+      ioctl(counters->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  for (i = 0; i < PERF_NUM_EVENTS; i++) {
+    counts[i] = -1;
+    if (counters->fd[i] >= 0 &&
+        read(counters->fd[i], data, sizeof(data)) == sizeof(data) &&
+        data[2] != 0) {
+      counts[i] = (double)data[0] * data[1] / data[2];
+    }
+  }
+}
+
+void perf_close(PerfCounters *counters) {
+  int i;
+  for (i = 0; i < PERF_NUM_EVENTS; i++) {
+    if (counters->fd[i] >= 0) {
+      close(counters->fd[i]);
+      counters->fd[i] = -1;
+    }
+  }
+}
+
+#else /* !__linux__ */
+
+int perf_open(PerfCounters *counters) {
+  int i;
+  for (i = 0; i < PERF_NUM_EVENTS; i++) {
+    counters->fd[i] = -1;
+  }
+  return 0;
+}
+
+void perf_start(PerfCounters *counters) { (void)counters; }
+
+void perf_stop(PerfCounters *counters, double counts[PERF_NUM_EVENTS]) {
+  int i;
+  (void)counters;
+  for (i = 0; i < PERF_NUM_EVENTS; i++) {
+    counts[i] = -1;
+  }
+}
+
+void perf_close(PerfCounters *counters) { (void)counters; }
+
+#endif /* __linux__ */
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Hardware events counted around a benchmark, when the kernel allows it */
+typedef enum {
+  PERF_INSTRUCTIONS,
+  PERF_CYCLES,
+  PERF_BRANCH_MISSES,
+  PERF_L1D_MISSES,
+  PERF_LLC_MISSES,
+  PERF_NUM_EVENTS
+} PerfEvent;
+
+extern const char *const perf_event_names[PERF_NUM_EVENTS];
+
+/* Counters of the calling thread; fd is -1 for the unavailable ones */
+typedef struct {
+  int fd[PERF_NUM_EVENTS];
+} PerfCounters;
+
+/**
+ * Opens one counter per event for the calling thread, without counting
+ * the kernel, so that perf_event_paranoid up to 2 is enough.
+ * @return the number of events available; 0 when the kernel has no
+ * perf_event_open, no PMU (as in many virtual machines), or denies it.
+ */
+int perf_open(PerfCounters *counters);
+
+/* Resets and starts the counters */
+void perf_start(PerfCounters *counters);
+
+/**
+ * Stops the counters and stores the counts, scaled by the fraction of
+ * time they were scheduled on the PMU; unavailable events read as -1.
+ */
+void perf_stop(PerfCounters *counters, double counts[PERF_NUM_EVENTS]);
+
+void perf_close(PerfCounters *counters);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERF_H */
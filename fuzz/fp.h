@@ -37,6 +37,7 @@ extern "C" {
 
 #include <assert.h>
 #include <gmp.h>
+#include <safegcd_x64.h>
 #include <string.h>
 
 #define getTwoPowerK(X, K) \
@@ -74,6 +75,7 @@ extern "C" {
 #define FpSqr sqr_EltFp25519_1w_x64
 #define FpRed red_EltFp25519_1w_x64
 #define FpInv inv_EltFp25519_1w_x64
+#define FpInvSafegcd inv_safegcd_EltFp25519_1w_x64
 #define FpMod fred_EltFp25519_1w_x64
 #define FpMulA24 mul_a24_EltFp25519_1w_x64
 
@@ -111,6 +113,7 @@ extern "C" {
 #define FpSqr sqr_EltFp448_1w_x64
 #define FpRed red_EltFp448_1w_x64
 #define FpInv inv_EltFp448_1w_x64
+#define FpInvSafegcd inv_safegcd_EltFp448_1w_x64
 #define FpMod fred_EltFp448_1w_x64
 #define FpMulA24 mul_a24_EltFp448_1w_x64
 
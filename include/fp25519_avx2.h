@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef FP25519_AVX2_H
+#define FP25519_AVX2_H
+
+#include <stdint.h>
+
+#ifndef ALIGN_BYTES
+#define ALIGN_BYTES 32
+#endif
+
+#ifndef ALIGN
+#ifdef __INTEL_COMPILER
+#define ALIGN __declspec(align(ALIGN_BYTES))
+#else
+#define ALIGN __attribute__((aligned(ALIGN_BYTES)))
+#endif
+#endif
+
+/**
+ * Four elements of GF(2^255-19) in radix 2^25.5, one per 64-bit lane of a
+ * 256-bit register. Digit i of the four elements is stored in the words
+ * [4*i, 4*i+3]; even (odd) digits hold 26 (25) bits.
+ */
+#define NUM_DIGITS_FP25519_AVX2 10
+#define NUM_WORDS_ELTFP25519_AVX2 (4 * NUM_DIGITS_FP25519_AVX2)
+typedef ALIGN uint64_t EltFp25519_4w_avx2[NUM_WORDS_ELTFP25519_AVX2];
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Conversion from/to four consecutive EltFp25519_1w_x64 elements */
+void load_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a);
+
+void store_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a);
+
+void broadcast_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a);
+
+/* Prime Field Arithmetic */
+void add_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a,
+                            uint64_t *const b);
+
+void sub_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a,
+                            uint64_t *const b);
+
+void carry_EltFp25519_4w_avx2(uint64_t *const c);
+
+void mul_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a,
+                            uint64_t *const b);
+
+void sqr_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a);
+
+void mul_a24_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a);
+
+void cswap_EltFp25519_4w_avx2(uint64_t *const mask, uint64_t *const a,
+                              uint64_t *const b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FP25519_AVX2_H */
@@ -35,6 +35,7 @@
 #define FP25519_X64_H
 
 #include <stdint.h>
+#include "x64_variant.h"
 
 #ifndef ALIGN_BYTES
 #define ALIGN_BYTES 32
@@ -83,8 +84,19 @@ void sub_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a,
 
 void mul_a24_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a);
 
+void ladder_step_EltFp25519_x64(uint64_t *const P, uint64_t *const X1,
+                                uint64_t swap);
+
+void sqrn_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a,
+                            unsigned int n);
+
 void inv_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a);
 
+int sqrt_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a);
+
+void inv_batch_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a,
+                                 unsigned int n);
+
 void fred_EltFp25519_1w_x64(uint64_t *const c);
 
 #ifdef __cplusplus
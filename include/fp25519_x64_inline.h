@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FP25519_X64_INLINE_H
+#define FP25519_X64_INLINE_H
+
+#include "fp25519_x64.h"
+
+/**
+ * Static inline versions of the short field operations. The functions
+ * exported by fp25519_x64.c are wrappers around these, so both compute the
+ * same results; including this header lets the caller inline them. The
+ * code path (MULQ, BMI2 or ADX) follows the target flags of the file that
+ * includes it.
+ */
+
+static inline void add_EltFp25519_1w_x64_inline(uint64_t *const c,
+                                                uint64_t *const a,
+                                                uint64_t *const b) {
+#ifdef __ADX__
+  __asm__ __volatile__(
+    "mov     $38, %%eax ;"
+    "xorl  %%ecx, %%ecx ;"
+    "movq   (%2),  %%r8 ;"  "adcx   (%1),  %%r8 ;"
+    "movq  8(%2),  %%r9 ;"  "adcx  8(%1),  %%r9 ;"
+    "movq 16(%2), %%r10 ;"  "adcx 16(%1), %%r10 ;"
+    "movq 24(%2), %%r11 ;"  "adcx 24(%1), %%r11 ;"
+    "cmovc %%eax, %%ecx ;"
+    "xorl %%eax, %%eax  ;"
+    "adcx %%rcx,  %%r8  ;"
+    "adcx %%rax,  %%r9  ;"  "movq  %%r9,  8(%0) ;"
+    "adcx %%rax, %%r10  ;"  "movq %%r10, 16(%0) ;"
+    "adcx %%rax, %%r11  ;"  "movq %%r11, 24(%0) ;"
+    "mov     $38, %%ecx ;"
+    "cmovc %%ecx, %%eax ;"
+    "addq %%rax,  %%r8  ;"  "movq  %%r8,   (%0) ;"
+  :
+  : "r" (c), "r" (a), "r" (b)
+  : "memory", "cc", "%rax", "%rcx", "%r8", "%r9", "%r10", "%r11"
+  );
+#else
+  __asm__ __volatile__(
+    "mov     $38, %%eax ;"
+    "movq   (%2),  %%r8 ;"  "addq   (%1),  %%r8 ;"
+    "movq  8(%2),  %%r9 ;"  "adcq  8(%1),  %%r9 ;"
+    "movq 16(%2), %%r10 ;"  "adcq 16(%1), %%r10 ;"
+    "movq 24(%2), %%r11 ;"  "adcq 24(%1), %%r11 ;"
+    "mov      $0, %%ecx ;"
+    "cmovc %%eax, %%ecx ;"
+    "addq %%rcx,  %%r8  ;"
+    "adcq    $0,  %%r9  ;"  "movq  %%r9,  8(%0) ;"
+    "adcq    $0, %%r10  ;"  "movq %%r10, 16(%0) ;"
+    "adcq    $0, %%r11  ;"  "movq %%r11, 24(%0) ;"
+    "mov     $0, %%ecx  ;"
+    "cmovc %%eax, %%ecx ;"
+    "addq %%rcx,  %%r8  ;"  "movq  %%r8,   (%0) ;"
+  :
+  : "r" (c), "r" (a), "r" (b)
+  : "memory", "cc", "%rax", "%rcx", "%r8", "%r9", "%r10", "%r11"
+  );
+#endif
+}
+
+static inline void sub_EltFp25519_1w_x64_inline(uint64_t *const c,
+                                                uint64_t *const a,
+                                                uint64_t *const b) {
+  __asm__ __volatile__(
+    "mov     $38, %%eax ;"
+    "movq   (%1),  %%r8 ;"  "subq   (%2),  %%r8 ;"
+    "movq  8(%1),  %%r9 ;"  "sbbq  8(%2),  %%r9 ;"
+    "movq 16(%1), %%r10 ;"  "sbbq 16(%2), %%r10 ;"
+    "movq 24(%1), %%r11 ;"  "sbbq 24(%2), %%r11 ;"
+    "mov      $0, %%ecx ;"
+    "cmovc %%eax, %%ecx ;"
+    "subq %%rcx,  %%r8  ;"
+    "sbbq    $0,  %%r9  ;"  "movq  %%r9,  8(%0) ;"
+    "sbbq    $0, %%r10  ;"  "movq %%r10, 16(%0) ;"
+    "sbbq    $0, %%r11  ;"  "movq %%r11, 24(%0) ;"
+    "mov     $0, %%ecx  ;"
+    "cmovc %%eax, %%ecx ;"
+    "subq %%rcx,  %%r8  ;"  "movq  %%r8,   (%0) ;"
+  :
+  : "r" (c), "r" (a), "r" (b)
+  : "memory", "cc", "%rax", "%rcx", "%r8", "%r9", "%r10", "%r11"
+  );
+}
+
+/**
+ * Multiplication by a24 = (A+2)/4 = (486662+2)/4 = 121666
+ **/
+static inline void mul_a24_EltFp25519_1w_x64_inline(uint64_t *const c,
+                                                    uint64_t *const a) {
+  const uint64_t a24 = 121666;
+#ifdef __BMI2__
+  __asm__ __volatile__(
+    "movq     %2, %%rdx ;"
+    "mulx   (%1),  %%r8, %%r10 ;"
+    "mulx  8(%1),  %%r9, %%r11 ;"  "addq %%r10,  %%r9 ;"
+    "mulx 16(%1), %%r10, %%rax ;"  "adcq %%r11, %%r10 ;"
+    "mulx 24(%1), %%r11, %%rcx ;"  "adcq %%rax, %%r11 ;"
+    /***************************/  "adcq    $0, %%rcx ;"
+    "movl   $38, %%edx ;" /* 2*c = 38 = 2^256 mod 2^255-19*/
+    "imul %%rdx, %%rcx ;"
+    "addq %%rcx,  %%r8 ;"
+    "adcq    $0,  %%r9 ;"  "movq  %%r9,  8(%0) ;"
+    "adcq    $0, %%r10 ;"  "movq %%r10, 16(%0) ;"
+    "adcq    $0, %%r11 ;"  "movq %%r11, 24(%0) ;"
+    "mov     $0, %%ecx ;"
+    "cmovc %%edx, %%ecx ;"
+    "addq %%rcx,  %%r8 ;"  "movq  %%r8,   (%0) ;"
+  :
+  : "r" (c), "r" (a), "r" (a24)
+  : "memory", "cc", "%rax", "%rcx", "%rdx", "%r8", "%r9", "%r10", "%r11"
+  );
+#else /* Without BMI2 */
+  __asm__ __volatile__(
+  "movq %2, %%rax;" "mulq  0(%1);" "movq %%rax,  %%r8;" "movq %%rdx,  %%r9;"
+  "movq %2, %%rax;" "mulq  8(%1);" "movq %%rax, %%r12;" "movq %%rdx, %%r10;"
+  "movq %2, %%rax;" "mulq 16(%1);" "movq %%rax, %%r13;" "movq %%rdx, %%r11;"
+  "movq %2, %%rax;" "mulq 24(%1);"
+  "addq %%r12,  %%r9;"
+  "adcq %%r13, %%r10;"
+  "adcq %%rax, %%r11;"
+  "adcq    $0, %%rdx;"
+  "movl   $38, %%eax;" /* 2*c = 38 = 2^256 mod 2^255-19*/
+  "imulq %%rax, %%rdx;"
+  "addq %%rdx, %%r8;"
+  "adcq $0,  %%r9;"  "movq  %%r9,  8(%0);"
+  "adcq $0, %%r10;"  "movq %%r10, 16(%0);"
+  "adcq $0, %%r11;"  "movq %%r11, 24(%0);"
+  "movq $0, %%rdx;"
+  "cmovc %%rax, %%rdx;"
+  "addq %%rdx, %%r8;" "movq %%r8,  0(%0);"
+  :
+  : "r" (c), "r" (a), "r" (a24)
+  : "memory", "cc", "%rax", "%rdx", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13"
+  );
+#endif
+}
+
+/**
+ * Given C, a 256-bit number, fred_EltFp25519_1w_x64 updates C
+ * with a number such that 0 <= C < 2**255-19.
+ * Contributed by: Samuel Neves.
+ **/
+static inline void fred_EltFp25519_1w_x64_inline(uint64_t *const c) {
+  uint64_t tmp0, tmp1;
+  __asm__ __volatile__ (
+    "movl   $19,   %k5 ;"
+    "movl   $38,   %k4 ;"
+
+    "btrq   $63,    %3 ;" /* Put bit 255 in carry flag and clear */
+    "cmovncl %k5,   %k4 ;" /* c[255] ? 38 : 19 */
+
+    /* Add either 19 or 38 to c */
+    "addq    %4,   %0 ;"
+    "adcq    $0,   %1 ;"
+    "adcq    $0,   %2 ;"
+    "adcq    $0,   %3 ;"
+
+    /* Test for bit 255 again; only triggered on overflow modulo 2^255-19 */
+    "movl    $0,  %k4 ;"
+    "cmovnsl %k5,  %k4 ;" /* c[255] ? 0 : 19 */
+    "btrq   $63,   %3 ;" /* Clear bit 255 */
+
+    /* Subtract 19 if necessary */
+    "subq    %4,   %0 ;"
+    "sbbq    $0,   %1 ;"
+    "sbbq    $0,   %2 ;"
+    "sbbq    $0,   %3 ;"
+
+    : "+r"(c[0]), "+r"(c[1]), "+r"(c[2]), "+r"(c[3]), "=r"(tmp0), "=r"(tmp1)
+    :
+    : "memory", "cc"
+  );
+}
+
+#endif /* FP25519_X64_INLINE_H */
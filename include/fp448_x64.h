@@ -35,6 +35,7 @@
 #define FP448_X64_H
 
 #include <stdint.h>
+#include "x64_variant.h"
 
 #ifndef ALIGN_BYTES
 #define ALIGN_BYTES 32
@@ -52,12 +53,21 @@
 #define NUM_WORDS_ELTFP448_X64 7
 typedef ALIGN uint64_t EltFp448_1w_x64[NUM_WORDS_ELTFP448_X64];
 typedef ALIGN uint64_t EltFp448_1w_Buffer_x64[2 * NUM_WORDS_ELTFP448_X64];
+typedef ALIGN uint64_t EltFp448_2w_x64[2 * NUM_WORDS_ELTFP448_X64];
+typedef ALIGN uint64_t EltFp448_2w_Buffer_x64[4 * NUM_WORDS_ELTFP448_X64];
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /* Integer Arithmetic */
+void mul2_448x448_integer_x64(uint64_t *const c, uint64_t *const a,
+                              uint64_t *const b);
+
+void sqr2_448x448_integer_x64(uint64_t *const c, uint64_t *const a);
+
+void red_EltFp448_2w_x64(uint64_t *const c, uint64_t *const a);
+
 void mul_448x448_integer_x64(uint64_t *const c, uint64_t *const a,
                              uint64_t *const b);
 
@@ -74,8 +84,16 @@ void sub_EltFp448_1w_x64(uint64_t *const c, uint64_t *const a,
 
 void mul_a24_EltFp448_1w_x64(uint64_t *const c, uint64_t *const a);
 
+void sqrn_EltFp448_1w_x64(uint64_t *const c, uint64_t *const a,
+                          unsigned int n);
+
 void inv_EltFp448_1w_x64(uint64_t *const pC, uint64_t *const pA);
 
+int sqrt_EltFp448_1w_x64(uint64_t *const c, uint64_t *const a);
+
+void inv_batch_EltFp448_1w_x64(uint64_t *const c, uint64_t *const a,
+                               unsigned int n);
+
 void fred_EltFp448_1w_x64(uint64_t *const c);
 
 #ifdef __cplusplus
@@ -90,14 +108,22 @@ void fred_EltFp448_1w_x64(uint64_t *const c);
   sqr_448x448_integer_x64(buffer_1w, A); \
   red_EltFp448_1w_x64(A, buffer_1w);
 
+#define mul_EltFp448_2w_x64(C, A, B)         \
+  mul2_448x448_integer_x64(buffer_2w, A, B); \
+  red_EltFp448_2w_x64(C, buffer_2w);
+
+#define sqr_EltFp448_2w_x64(A)            \
+  sqr2_448x448_integer_x64(buffer_2w, A); \
+  red_EltFp448_2w_x64(A, buffer_2w);
+
 #define copy_EltFp448_1w_x64(C, A) \
-  C[0] = A[0];                     \
-  C[1] = A[1];                     \
-  C[2] = A[2];                     \
-  C[3] = A[3];                     \
-  C[4] = A[4];                     \
-  C[5] = A[5];                     \
-  C[6] = A[6];
+  (C)[0] = (A)[0];                 \
+  (C)[1] = (A)[1];                 \
+  (C)[2] = (A)[2];                 \
+  (C)[3] = (A)[3];                 \
+  (C)[4] = (A)[4];                 \
+  (C)[5] = (A)[5];                 \
+  (C)[6] = (A)[6];
 
 #define setzero_EltFp448_1w_x64(C) \
   (C)[0] = 0;                      \
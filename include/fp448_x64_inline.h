@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FP448_X64_INLINE_H
+#define FP448_X64_INLINE_H
+
+#include "fp448_x64.h"
+
+/**
+ * Static inline versions of the short field operations. The functions
+ * exported by fp448_x64.c are wrappers around these, so both compute the
+ * same results; including this header lets the caller inline them. The
+ * code path (MULQ, BMI2 or ADX) follows the target flags of the file that
+ * includes it.
+ */
+
+static inline void add_EltFp448_1w_x64_inline(uint64_t *c, uint64_t *a,
+                                              uint64_t *b) {
+#if __ADX__
+  __asm__ __volatile__(
+      "xorl %%eax, %%eax;"
+      "movq $0x100000000, %%rdx;"
+      "movq  0(%2),  %%r8; adcx  0(%1),  %%r8;"
+      "movq  8(%2),  %%r9; adcx  8(%1),  %%r9;"
+      "movq 16(%2), %%r10; adcx 16(%1), %%r10;"
+      "movq 24(%2), %%r11; adcx 24(%1), %%r11;"
+      "movq 32(%2), %%r12; adcx 32(%1), %%r12;"
+      "movq 40(%2), %%r13; adcx 40(%1), %%r13;"
+      "movq 48(%2), %%r14; adcx 48(%1), %%r14;"
+      "movq   $0x0, %%rcx; cmovc %%rdx, %%rcx;"
+      "adcx  %%rax,  %%r8;"
+      "adcx  %%rax,  %%r9;"
+      "adcx  %%rax, %%r10;"
+      "adcx  %%rcx, %%r11;"
+      "adcx  %%rax, %%r12;"
+      "adcx  %%rax, %%r13;"
+      "adcx  %%rax, %%r14;"
+      "movq   $0x0, %%rcx;"
+      "cmovc %%rdx, %%rcx;"
+      "adcx  %%rax,  %%r8; movq  %%r8,  0(%0);"
+      "adcx  %%rax,  %%r9; movq  %%r9,  8(%0);"
+      "adcx  %%rax, %%r10; movq %%r10, 16(%0);"
+      "adcx  %%rcx, %%r11; movq %%r11, 24(%0);"
+      "adcx  %%rax, %%r12; movq %%r12, 32(%0);"
+      "adcx  %%rax, %%r13; movq %%r13, 40(%0);"
+      "adcx  %%rax, %%r14; movq %%r14, 48(%0);"
+      :
+      : "r"(c), "r"(a), "r"(b)
+      : "memory", "cc", "%rax", "%rcx", "%rdx", "%r8", "%r9", "%r10", "%r11",
+        "%r12", "%r13", "%r14");
+#else
+  __asm__ __volatile__(
+      "movq $0x100000000, %%rdx;"
+      "movq  0(%2),  %%r8; addq  0(%1),  %%r8;"
+      "movq  8(%2),  %%r9; adcq  8(%1),  %%r9;"
+      "movq 16(%2), %%r10; adcq 16(%1), %%r10;"
+      "movq 24(%2), %%r11; adcq 24(%1), %%r11;"
+      "movq 32(%2), %%r12; adcq 32(%1), %%r12;"
+      "movq 40(%2), %%r13; adcq 40(%1), %%r13;"
+      "movq 48(%2), %%r14; adcq 48(%1), %%r14;"
+      "movq     $0, %%rcx; cmovc %%rdx, %%rcx;"
+      "adcq     $0,  %%r8;"
+      "adcq     $0,  %%r9;"
+      "adcq     $0, %%r10;"
+      "adcq  %%rcx, %%r11;"
+      "adcq     $0, %%r12;"
+      "adcq     $0, %%r13;"
+      "adcq     $0, %%r14;"
+      "movq     $0, %%rcx; cmovc %%rdx, %%rcx;"
+      "adcq     $0,  %%r8; movq  %%r8,  0(%0);"
+      "adcq     $0,  %%r9; movq  %%r9,  8(%0);"
+      "adcq     $0, %%r10; movq %%r10, 16(%0);"
+      "adcq  %%rcx, %%r11; movq %%r11, 24(%0);"
+      "adcq     $0, %%r12; movq %%r12, 32(%0);"
+      "adcq     $0, %%r13; movq %%r13, 40(%0);"
+      "adcq     $0, %%r14; movq %%r14, 48(%0);"
+      :
+      : "r"(c), "r"(a), "r"(b)
+      : "memory", "cc", "%rax", "%rcx", "%rdx", "%r8", "%r9", "%r10", "%r11",
+        "%r12", "%r13", "%r14");
+#endif
+}
+
+static inline void sub_EltFp448_1w_x64_inline(uint64_t *c, uint64_t *a,
+                                              uint64_t *b) {
+  __asm__ __volatile__(
+      "movq  $0x100000000, %%rdx;"
+      "movq  0(%1),  %%r8; subq  0(%2),  %%r8;"
+      "movq  8(%1),  %%r9; sbbq  8(%2),  %%r9;"
+      "movq 16(%1), %%r10; sbbq 16(%2), %%r10;"
+      "movq 24(%1), %%r11; sbbq 24(%2), %%r11;"
+      "movq 32(%1), %%r12; sbbq 32(%2), %%r12;"
+      "movq 40(%1), %%r13; sbbq 40(%2), %%r13;"
+      "movq 48(%1), %%r14; sbbq 48(%2), %%r14;"
+      "movq     $0, %%rcx; cmovc %%rdx, %%rcx;"
+      "sbbq     $0,  %%r8;"
+      "sbbq     $0,  %%r9;"
+      "sbbq     $0, %%r10;"
+      "sbbq  %%rcx, %%r11;"
+      "sbbq     $0, %%r12;"
+      "sbbq     $0, %%r13;"
+      "sbbq     $0, %%r14;"
+      "movq     $0, %%rcx; cmovc %%rdx, %%rcx;"
+      "sbbq     $0,  %%r8; movq  %%r8,  0(%0);"
+      "sbbq     $0,  %%r9; movq  %%r9,  8(%0);"
+      "sbbq     $0, %%r10; movq %%r10, 16(%0);"
+      "sbbq  %%rcx, %%r11; movq %%r11, 24(%0);"
+      "sbbq     $0, %%r12; movq %%r12, 32(%0);"
+      "sbbq     $0, %%r13; movq %%r13, 40(%0);"
+      "sbbq     $0, %%r14; movq %%r14, 48(%0);"
+      :
+      : "r"(c), "r"(a), "r"(b)
+      : "memory", "cc", "%rax", "%rcx", "%rdx", "%r8", "%r9", "%r10", "%r11",
+        "%r12", "%r13", "%r14");
+}
+
+static inline void mul_a24_EltFp448_1w_x64_inline(uint64_t *c, uint64_t *a) {
+  const uint64_t a24 = 39082;  // a24 = (A+2)/4 = (156326+2)/4 = 39082
+#if __BMI2__
+  __asm__ __volatile__(
+      "movq %2, %%rdx;"
+      "mulx  0(%1), %%rcx,  %%r8;"
+      "mulx  8(%1), %%rax,  %%r9; addq %%rax,  %%r8;"
+      "mulx 16(%1), %%rax, %%r10; adcq %%rax,  %%r9;"
+      "mulx 24(%1), %%rax, %%r11; adcq %%rax, %%r10;"
+      "mulx 32(%1), %%rax, %%r12; adcq %%rax, %%r11;"
+      "mulx 40(%1), %%rax, %%r13; adcq %%rax, %%r12;"
+      "mulx 48(%1), %%rax, %%rdx; adcq %%rax, %%r13;"
+      "adcq     $0, %%rdx;"
+
+      /**
+       * ( c7) + (c6,...,c0)
+       * (rdx)
+       */
+      "movq %%rdx,%%rax; shlq $32,%%rax;"
+      "addq %%rdx,%%rcx; movq  $0,%%rdx;"
+      "adcq    $0, %%r8;"
+      "adcq    $0, %%r9;"
+      "adcq %%rax,%%r10;"
+      "adcq    $0,%%r11;"
+      "adcq    $0,%%r12;"
+      "adcq    $0,%%r13;"
+      "adcq    $0,%%rdx;"
+
+      "movq %%rdx,%%rax; shlq $32,%%rax;"
+      "addq %%rdx,%%rcx; movq %%rcx, 0(%0);"
+      "adcq    $0, %%r8; movq  %%r8, 8(%0);"
+      "adcq    $0, %%r9; movq  %%r9,16(%0);"
+      "adcq %%rax,%%r10; movq %%r10,24(%0);"
+      "adcq    $0,%%r11; movq %%r11,32(%0);"
+      "adcq    $0,%%r12; movq %%r12,40(%0);"
+      "adcq    $0,%%r13; movq %%r13,48(%0);"
+      :
+      : "r"(c), "r"(a), "r"(a24)
+      : "memory", "cc", "%rax", "%rcx", "%rdx", "%r8", "%r9", "%r10", "%r11",
+        "%r12", "%r13", "%r15");
+#else /* Without BMI2 */
+  __asm__ __volatile__(
+      "movq %2, %%r15;"
+      "movq  0(%1),%%rax; mulq %%r15;"
+      "movq %%rax, %%rcx;                movq %%rdx,  %%r8;"
+      "movq  8(%1),%%rax; mulq %%r15;"
+      "addq %%rax,  %%r8; adcq $0,%%rdx; movq %%rdx,  %%r9;"
+      "movq 16(%1),%%rax; mulq %%r15;"
+      "addq %%rax,  %%r9; adcq $0,%%rdx; movq %%rdx, %%r10;"
+      "movq 24(%1),%%rax; mulq %%r15;"
+      "addq %%rax, %%r10; adcq $0,%%rdx; movq %%rdx, %%r11;"
+      "movq 32(%1),%%rax; mulq %%r15;"
+      "addq %%rax, %%r11; adcq $0,%%rdx; movq %%rdx, %%r12;"
+      "movq 40(%1),%%rax; mulq %%r15;"
+      "addq %%rax, %%r12; adcq $0,%%rdx; movq %%rdx, %%r13;"
+      "movq 48(%1),%%rax; mulq %%r15;"
+      "addq %%rax, %%r13; adcq $0,%%rdx;"
+
+      /**
+       * ( c7) + (c6,...,c0)
+       * (rdx)
+       */
+      "movq %%rdx,%%rax; shlq $32,%%rax;"
+      "addq %%rdx,%%rcx; movq  $0,%%rdx;"
+      "adcq    $0, %%r8;"
+      "adcq    $0, %%r9;"
+      "adcq %%rax,%%r10;"
+      "adcq    $0,%%r11;"
+      "adcq    $0,%%r12;"
+      "adcq    $0,%%r13;"
+      "adcq    $0,%%rdx;"
+
+      "movq %%rdx,%%rax; shlq $32,%%rax;"
+      "addq %%rdx,%%rcx; movq %%rcx, 0(%0);"
+      "adcq    $0, %%r8; movq  %%r8, 8(%0);"
+      "adcq    $0, %%r9; movq  %%r9,16(%0);"
+      "adcq %%rax,%%r10; movq %%r10,24(%0);"
+      "adcq    $0,%%r11; movq %%r11,32(%0);"
+      "adcq    $0,%%r12; movq %%r12,40(%0);"
+      "adcq    $0,%%r13; movq %%r13,48(%0);"
+      :
+      : "r"(c), "r"(a), "r"(a24)
+      : "memory", "cc", "%rax", "%rcx", "%rdx", "%r8", "%r9", "%r10", "%r11",
+        "%r12", "%r13", "%r15");
+#endif
+}
+
+static inline void fred_EltFp448_1w_x64_inline(uint64_t *c) {
+  EltFp448_1w_x64 p = {0xffffffffffffffff, 0xffffffffffffffff,
+                       0xffffffffffffffff, 0xfffffffeffffffff,
+                       0xffffffffffffffff, 0xffffffffffffffff,
+                       0xffffffffffffffff};
+  sub_EltFp448_1w_x64_inline(c, c, p);
+}
+
+#endif /* FP448_X64_INLINE_H */
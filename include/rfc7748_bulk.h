@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RFC7748_BULK_H
+#define RFC7748_BULK_H
+
+#include <rfc7748_precomputed.h>
+
+/**
+ * Engine that computes large arrays of keys on a pool of worker threads.
+ * The keys are split into chunks of 64, and every worker takes chunks from
+ * its own share of them and then steals from the shares of the others.
+ * Each chunk runs on the 4-way AVX2 functions when the processor supports
+ * them, and on the batch functions otherwise. It is built as the separate
+ * library rfc7748_bulk, which needs pthreads.
+ */
+typedef struct Rfc7748Bulk Rfc7748Bulk;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Starts num_threads workers, or one per CPU the process may run on when
+ * it is 0. With pin set, the i-th worker is pinned to the i-th of those
+ * CPUs, wrapping around if there are more workers than CPUs.
+ * @return the engine, or NULL if the workers could not be started.
+ */
+Rfc7748Bulk *RFC7748_BulkCreate(unsigned int num_threads, int pin);
+
+/* Stops the workers and frees the engine */
+void RFC7748_BulkDestroy(Rfc7748Bulk *bulk);
+
+unsigned int RFC7748_BulkThreads(Rfc7748Bulk *bulk);
+
+/**
+ * Same outputs as X25519_KeyGen_batch, X25519_Shared_batch and their X448
+ * counterparts; they return once every key is computed. Calls from several
+ * threads on the same engine run one after the other.
+ */
+void RFC7748_BulkX25519_KeyGen(Rfc7748Bulk *bulk, argKey *session_key,
+                               argKey *private_key, unsigned int n);
+
+void RFC7748_BulkX25519_Shared(Rfc7748Bulk *bulk, argKey *shared,
+                               argKey *session_key, argKey *private_key,
+                               unsigned int n);
+
+void RFC7748_BulkX448_KeyGen(Rfc7748Bulk *bulk, argKey *session_key,
+                             argKey *private_key, unsigned int n);
+
+void RFC7748_BulkX448_Shared(Rfc7748Bulk *bulk, argKey *shared,
+                             argKey *session_key, argKey *private_key,
+                             unsigned int n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RFC7748_BULK_H */
@@ -0,0 +1,291 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RFC7748_COALESCER_HPP
+#define RFC7748_COALESCER_HPP
+
+#include <rfc7748_precomputed.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rfc7748 {
+
+/* Curves accepted by Coalescer, with the functions it runs on them */
+struct X25519 {
+  static const unsigned int kKeySize = X25519_KEYSIZE_BYTES;
+  static void keygen_batch(argKey *pk, argKey *sk, unsigned int n) {
+    X25519_KeyGen_batch(pk, sk, n);
+  }
+  static void shared_batch(argKey *ss, argKey *pk, argKey *sk,
+                           unsigned int n) {
+    X25519_Shared_batch(ss, pk, sk, n);
+  }
+  static void keygen_4w(argKey *pk, argKey *sk) { X25519_KeyGen_4w(pk, sk); }
+  static void shared_4w(argKey *ss, argKey *pk, argKey *sk) {
+    X25519_Shared_4w(ss, pk, sk);
+  }
+};
+
+struct X448 {
+  static const unsigned int kKeySize = X448_KEYSIZE_BYTES;
+  static void keygen_batch(argKey *pk, argKey *sk, unsigned int n) {
+    X448_KeyGen_batch(pk, sk, n);
+  }
+  static void shared_batch(argKey *ss, argKey *pk, argKey *sk,
+                           unsigned int n) {
+    X448_Shared_batch(ss, pk, sk, n);
+  }
+  static void keygen_4w(argKey *pk, argKey *sk) { X448_KeyGen_4w(pk, sk); }
+  static void shared_4w(argKey *ss, argKey *pk, argKey *sk) {
+    X448_Shared_4w(ss, pk, sk);
+  }
+};
+
+/**
+ * Collects single KeyGen and Shared requests from many threads and runs
+ * them in batches: a batch starts as soon as batch_size requests are
+ * queued, or once the oldest one has waited max_delay. Groups of four run
+ * on the 4-way AVX2 functions when the processor supports them, and the
+ * rest on the batch functions, which share one inversion. Results are
+ * delivered through futures or callbacks, called from a worker thread.
+ */
+template <typename Curve>
+class Coalescer {
+ public:
+  typedef std::array<uint8_t, Curve::kKeySize> Key;
+  typedef std::function<void(const Key &)> Callback;
+
+  struct Options {
+    unsigned int batch_size = 8;
+    std::chrono::microseconds max_delay = std::chrono::microseconds(100);
+    unsigned int num_workers = 1;
+  };
+
+  struct Stats {
+    uint64_t requests = 0;
+    uint64_t batches = 0;
+    uint64_t full_batches = 0; /* The others were flushed by max_delay */
+  };
+
+  Coalescer() : Coalescer(Options()) {}
+
+  explicit Coalescer(const Options &options)
+      : options_(options),
+        avx2_(__builtin_cpu_supports("avx2") != 0),
+        stop_(false) {
+    if (options_.batch_size == 0) {
+      options_.batch_size = 1;
+    }
+    for (unsigned int i = 0; i < std::max(1u, options_.num_workers); i++) {
+      workers_.emplace_back(&Coalescer::run, this);
+    }
+  }
+
+  /* Runs the requests still queued, then stops the workers */
+  ~Coalescer() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    ready_.notify_all();
+    for (std::thread &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  Coalescer(const Coalescer &) = delete;
+  Coalescer &operator=(const Coalescer &) = delete;
+
+  std::future<Key> KeyGen(const Key &private_key) {
+    return submit(nullptr, private_key, Callback());
+  }
+
+  std::future<Key> Shared(const Key &session_key, const Key &private_key) {
+    return submit(&session_key, private_key, Callback());
+  }
+
+  void KeyGen(const Key &private_key, Callback callback) {
+    submit(nullptr, private_key, std::move(callback));
+  }
+
+  void Shared(const Key &session_key, const Key &private_key,
+              Callback callback) {
+    submit(&session_key, private_key, std::move(callback));
+  }
+
+  Stats GetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Request {
+    bool shared;
+    Key session_key;
+    Key private_key;
+    Key output;
+    Callback callback;
+    std::promise<Key> promise;
+    Clock::time_point arrival;
+  };
+
+  std::future<Key> submit(const Key *session_key, const Key &private_key,
+                          Callback callback) {
+    std::unique_ptr<Request> request(new Request);
+    std::future<Key> future;
+    request->shared = session_key != nullptr;
+    if (session_key != nullptr) {
+      request->session_key = *session_key;
+    }
+    request->private_key = private_key;
+    request->callback = std::move(callback);
+    if (!request->callback) {
+      future = request->promise.get_future();
+    }
+    request->arrival = Clock::now();
+
+    bool wake = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(request));
+      /* Wakes a worker to start the timer, or to run a full batch */
+      wake = queue_.size() == 1 || queue_.size() >= options_.batch_size;
+    }
+    if (wake) {
+      ready_.notify_one();
+    }
+    return future;
+  }
+
+  void run() {
+    std::vector<std::unique_ptr<Request>> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      while (!stop_ && queue_.size() < options_.batch_size) {
+        if (queue_.empty()) {
+          ready_.wait(lock);
+        } else if (ready_.wait_until(
+                       lock, queue_.front()->arrival + options_.max_delay) ==
+                   std::cv_status::timeout) {
+          break;
+        }
+      }
+      if (queue_.empty()) {
+        if (stop_) {
+          return;
+        }
+        continue;
+      }
+      const size_t n = std::min<size_t>(queue_.size(), options_.batch_size);
+      for (size_t i = 0; i < n; i++) {
+        batch.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+      }
+      stats_.requests += n;
+      stats_.batches++;
+      stats_.full_batches += n == options_.batch_size;
+      /* Lets another worker take the next batch meanwhile */
+      if (!queue_.empty()) {
+        ready_.notify_one();
+      }
+      lock.unlock();
+
+      compute(batch, false);
+      compute(batch, true);
+      for (std::unique_ptr<Request> &request : batch) {
+        if (request->callback) {
+          request->callback(request->output);
+        } else {
+          request->promise.set_value(request->output);
+        }
+      }
+      batch.clear();
+      lock.lock();
+    }
+  }
+
+  /* Runs the KeyGen (or Shared) requests of a batch */
+  void compute(std::vector<std::unique_ptr<Request>> &batch, bool shared) {
+    std::vector<argKey> ss, pk, sk;
+    for (std::unique_ptr<Request> &request : batch) {
+      if (request->shared == shared) {
+        ss.push_back(request->output.data());
+        pk.push_back(request->session_key.data());
+        sk.push_back(request->private_key.data());
+      }
+    }
+    const unsigned int n = static_cast<unsigned int>(sk.size());
+    unsigned int i = 0;
+    if (avx2_) {
+      for (; i + 4 <= n; i += 4) {
+        if (shared) {
+          Curve::shared_4w(&ss[i], &pk[i], &sk[i]);
+        } else {
+          Curve::keygen_4w(&ss[i], &sk[i]);
+        }
+      }
+    }
+    if (i < n) {
+      if (shared) {
+        Curve::shared_batch(&ss[i], &pk[i], &sk[i], n - i);
+      } else {
+        Curve::keygen_batch(&ss[i], &sk[i], n - i);
+      }
+    }
+  }
+
+  Options options_;
+  const bool avx2_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<std::unique_ptr<Request>> queue_;
+  Stats stats_;
+  bool stop_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace rfc7748
+
+#endif /* RFC7748_COALESCER_HPP */
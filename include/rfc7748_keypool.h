@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RFC7748_KEYPOOL_H
+#define RFC7748_KEYPOOL_H
+
+#include <rfc7748_precomputed.h>
+
+/**
+ * Pool of ephemeral key pairs. A background thread generates them with
+ * X25519_KeyGen_batch or X448_KeyGen_batch and pushes them into a ring,
+ * from which any number of threads pop them without taking locks. It is
+ * built as the separate library rfc7748_keypool, which needs pthreads.
+ */
+typedef struct Rfc7748KeyPool Rfc7748KeyPool;
+
+typedef enum { RFC7748_POOL_X25519 = 0, RFC7748_POOL_X448 } Rfc7748PoolCurve;
+
+/* Fields left as zero take the default in brackets */
+typedef struct {
+  unsigned int capacity;       /* Pairs in the ring, rounded up to 2^n [1024] */
+  unsigned int low_watermark;  /* Refilling starts below this level [cap/4]  */
+  unsigned int high_watermark; /* and stops once it is reached [capacity]    */
+  unsigned int batch;          /* Pairs per call to KeyGen_batch [64],       */
+                               /* capped at high_watermark                   */
+  /**
+   * Fills the private keys; required. It is called from the background
+   * thread and, at the same time, from every thread whose RFC7748_PoolPop
+   * finds the ring empty, so it must be thread-safe.
+   */
+  void (*random)(uint8_t *buffer, int num_bytes);
+} Rfc7748PoolConfig;
+
+typedef struct {
+  uint64_t pops;      /* Pairs returned by RFC7748_PoolPop              */
+  uint64_t misses;    /* Pops that found the ring empty                 */
+  uint64_t generated; /* Pairs pushed by the background thread          */
+  uint64_t refills;   /* Times the background thread woke up to refill  */
+  unsigned int ready; /* Pairs in the ring when the stats were read     */
+} Rfc7748PoolStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Creates a pool and starts its background thread, which fills the ring up
+ * to the high watermark.
+ * @return the pool, or NULL if the configuration is not valid or the
+ * thread could not be started.
+ */
+Rfc7748KeyPool *RFC7748_PoolCreate(Rfc7748PoolCurve curve,
+                                   const Rfc7748PoolConfig *config);
+
+/* Stops the background thread, wipes the ring and frees the pool */
+void RFC7748_PoolDestroy(Rfc7748KeyPool *pool);
+
+/**
+ * Takes a key pair from the pool; it can be called from any thread. When
+ * the ring is empty, the pair is generated by the caller with KeyGen.
+ * @return 0 if the pair came from the ring, or 1 if it was generated.
+ */
+int RFC7748_PoolPop(Rfc7748KeyPool *pool, argKey public_key,
+                    argKey private_key);
+
+void RFC7748_PoolGetStats(Rfc7748KeyPool *pool, Rfc7748PoolStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RFC7748_KEYPOOL_H */
@@ -34,6 +34,7 @@
 #ifndef RFC7748_PRECOMPUTED_H
 #define RFC7748_PRECOMPUTED_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifndef ALIGN_BYTES
@@ -59,9 +60,140 @@ typedef void (*KeyGen)(argKey session_key, argKey private_key);
 
 typedef void (*Shared)(argKey shared, argKey session_key, argKey private_key);
 
+typedef void (*KeyGenBatch)(argKey *session_key, argKey *private_key,
+                            unsigned int n);
+
+typedef void (*SharedBatch)(argKey *shared, argKey *session_key,
+                            argKey *private_key, unsigned int n);
+
+typedef void (*KeyGen4w)(argKey *session_key, argKey *private_key);
+
+typedef void (*Shared4w)(argKey *shared, argKey *session_key,
+                         argKey *private_key);
+
+/**
+ * Ladder table of a peer public key, in the format of Table_Ladder_8k: one
+ * field element per scalar bit, followed by the start point of the ladder,
+ * the public key, and a last element whose first word is nonzero if the
+ * table can be used.
+ */
+#define X25519_PEER_TABLE_WORDS (255 * 4)
+typedef ALIGN uint64_t X25519_PEER_TABLE[X25519_PEER_TABLE_WORDS];
+#define X448_PEER_TABLE_WORDS (449 * 7)
+typedef ALIGN uint64_t X448_PEER_TABLE[X448_PEER_TABLE_WORDS];
+
+typedef uint64_t *argPeerTable;
+
+typedef void (*Precompute)(argPeerTable table, argKey session_key);
+
+typedef void (*SharedPeer)(argKey shared, argPeerTable table,
+                           argKey private_key);
+
+/**
+ * Instruction sets used by the x64 field arithmetic. The library selects
+ * the fastest one supported by the processor when it is loaded.
+ */
+typedef enum {
+  RFC7748_IMPL_AUTO = 0, /* Fastest variant supported by the processor */
+  RFC7748_IMPL_MULQ,     /* MULQ only, runs on any x86_64 processor    */
+  RFC7748_IMPL_BMI2,     /* MULX                                       */
+  RFC7748_IMPL_ADX       /* MULX, ADCX and ADOX                        */
+} Rfc7748Impl;
+
+/* Algorithms for the field inversion that ends each scalar multiplication */
+typedef enum {
+  RFC7748_INV_FERMAT = 0, /* Addition chain computing a^(p-2) */
+  RFC7748_INV_SAFEGCD     /* Constant-time Bernstein-Yang gcd */
+} Rfc7748Inv;
+
+/**
+ * Precomputation used by the x64 KeyGen functions. The precomputed ladder
+ * reads one table entry per scalar bit; without a table, KeyGen runs the
+ * ladder of the Shared functions on the base point instead. The comb adds
+ * 64 (X25519) or 112 (X448) points of a table on Ed25519 or Ed448 and then
+ * maps the sum to the Montgomery curve.
+ */
+typedef enum {
+  RFC7748_TABLE_LADDER = 0, /* 8 KB (X25519) and 25 KB (X448) tables   */
+  RFC7748_TABLE_NONE,       /* No table, about 1.5 times slower        */
+  RFC7748_TABLE_COMB        /* 24 KB (X25519) and 18 KB (X448) combs   */
+} Rfc7748Table;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Forces the variant used by the X25519 and X448 functions; it is meant
+ * for testing and benchmarking, and must not run concurrently with them.
+ * The 4-way functions keep using AVX2 when the processor supports it, and
+ * convert their results to affine coordinates with the selected variant.
+ * @return 0 on success, or -1 if the processor does not support impl.
+ */
+int RFC7748_SetImpl(Rfc7748Impl impl);
+
+/* Returns the variant currently in use (never RFC7748_IMPL_AUTO) */
+Rfc7748Impl RFC7748_GetImpl(void);
+
+/* Returns 1 if the processor can run the given variant, 0 otherwise */
+int RFC7748_HasImpl(Rfc7748Impl impl);
+
+/**
+ * Selects the inversion algorithm; the default is RFC7748_INV_FERMAT
+ * unless the library was built with -DINV_SAFEGCD=ON. As RFC7748_SetImpl,
+ * it must not run concurrently with the other functions.
+ */
+void RFC7748_SetInv(Rfc7748Inv inv);
+
+Rfc7748Inv RFC7748_GetInv(void);
+
+/**
+ * Selects the precomputation used by X25519_KeyGen, X448_KeyGen and their
+ * batch versions; the default is RFC7748_TABLE_LADDER. The 4-way functions
+ * are not affected. It must not run concurrently with the other functions.
+ * @return 0 on success, or -1 if table is not a valid choice.
+ */
+int RFC7748_SetTable(Rfc7748Table table);
+
+Rfc7748Table RFC7748_GetTable(void);
+
+/**
+ * Locates the table read by X25519_KeyGen (X448_KeyGen) with the current
+ * variant and precomputation, e.g. to evict it from the caches when
+ * benchmarking.
+ * @return its size in bytes, or 0 for RFC7748_TABLE_NONE.
+ */
+size_t RFC7748_X25519_TableMemory(const void **table);
+size_t RFC7748_X448_TableMemory(const void **table);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * X25519_Precompute and X448_Precompute build, once, the ladder table of a
+ * peer public key (8 KB for X25519 and 25 KB for X448); X25519_Shared_peer
+ * and X448_Shared_peer then compute the shared secret with it at the speed
+ * of KeyGen. Their outputs are identical to those of X25519_Shared and
+ * X448_Shared. Public keys outside the prime-order subgroup, including
+ * those on the twist, get a table that makes Shared_peer fall back to the
+ * plain ladder.
+ */
 extern const KeyGen X25519_KeyGen;
 extern const Shared X25519_Shared;
+extern const KeyGenBatch X25519_KeyGen_batch;
+extern const SharedBatch X25519_Shared_batch;
+extern const KeyGen4w X25519_KeyGen_4w;
+extern const Shared4w X25519_Shared_4w;
+extern const Precompute X25519_Precompute;
+extern const SharedPeer X25519_Shared_peer;
 extern const KeyGen X448_KeyGen;
 extern const Shared X448_Shared;
+extern const KeyGenBatch X448_KeyGen_batch;
+extern const SharedBatch X448_Shared_batch;
+extern const KeyGen4w X448_KeyGen_4w;
+extern const Shared4w X448_Shared_4w;
+extern const Precompute X448_Precompute;
+extern const SharedPeer X448_Shared_peer;
 
 #endif /* RFC7748_PRECOMPUTED_H */
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RFC7748_X64_H
+#define RFC7748_X64_H
+
+#include "rfc7748_precomputed.h"
+#include "x64_variant.h"
+
+/**
+ * Writes the affine u-coordinates X[i]/Z[i] of four points to out[i],
+ * sharing one inversion; the 4-way AVX2 functions end with it.
+ */
+typedef void (*ToAffine4w)(argKey *out, uint64_t *const X, uint64_t *const Z);
+
+/* Entry points exported by each build of x25519_x64.c and x448_x64.c */
+typedef struct {
+  KeyGen keygen;
+  Shared shared;
+  KeyGenBatch keygen_batch;
+  SharedBatch shared_batch;
+  Precompute precompute;
+  SharedPeer shared_peer;
+  ToAffine4w to_affine_4w;
+  /* KeyGen tables of this build, indexed by Rfc7748Table */
+  const uint64_t *tables[3];
+  size_t table_sizes[3];
+} X64Functions;
+
+extern const X64Functions X25519_x64, X25519_x64_bmi2, X25519_x64_adx;
+extern const X64Functions X448_x64, X448_x64_bmi2, X448_x64_adx;
+
+/* Builds selected by RFC7748_SetImpl */
+extern const X64Functions *x25519_impl_x64, *x448_impl_x64;
+
+/* Precomputation used by the keygen functions (see RFC7748_SetTable) */
+extern Rfc7748Table keygen_table_x64;
+
+#endif /* RFC7748_X64_H */
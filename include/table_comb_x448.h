@@ -0,0 +1,1385 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TABLE_COMB_X448_H
+#define TABLE_COMB_X448_H
+#include <stdint.h>
+
+/* Entry (i,j) is j*2^(32*i)*4B as (x, y, d*x*y); see gen_table_comb.c */
+ALIGN static const uint64_t Table_Comb_X448_18k[14 * 8 * 3 * NUM_WORDS_ELTFP448_X64] = {
+    /*  0,1 */ 0xe2ce42ac48ba7f30, 0x21aee1798949e120,
+               0x01b7bdf1515dd8ba, 0x93fda4be70c74cc3,
+               0x255a09cf4e0891c6, 0x1419a17226f929ea,
+               0x49dcbc5c6c0cce2c,
+               0x32e236f86de51839, 0xb5d444285d0d4f5b,
+               0xc0d8f97ea1ca9472, 0xc90dc3227b8a5bc1,
+               0x9cb7c02f0457d845, 0x164b33a5de021b97,
+               0xd49077e4accde527,
+               0x79aa3dcca72bc254, 0x657868c0edd7ca44,
+               0x69f9a166736e0583, 0xc241d5a3da10c104,
+               0x55672bbca6571bc5, 0x2830dbb5826b18eb,
+               0x16b986789758b764,
+    /*  0,2 */ 0x962538a67153bde0, 0x713e223aca9406b6,
+               0x816a64f9080dc1ad, 0x85dc8b976c4cb47d,
+               0x037c08e2d7bc2856, 0x63fb45d0e66bd97b,
+               0xd1f1bc5520e8a35b,
+               0x454eb873ce69e09b, 0xd89f1663164bc8ee,
+               0x86ad8208f7003ba8, 0x7bd94c7b4b98ead3,
+               0x408c6b38b3a4b93b, 0xe87d1f3574ff46ba,
+               0xc7564f4e9bea9bda,
+               0xf77f1f714f0c4cfe, 0x79ced33b910b3c56,
+               0x0ed043127aeca667, 0x4b9f1668a72daa33,
+               0xaacbcacd703514d4, 0xbad390fc827c460a,
+               0x46f8fc54e87f0eff,
+    /*  0,3 */ 0x8658f07a037dacc4, 0x6d4d8c1e6ff99976,
+               0x57b108db485de913, 0xa1a4bffa38ec916a,
+               0x6e54388d690753ce, 0xa58a17d226879a69,
+               0x20da15621953a323,
+               0xd17e441cc3d41ea7, 0xb42fb94c4febebb2,
+               0xad1da346c255a6c7, 0x23a3fd49d7e2dc4c,
+               0x646321065845849c, 0xff7344560bbe52e7,
+               0x4dd13bba92ca3c03,
+               0x45169228a859fa85, 0xb4f10e0e04e015e2,
+               0x2ab8d75434a06944, 0x7988254cc418ac13,
+               0xa492c3072a4e0ae5, 0xa9174f20bc6bde14,
+               0x597b5e30e1251fab,
+    /*  0,4 */ 0x8fedb5fbc9120262, 0x8c9c6300b41a0776,
+               0xfd74c278d5b37ed6, 0x6f5b419ec49f9eea,
+               0xe8a918066e09d5dd, 0x6e9290104c4f302d,
+               0xdd8402f36c2e9f96,
+               0x0ccde6ec861d7985, 0x58ef53c0ed47ca82,
+               0x46bc0936d4edc831, 0x9a0193724ab99426,
+               0xf0a16acd03fb9c2b, 0x740ab813879afefa,
+               0x1ab2b2d015957671,
+               0xe766dc85a0c24cfe, 0xee72d7cd775d6042,
+               0x403edfcedae581e0, 0x3033c7f0132ff25b,
+               0x21031742910d3c21, 0xf934d28fb3d6aeb5,
+               0x7b4f3f19c3c12ba4,
+    /*  0,5 */ 0xbb8fb8339c0d1216, 0x598c3c2821e18268,
+               0x3b9e1e012d021072, 0xc1e552020f2a56fe,
+               0xe4ed89e262d0de3e, 0x6763defcc1503737,
+               0x3c236422354600fe,
+               0x17020b219b4396e1, 0xbb38fb9c3e612310,
+               0x46f91c688fa42402, 0x40844f04cab39fd9,
+               0x2781e69eca88e1b0, 0x05fc466de4c74d3d,
+               0xb555b9721f630ccb,
+               0x17de38b15945a2c9, 0x39a8dca3359a51b2,
+               0x92e4aedbd78446ef, 0x2e30fe952cf06aa1,
+               0xc1b27e772018c5d5, 0xe9416b76d80b9c7b,
+               0x5041b2c3902cda76,
+    /*  0,6 */ 0x3d47a640b650f1d4, 0xf38bdf9c45ffec3b,
+               0x5b34a96d22ad0697, 0xbadc9bb76859e374,
+               0x4d990ace3eb99e35, 0xedc9f362f519a67d,
+               0x9c65f3f85fefea45,
+               0x7b7fbed375174de1, 0xd3ed56967283e41c,
+               0x8e7f6487b82ecfd3, 0x1fc74ea22e392750,
+               0x5730f01602892a03, 0xe0d9a2f4a1bcbe2a,
+               0xb0da219cab83670c,
+               0x14829b1a6bb967dc, 0xf0854e2d1d35ccc8,
+               0xfccefe4e351d330d, 0x5b5166e830fc622a,
+               0x2a87d1a39af98e3f, 0x8a55096611bee0c6,
+               0x777f313ddb2e38b2,
+    /*  0,7 */ 0xb32203717e119a9b, 0xdf56ef05e6f727dd,
+               0x62c6dc6f0ece59cb, 0x7a15811e5c5c28d1,
+               0xee5bf29a9bb2e52f, 0x53e74acb14787561,
+               0xae091aab77f395b4,
+               0x850772578eaf94fa, 0x681b5a446700deed,
+               0x6969c14155e09989, 0xb08b436d87de84dd,
+               0x2c4688635ac432a3, 0xa49b82c28a4270f0,
+               0x5b2c508c359e9fa5,
+               0xdf764235251625d3, 0x558c7e6521b8bc37,
+               0x29c22365fd8df56b, 0xbb74444e53ef9d6d,
+               0x41ee903b34334bf3, 0x06971393013f4c75,
+               0x4efd2ce4005fa15e,
+    /*  0,8 */ 0x75c5b004f069d31a, 0x3c3d28766d1716c6,
+               0x0d90c8f560809dc4, 0x9b0e0743dcb5b303,
+               0x4408125612abf7fb, 0x717909b541986de7,
+               0x745d3d448b2289b6,
+               0x8834c327b3aa95c8, 0x7a90e8b549b5ad17,
+               0x4393307152d42927, 0xd2132166c5c51fef,
+               0xbc0b0d92d2ebbf37, 0x9625d85956b7099d,
+               0x59dd6be767914ab1,
+               0xdb6be4bb671a4c5c, 0xc00324c265b5bd17,
+               0xd47f71043d3b0192, 0xa91bdce6e8f0a264,
+               0xd2ec490107ad4bea, 0x8e4ef072ee5e0dc0,
+               0x41c702ebdba2ff15,
+    /*  1,1 */ 0x1f0a8498945d5a19, 0xc35d47ab39c6c213,
+               0xee81275c02824f3f, 0x7c90b80a3be77c89,
+               0x631a28aa93a8491b, 0xd6e816c0b3445397,
+               0x22878be876d0e454,
+               0xa3eecb8a46db3bf6, 0x0f85340f29554577,
+               0xbb9147a7798689a0, 0xdda3c73698465d74,
+               0x4f17504b209532d7, 0x356f4d86e4356d57,
+               0x70c2e8d45338876e,
+               0xa23101886ab48263, 0xba6e764806997929,
+               0xfd26af6ed0245d3c, 0x1419957f05d02244,
+               0x2de66005987b2f87, 0x03905e1a5dcc9e50,
+               0xe5f63f5b3e4735e4,
+    /*  1,2 */ 0xbe51857164010f4e, 0xd663e0b144b0536e,
+               0xdf584facabb14887, 0xfaf175a3ac1caede,
+               0x6d5f992a3cb43fb8, 0xc4aa285178a4310b,
+               0x69c99698bd56bff2,
+               0x0373d6372a4d972e, 0x15813d5bb2e95838,
+               0x68a34a7bf7d18d89, 0x31f45c81a5ce5d75,
+               0x5a71f96910670b43, 0x14eb3b07c1ea9726,
+               0xdf008eafed447cdb,
+               0xac6817d445b03506, 0xd85fe4e3377f50bf,
+               0x7dda87afa4f110d4, 0x87c752db45d65874,
+               0x505567eb3ff3fa99, 0x267f050c19e7cba3,
+               0xb220fb7cb36d3098,
+    /*  1,3 */ 0xed178acfcd3fdf7d, 0x98d7af993fb7b350,
+               0x81bb9f30bb56ca70, 0xb06cdc81a856f7e4,
+               0x99c9d330689e53bb, 0xd8c964bdc8a08b9c,
+               0x8c2d5fc80682b92a,
+               0xec809636e225a881, 0x48231709eacf2833,
+               0x0674152a51e957b9, 0x8e14e86e4fe9eff5,
+               0xf0f65b6cb028614a, 0x77911ab248e58eda,
+               0x29630abeab5794c7,
+               0xab9dd35652cb7dee, 0x28a35cd2451ab6b1,
+               0xc417c39d61e807fd, 0x64016001f2a6cb00,
+               0x28650b062a272225, 0x31ef5cee313caed1,
+               0x5af6a54619522666,
+    /*  1,4 */ 0xba962bc81facb83c, 0xd3b814e829549938,
+               0x24c36ffc7a6a7f52, 0x0ca54884725a29bb,
+               0xb23b00b13238c85c, 0x9c70fe0bf571c5c9,
+               0x344319a9e77578fd,
+               0xbb390375a9589064, 0x9f4bb5f73b7abbf9,
+               0x2f7c11108256abbb, 0x083e515f9128cf81,
+               0x331a7e3f7a9024bd, 0x76466f67a9bb1aa9,
+               0x030a9342932358b2,
+               0x10c80cc0a0f3ab6e, 0xcff4d4e29b346168,
+               0x603c487aead60062, 0x1f31df2ff4b4a63a,
+               0xc622e9f877b9fa26, 0x49f06bb49e3568c2,
+               0x86850942604295f5,
+    /*  1,5 */ 0x4a8b7293ab32d519, 0x12ea32d40d2c4b3b,
+               0xbb942a5be6395039, 0xa23881d1136b1158,
+               0x17e6ecc7f72400ee, 0x1c02399c72aea483,
+               0xc4e0319349509478,
+               0x2dbfd03b2c9f4c9e, 0x1e588e76e83ea417,
+               0x94eaf6c771dca3e1, 0x994529a793668040,
+               0x331fd0781d4e6e8d, 0x62f2806a1b323200,
+               0xa1df946782003de8,
+               0x23bd9630f867fff6, 0x0889e91266a0ae79,
+               0x3b9277d7bdbcb733, 0x3de13e9dde0952be,
+               0x87baca1b118443eb, 0x2ba9ae1a1b877a59,
+               0xad1c5ddac7a8f463,
+    /*  1,6 */ 0xe1e3a86ff99f3ca3, 0xa3b9eed9f413f635,
+               0x5742d87fc6c31fab, 0xb34bfc6042c23fb6,
+               0x42d6ce2a5a0dd182, 0x5856f4405b3f0b63,
+               0x859622e937542d86,
+               0xc41bbc35ba403aba, 0xb6b211f4dcc9221a,
+               0x5af0a366a2d208ec, 0xb123e28b87589c7b,
+               0x1334d6eb5c992886, 0x22eb7c34b7b40876,
+               0x118c200e9cf26a2d,
+               0xd020a4357a85711f, 0xfedad97fb6a6291c,
+               0x48ef5b12b7b4ab49, 0x70ad290aa02de91e,
+               0xc220f0f5256384b4, 0x4bdd55e568846631,
+               0xbf4f6d3f555ca873,
+    /*  1,7 */ 0x5ab2a3aab537236d, 0x69bd8389f339ea24,
+               0xb38f05b45f70d533, 0xc1c1df825f01c5ef,
+               0xff64a48dbc0adc48, 0x4d4820ac60cba52c,
+               0xee205bc590e7b57b,
+               0x6ed8cae74d069e07, 0x62033e638a2a0416,
+               0x2add9d38d09af8bf, 0x8452eebe598fb198,
+               0x9ee21bbbfe2bd048, 0xbf514694490dc67a,
+               0xf2f984bb8ecb30ea,
+               0xfa30ee26f9720371, 0xcb9bdc7ae0dd6b58,
+               0xdc4678226563553c, 0xc78c5ff42a9d4003,
+               0x9c7edeeb3e3fd536, 0xffe646ee9775b481,
+               0xa2bdc027c02c895f,
+    /*  1,8 */ 0xca2930ae53de12ad, 0x208ff3235e4d8299,
+               0xdbbdb36a7660b92f, 0x2050427b0bce9087,
+               0xd21e838d18dabf65, 0xfe71091e624cf3f2,
+               0xd53cccd83f474e4b,
+               0x8a37476e266fc4d2, 0x2704424b28231cb3,
+               0x4a656f9ca41408a5, 0x0d65568f1e86d775,
+               0x6829a3c31c909b57, 0x3a71b9757a0f26b0,
+               0xf33a2d857405abb8,
+               0x2f00462f3238f672, 0x68b2f7f6c8186777,
+               0xb5f1a3c41240c8ab, 0xed9d883dac31dd82,
+               0x3a4aec7ea6eb7f90, 0xed48383751714c43,
+               0x5103358dd1be30e8,
+    /*  2,1 */ 0xc1f68f15fac38939, 0xf141b3dd5a2f8010,
+               0x388574f7ac290a35, 0x1e95fed2dc8f3b27,
+               0x451257ac7d7ec3de, 0xfc33e664e55ac625,
+               0xd3968d34832ba566,
+               0xa5980291bc026448, 0xa360fcb212524da4,
+               0x5ca63bbca7df4827, 0xc8e9f733fcc395c8,
+               0xe9bd465f70cf566e, 0x6d111372f916835e,
+               0xc066cf904d9211e6,
+               0x79b8cefbdcf9291b, 0x3561977005c2d3f0,
+               0x48b273b35ceeb5ab, 0x7eeacb0ce2133de4,
+               0xae4faa7c5136d158, 0x7b844fc8b43a0d24,
+               0x1b4883c0bf408dd4,
+    /*  2,2 */ 0xf442009a6264ad0c, 0xe8b113bf2b8593be,
+               0xf7bddc1d111905d4, 0x5624e62cfe3e940e,
+               0x9241d6d3cca01227, 0xbcc70edb7ab6cb65,
+               0xff9fafbb750b1cc7,
+               0x02f65df297fea84b, 0xe82117c84a890b0e,
+               0xb480d1a92a859301, 0xc59c604ebee8cb2f,
+               0x3f4e803c437010b8, 0x4514247b3fff47bf,
+               0xc4c5dcb9f0da13d6,
+               0x1732bbf1155d37c8, 0x6348f4f9f0ffc28f,
+               0x6b36d2783e5fd861, 0xd9c84782a72ff5ac,
+               0x967f569e2dce9a6c, 0xe32ecbe118c1214a,
+               0x69247e764c4469d0,
+    /*  2,3 */ 0xa7ab4fbed345936f, 0xcbf72f0ca0748f71,
+               0x2b24bb8389d75b2c, 0x05748f37696826d9,
+               0xdc0907d2894c9239, 0xdfdc8183db6e5215,
+               0x635044300e852d34,
+               0x9bdfb1d5a9b35fe5, 0x534f2cc68a30648c,
+               0x9b07259343db6d63, 0xcf9d9a644ed41b6c,
+               0xf40c2d74a958c184, 0x0812db34d7e91dd2,
+               0x2326a7e4349bd2ea,
+               0x0ea3cead7d9581bf, 0xf2f59aae22cd5751,
+               0xc9101655a381dc07, 0xc380439e4e2b746b,
+               0x5de14dc7fa14f37e, 0xa34e09a5de0ba6b2,
+               0x6494e19cd38dab88,
+    /*  2,4 */ 0xbc074e4197ede546, 0xe20c0a8277f47102,
+               0x6cb2aa9fcb51008b, 0xe064c314cfb697d2,
+               0xbdc5c5a87efdac37, 0xe99da36ffc35d602,
+               0xa9a23458d1ce8be5,
+               0x151fe98193767553, 0xcc126f3727b26e2c,
+               0xffb93467ca87111e, 0xf302a2b3936170d4,
+               0xacd1197c8fb97eab, 0x51fe7dafa69310ab,
+               0x7ee451b41a8d15df,
+               0xfc3e84aec3f9de9f, 0x03e92b88c81b6efe,
+               0xf64208651024cbb4, 0x7bf7f1d866a55e96,
+               0xe22d98dcba5e79da, 0x200e5642a5d6bfd6,
+               0xfeedf75306bd3d8a,
+    /*  2,5 */ 0x36734e0490974e3d, 0xef0104a9a8d713a1,
+               0x18cc13424dba42de, 0x7e8269007f05a865,
+               0x0c194a0d0e8e95ec, 0x967ccaa64d4c82d4,
+               0xe5937404f4e37a62,
+               0x4f88f102fd79a497, 0x00f98c3023b6977e,
+               0xb935e22acf9338a6, 0x6cc7dee2789ca731,
+               0x32b3d882184ed761, 0x09448b4a790eb654,
+               0x52c9efd0cf998e93,
+               0xb54703a0048600c6, 0xad79227b8000a58a,
+               0xbbc612463598417d, 0xa120c2d308324de6,
+               0xb5016c329ea34b12, 0x475cc4a07bdc3cbf,
+               0xf98f08213ad4f0b0,
+    /*  2,6 */ 0xc4c6d3d10ea63ccd, 0xa78002132cdd7ba4,
+               0x3b383e96955dcffb, 0x61e1c7da08358818,
+               0x8b8c506b8a6f9a40, 0xa3e9e058d7c9b8fe,
+               0x9114782f0878d05a,
+               0x0c0eeb708a7a025d, 0x376990949f1e8ada,
+               0x67365094f5fa4606, 0x536eacc14e106adf,
+               0xc38d2205b55619a9, 0x0199213477f979d4,
+               0x547658780c4764fe,
+               0x2df75a444c60e782, 0x0863fd8b401fad94,
+               0xb45c13c833c7488b, 0xae0faef81f8a172c,
+               0x5afe4e3612380c47, 0x76007acd54f1d03f,
+               0x3e6145ff431ca12f,
+    /*  2,7 */ 0x60c2cbbfd9ff4c31, 0x6f34b340951cb770,
+               0x5c3cb48dd1333a6b, 0xc4dec0103c974c71,
+               0xfd82e194bbd78f9d, 0xc11a5c9dc313d502,
+               0xdcef076919d0d62a,
+               0x6362a4a32fb493a6, 0x5aa2384abb4ea262,
+               0x806aee98b9376605, 0x39afb21a5838fdbc,
+               0x254f2988e7dcca33, 0x67a00fa5fd776f17,
+               0x6e75577ed988a4f6,
+               0x310f5584bb0a8cb0, 0xa4b5e80bfcaff62c,
+               0xbce67b36880c8c76, 0x3675b83f64424a95,
+               0x699afcfd6b870724, 0x46ecbf2a5c812e9c,
+               0xc82008b66187ab00,
+    /*  2,8 */ 0x5542b4f3131c4454, 0xdcef0a215adb9759,
+               0x80fc4cd414c5378f, 0x547e434afb9d4500,
+               0x1051551d7da20b19, 0x0d75425c9048e214,
+               0xaac2eadade4fbae7,
+               0x2322c82e094eacda, 0xdc0e2684d7ee4d42,
+               0xf1472de8aec8bce0, 0xb78b1e3aa86e2f78,
+               0x76718d928bc7c7d3, 0x25af5b532898db8b,
+               0x5d912c6880ed721f,
+               0xdb50436f4ca73d13, 0x5b497775946c557a,
+               0x59d2a02383e58055, 0x010bd78f493fbf1e,
+               0xc1cc94c17e22b313, 0x56398f2f5b6f2fe5,
+               0x4ef50b4439bdf696,
+    /*  3,1 */ 0xbae566ff8a450e77, 0xdc90b0b40066a13a,
+               0xfa9ccc483a510cd7, 0x1a80e67cb1a20135,
+               0xe1f020801aeb0b63, 0x57dc8f4e447c7c34,
+               0x7abe7d174c6f0f02,
+               0x0ef115a3ab19a576, 0xf99b8f0474a064ca,
+               0x73edc3999bb6b351, 0xf427d717855254b7,
+               0x2532e0cef249f6c2, 0xe126c2ee34f59f68,
+               0x1ec2cae80150f71f,
+               0xbd23bf6de3dfcbfb, 0x65c985ef628b4a43,
+               0x6458bd6779bd2d1c, 0x9e26bb72ecd1262a,
+               0x8369499219e64ea2, 0x9da45186f0166416,
+               0xf3e282efc09aa5d6,
+    /*  3,2 */ 0x7582ab83570a54ad, 0x556b5c1dee8e3bec,
+               0x461e60f583ff454b, 0x887fc4e79220199f,
+               0xfd20776daddf61ca, 0xc6edd8edd0616641,
+               0xaf9b14255f7e8700,
+               0xfa73f15e49bbe3ec, 0xff86dd3b788f8bc1,
+               0x1be58bb24cc071b8, 0x36b10ada6c260d24,
+               0x2097fdb985ec1c4e, 0x0ac85d47c212f6b4,
+               0x967191c07d78d10d,
+               0xadc6d33fbb759a6b, 0x9a3d0a14ff0392bc,
+               0x1d7a11f73290923a, 0xbc39a3f39216b067,
+               0x8d52fb70ee2b9286, 0x35bf30c44b418124,
+               0xc91ffe14f5f85b83,
+    /*  3,3 */ 0x420849d8f5d7ce29, 0xde0834b10717176d,
+               0x9eb1415188ad431a, 0xade44d6a1dd95a4a,
+               0x06cb56cfbc4fbb98, 0x134db77a57522ddf,
+               0xa1573ae9faf485f6,
+               0x6f67d1c11d83ccf6, 0x82df3adfd22dfdf9,
+               0x630d8c46aa5615a2, 0x3505bfd3b9c1f2d8,
+               0x9471036d2684763b, 0x8cc6b74ed0e582d9,
+               0x6f13c97e49f14cb6,
+               0xdd2f9ec6ebab1b69, 0x2e524f244b8ba23a,
+               0x4f5db6608cc908ce, 0xfab323213cf9fc68,
+               0x6f8c3bb78e5020c8, 0xfc310b894ee6b7bd,
+               0xcd88e86d39c7c581,
+    /*  3,4 */ 0x61194d260c90ca66, 0xa8acc8d1b6d5b0a7,
+               0x26e9b1796f7c6fd7, 0x476d7c4f1f8c7a5d,
+               0x283c26686d61a4c9, 0x0abdc254353555ef,
+               0x3cf8d5d1d6ab314c,
+               0xa4b54716c8bf658e, 0x07c1239895467708,
+               0x1a14360773655b77, 0x1169090c6fdbbd16,
+               0x53f02abeeca0ca60, 0xaa20111da4d05b32,
+               0x697aaa3ba416539e,
+               0xe10005a2a641cb6a, 0xa9248e666226df70,
+               0x6d7e2dee5198d3ef, 0x75e2257e514f00e3,
+               0xa450afd78f6a1d1e, 0x141ddf5c1904d236,
+               0xb1080a3ebc2bbe1c,
+    /*  3,5 */ 0x657b9cb572719833, 0x7e0732b4b9c134fb,
+               0x44c1ebc5d51691a0, 0x296381c719df2fa3,
+               0xf6baeaf97a966a1f, 0xad6be2600631b37b,
+               0xb760437afed2baa1,
+               0x6cde62e9e31ff0e6, 0xba0553796d5fb189,
+               0x9039b4a363388c91, 0xcfffedfd9b6926b4,
+               0xe55e78d64e7bbc64, 0x4584b5f7d96019ae,
+               0xd92be93b1f6ac94f,
+               0x3fb144aa32c2fc68, 0xc185273ad03744a4,
+               0x51aa1247bb3596a7, 0x3b5903f779aa8417,
+               0x212434706ad138b0, 0x7b4c36fa2f1b9428,
+               0x0e087f69947d5205,
+    /*  3,6 */ 0x374795c35bd4ef94, 0x627bfe90848bd43d,
+               0x415898f021ef8c4f, 0xda3a9248f3d1810a,
+               0xf974dac5cc303d7e, 0x6d29ff95e9646b1f,
+               0xec6acecd39b91fe0,
+               0x66438611629fecbf, 0xd6c2abafed23cab8,
+               0x1fbd8020dcdc2966, 0xec73e127e73ea3d8,
+               0xac9493f6c7e57803, 0x779fe53496003b43,
+               0x8eddcd3f4e72dfa1,
+               0xfc56c908258a490e, 0x80d82a622868bf8a,
+               0x06877377168b2542, 0x1e88491f6ee4e749,
+               0x204a365b7992a09a, 0x5c1d36a30a12f7e6,
+               0x73ddd9a9fe951925,
+    /*  3,7 */ 0x401402660d724c13, 0x20af27c95a124a6c,
+               0xb1072abdef64d84c, 0xaf594c070d6c93f4,
+               0x1165d04c054dcbd7, 0x47890c1f604e4923,
+               0xb8c06b1ae119b57f,
+               0x7b7813ccfcf12970, 0x718e9e893b53fe04,
+               0x11961fcacdd1f088, 0xc68946c3eb92f80f,
+               0x422e3da0af7dda2b, 0x8a00b0d0c9937489,
+               0xff52a83312fad363,
+               0x8f59dd7f5d074bf2, 0x4803ba7dab1ebd6a,
+               0xaa4eff2b758c241b, 0xbfccacaa308d41ca,
+               0x9ca2ad2155978eeb, 0x53f58669dfdd3a19,
+               0x441e973c5ba294f8,
+    /*  3,8 */ 0x1c3abd36c47c6a6d, 0x086eb802b6d5e60e,
+               0x67d0d7dc13683216, 0xa6345d461da1d2b0,
+               0x37e48dd7605b8fe9, 0xaab02ca9fd0e042a,
+               0xc7edb99e6a0a2c1a,
+               0x91afddb6e6c205d2, 0x0931cdde1c7ab6ea,
+               0xa2b743a4ef53d6ad, 0x8221df1f648ba4d8,
+               0x0a1cdd9358408bdd, 0xf01f950c5b65b36d,
+               0x4792b128ba81263b,
+               0xdd1e781c4174137b, 0x918f52327bfe9038,
+               0x712af79f05741ca1, 0xd576eb25cb5626d1,
+               0x17d6b57b22914e1e, 0x3e5285a91fd2aa3d,
+               0x18eb62b441376327,
+    /*  4,1 */ 0xeee44c65b219379e, 0xc6db211381bbb607,
+               0x76a2e8d4c7428b7b, 0x98bb0b31ba62a03b,
+               0xb50c6bbc10e1729c, 0x66727b0187aa3cae,
+               0xbf9d2f0fb90dcf6c,
+               0xb5ec693501184dc6, 0x6b07d58d2a32698e,
+               0x51c017b366d8da31, 0x9adb157fe1e39bb2,
+               0xa9a8a8b06cbe44ba, 0xf46356e473e1baa9,
+               0xd25a8f61d681c6d0,
+               0xbbfc73483fbd7400, 0x9468376e0273c80f,
+               0xb4d8f0f0d2c33b12, 0xbb471949ae2b0bf7,
+               0xcf2fe033df509d50, 0x5a679e46decaa43b,
+               0x7d2f1eb80cd4072c,
+    /*  4,2 */ 0x074b22c3b562a5ed, 0x0648711216f5c7cd,
+               0xde9e6f51f72c49ba, 0xbfda63bac10d0930,
+               0xa55af532b0aca479, 0x59eb77236f394722,
+               0x5cad8744465c348d,
+               0xa4a2119e5722b0c1, 0xf387b670264f343e,
+               0x381fba6910f02c19, 0xd52c0a1dcfec5bc0,
+               0x4d56378cb65f5de0, 0xc802727e2ba34e47,
+               0xa215da3159b5412f,
+               0xe3261c7ffc9fb84a, 0x0a8626df8cbea55c,
+               0xda49c12087eec9be, 0x2503b92a58c389ad,
+               0x0bb0f6b773c4e007, 0x6a3b8eca0535361b,
+               0x3b3d273878399338,
+    /*  4,3 */ 0xd294a29849f370e4, 0xe3733f461f86d67b,
+               0x46130f20a8956843, 0xc87dd3c67a6ae2eb,
+               0x0ea86846dbc53aba, 0xabff3f960664094d,
+               0x2e068f4db7274ee3,
+               0xdc930c13742aaa7c, 0x946da48adba89862,
+               0x8033097a68419aae, 0xc04f3b22661458ec,
+               0x175eada40b7e3adc, 0xb95127a73fb2951c,
+               0x8c622aa7cbc7c03f,
+               0xdc080423dbdea0f0, 0x30f5cb112871bc5b,
+               0x17d4b7e8e4b80da7, 0x76ad74251ac684e7,
+               0x9b1316595679e56d, 0x287376cdd2ad7962,
+               0x66f4f462559d9599,
+    /*  4,4 */ 0x5982b07d3d0f2f50, 0x975478e80a985309,
+               0xbc18dbca907d4098, 0x6eb34087c2c6c38b,
+               0x9d806184204fb3b6, 0x5fa7bfc08b086e16,
+               0x8064be6d2381ac0f,
+               0x94a374d9468b6318, 0xcde2678096b083a1,
+               0x1c348bc2a28540a3, 0x4c24f778c2ca3026,
+               0xe16651a3b97124ec, 0x7bfd75b873980cd5,
+               0x6bbdfcfeb1ac0c35,
+               0xd98d78f118a46f5f, 0x23042ce1ec559c72,
+               0x474b7a1cbf285af6, 0x680c33d1ed996aee,
+               0x6537d674580c092b, 0xd5b9ffab3658bc48,
+               0x6e1b5673222fe819,
+    /*  4,5 */ 0x3d9d3d16904c8e48, 0x2546b3d9ba3ce39b,
+               0xc993f0b33792db5b, 0x5840420a4604a3fa,
+               0x27d3607b18ced670, 0xd4a7e8bd95074d5c,
+               0xd9bded4ea8983621,
+               0x66fd23244ae8bd2b, 0x9dd682a543401be5,
+               0x6a5d6d6b7ddb3dd1, 0xc87108d1641c6d93,
+               0x2fbc8649c4243626, 0x2951d280bd7679fa,
+               0xb73f3b70b0f45aa3,
+               0x5ab8e279e52a1647, 0x9e15e64226f9eacb,
+               0x1a4dcbd32060fd17, 0x5ba9dddfbdf43176,
+               0xb172e46e8c427ba9, 0xb33bb1e560dcc757,
+               0xa991b2ca3ff46fa7,
+    /*  4,6 */ 0xa8c02960fb42e1fc, 0xcb6ed7bea1486ec1,
+               0xc27089ea00592376, 0x1e0fb2ba431138ac,
+               0x83cf977d84edb9a1, 0x9d85c09ce4475fb5,
+               0x1ee482243e66b4da,
+               0xf3eb799032bdabc1, 0x936590f68b6d39a6,
+               0x91e294f12c824d49, 0x001cb3ae8c4b7bf2,
+               0x1269fe87af930d71, 0x6a9b7ccfe6f0f2e0,
+               0xdbf4f0271635a237,
+               0x17729956219367d1, 0x6c90bd3edd8acd21,
+               0xf2bb46e3ac2eb745, 0x231dbf7fb22e8580,
+               0x1cdfee0c9cb6b68f, 0x83a6228296e3f02a,
+               0xd9027a2bada50521,
+    /*  4,7 */ 0x555755c3cd6ee3d0, 0x302be7d15a8fdf44,
+               0x29e314c8748a429d, 0x23b801e2519eb387,
+               0x408065cf2a1f1b1d, 0x815d483e690dd806,
+               0xed305ef7989bbdec,
+               0x66705322d9d2a729, 0xcd1de5630b3ff229,
+               0xf63f7ef3819e9b7a, 0x57cb8d0fdb4467d5,
+               0x6cefc23b85f213e0, 0x7d190d40beff2f17,
+               0x0d78eb59337c05cd,
+               0xb02b5d2d7d2047bd, 0xbceb9f1e528e379f,
+               0x71e2b2b205d70e04, 0xecf7b87d5445eb3f,
+               0xc1a06e34bcdc7694, 0xae23b25d1ad09f45,
+               0x48b69483ae588929,
+    /*  4,8 */ 0x3c1a44af03d3d9d6, 0xcea87b7cd1bc4264,
+               0xda47f4d628f505be, 0x8785ce0110a6d148,
+               0x76db0375c0e72cba, 0xa6d25e1122862cfd,
+               0x4d75b91d28f58921,
+               0x665ae45ba11b5c5c, 0x91ff801517ab54d2,
+               0xcaf65dfab1160c68, 0x57db671da588fc92,
+               0x0f9f09d872a5cb2b, 0x6a785e689fc2c0a4,
+               0xf7406f0446e39c40,
+               0xca58282d1fa57528, 0x1f0dc04d9861d3d3,
+               0x1c22d56f60f08251, 0x9f3d9b2e2da1bad7,
+               0xcd8911ca0967eba6, 0x352d8a15ff1af192,
+               0x921a4a3898212078,
+    /*  5,1 */ 0x97230baa1788fdab, 0x4caaf30860a7d045,
+               0xad065ea2c7ece99f, 0xd3bef7bdbd39f106,
+               0xfad96d2203fd92f5, 0xf38cac4d9e0d6069,
+               0x419a0171fda313bf,
+               0x405d77fd8572f035, 0xacff5af99f2b282b,
+               0x8c90af7257d3b23f, 0xd9b6a52af2ee2235,
+               0x92c302430ecc2687, 0x34d5e3ec4f381408,
+               0xc087d7c3bd18bea9,
+               0xcb61e5ae83b2a82b, 0x1cefc0da2300ccfb,
+               0x2a2d90b6baad6b3f, 0xdc95851fae8fd280,
+               0x9ebc22e161964042, 0x4fa4f03688988b1c,
+               0xd48744ee46cf2125,
+    /*  5,2 */ 0x9ae116a96569f191, 0xdbabb3f0bce4d6e2,
+               0x46d27630b9e1af51, 0x30749a271dd36f33,
+               0x148ab47f70831510, 0xa5bcf5585681242f,
+               0x8b801845ed79bae8,
+               0xc6a4042fd3894ad1, 0xc39782f781d2b88b,
+               0xd99c9f2d34cacbe4, 0x8ef1d3828731aead,
+               0x2e1dd0bbc90f9549, 0x889e954064e8caba,
+               0x8cd9c9761a8ab978,
+               0x0f603dbcea066cce, 0x0fcb3f958c2f9e0a,
+               0x08716d048db635a4, 0xb8a63e6bb4ab032b,
+               0x8d1825bff6c6b7f2, 0xfd12ef69e8dbaf7e,
+               0x58a499a07eba1b86,
+    /*  5,3 */ 0x4f1600155a02885e, 0x25d67e54a15fd9b0,
+               0x96845b5cf4eddc96, 0x8761ff6281220c68,
+               0x821824b44783c647, 0x4f64145b27687985,
+               0x0bf34e94cfdc7a5f,
+               0xba955f9fe2e558ac, 0x67572cbff0a526b7,
+               0xfc12fdd4fdcb66d1, 0x187bdd5e326fc821,
+               0x6d244efe9cf96dbe, 0xb69b324b9e7f3680,
+               0x3d174eb59f6c97de,
+               0x0f3922f598e974e9, 0x617c4532b6b64b25,
+               0x6768d22ba299d675, 0xb798dd3dc1641dbf,
+               0xfb1422a0bf1a3adb, 0x7738e129b499af19,
+               0x4286b89984a47d8b,
+    /*  5,4 */ 0x229f6781bf0de5bd, 0x9998b72a38445e89,
+               0x2a34cbcb0ddd2f0e, 0x09ab6a8287febb83,
+               0x9e89b97adae48e17, 0xb22eb12c0d457bf8,
+               0x547e66093a79833a,
+               0xa7aaf7a9b5800209, 0xcbe5cffd9fbdb400,
+               0x5218537f6dca239e, 0xb3a5925a679e7391,
+               0x2a42bf09bd96f555, 0x3c0424e2ceb92e73,
+               0x1ca9937215e8623e,
+               0x04dc8fbe536c9de2, 0xfd24045bf184d9dc,
+               0x2c37b20faa610261, 0x74c47a95a7e93b23,
+               0x9c598799dcc256a8, 0x2f06f7f0d2b3ec7f,
+               0x4b539c749e5dc18d,
+    /*  5,5 */ 0x21c22d6a9aa714b3, 0x32eb2043afd483bb,
+               0x1c2bd746ed768bd2, 0xa0403192fa998183,
+               0x2003cfddf8a7c9c0, 0x8413c197230ee4ce,
+               0xa08187deb9bd2b34,
+               0x772134255ee9211a, 0xd95d986a98c29ea2,
+               0xab812485f3f5470a, 0xae1ff1de8052514b,
+               0x0815808b19b68e11, 0x85af3afe9e9d360c,
+               0xf2873fcf922ad8d6,
+               0x9e378c5a18c56223, 0xeb96de6a22e293fb,
+               0x6dd33babcec01650, 0xea2ddd208dea8a9b,
+               0x56cc47fd9b70f170, 0x2f08805825f9e359,
+               0x5ddb60e4467e4d01,
+    /*  5,6 */ 0xec28be8fd06a8cfd, 0x0e31fc7fa01ec425,
+               0xf385542941973e20, 0xf742d2b5c8fe93c5,
+               0x8065c258933076a6, 0x6ae493c704f0c114,
+               0xa175f6c02fd78a6a,
+               0x88d30f22bb99348d, 0x15ad4465d12a09b8,
+               0x5195d36856af8e46, 0x9b4c75325ed7b947,
+               0x18223924297ecc94, 0xf17ef73a18664d19,
+               0x30a735dc0d6da3f0,
+               0x24577d878e96a9fd, 0x7fd367bc079a91b5,
+               0x8443831488e7bee4, 0x8766d7bef58bb6af,
+               0x028c0c76c251fecc, 0x9b68a2dcfc284b75,
+               0x56d45ff1f53b8834,
+    /*  5,7 */ 0x8863183458ebc95e, 0x37c869a6365806ff,
+               0xe5a4a34f59f78da5, 0x486768f7be118fde,
+               0xd9d29c0e5fd86a7d, 0xc5d72ad8c5dc11c3,
+               0x18a4dd945e05bc5b,
+               0x6e81f026d7f030b2, 0xd2db8e42ce749f94,
+               0x990ea7cc7e7a9254, 0x250c30fb6aa8fecd,
+               0x1ae2280f804d2c5d, 0x4a6c16fc0e7f94c5,
+               0xbfc944ae4f049ca6,
+               0x8925b52a641c8942, 0xf0babc2642702709,
+               0x72c8d8c0290c5542, 0x48647aabddf6088b,
+               0x71ce79257e1b4c84, 0xda7128035a0bd616,
+               0x792bdcafe17b04c3,
+    /*  5,8 */ 0xe9cec8554c64cc37, 0x32e4d67c79d1b92d,
+               0x8bd269d566f0d66a, 0xf130bc4709f5c0f7,
+               0xe485ff5dbd1167ca, 0x7f4f518381fcb705,
+               0xd5100fdf1591e4dd,
+               0x67263ba9e93271d4, 0xa6f9d87d107823a4,
+               0x2f8f6799d12a6c05, 0x889fa79477d25d30,
+               0x4f22b602827e5a19, 0x716bd72174c9475c,
+               0xd6ed33b82349150b,
+               0x12499e893de27a7d, 0x45bd5438007f4006,
+               0x5eb5f1bd7dc10413, 0x44d7f1055a0ea64c,
+               0x0efb48b0dd7751c9, 0x5c6f378c0382d312,
+               0x50a59ffd2184809a,
+    /*  6,1 */ 0x341098163cb7d458, 0xf72c12b645ff5ba8,
+               0x32e5dd70a318128a, 0x510a21b45f4727ef,
+               0xf8067853897cbae1, 0x27402b8f93b7a80b,
+               0xe385f8208349da98,
+               0x912d054619589f6e, 0x574d6aa5b26e7c01,
+               0x148e61e79ae12bd5, 0xf13716ff5d13f914,
+               0xfe680bb81f7b2be0, 0x7633c3e2569c82b0,
+               0x6c1f083873f8b369,
+               0xc97102e5b2e48d1b, 0x89416f93f7fb103b,
+               0x86ed0b4829eaedf0, 0xc6fb0cf98678f3f8,
+               0xcaf98f59ab202690, 0xfa7fc77a9057a658,
+               0xb1b9abf115bdc9ef,
+    /*  6,2 */ 0x122c9637e48bf5a4, 0x20239fdec19ccaf1,
+               0x78f0cce5cde9d5c4, 0x21fe6eba98696208,
+               0xec854e678bcf970a, 0x67f0128d00dd1df5,
+               0xfa7260db0b3fa846,
+               0x0d6bd2895b34239b, 0x23e204c8bc52d2a5,
+               0xa278d514e55ef6cb, 0x321930466440c273,
+               0xf645dd4c08f4b12e, 0xe29984656e8c46ad,
+               0xe7b36eae4acd4470,
+               0x570540b4af83f6c0, 0x2a2dcc72bd7a4c6c,
+               0xbbc2f5fc9d6b6dac, 0x91532668b3e01e1e,
+               0x6dbe80fc7c3e6e1c, 0xcccc8cc3f7053043,
+               0x8eaeeded822afb35,
+    /*  6,3 */ 0x5bd8b78d57cddca7, 0x81e441ea6d52dbed,
+               0x656aba1631c9629a, 0x62c8bcc9250c035c,
+               0x6f05d54d507176f4, 0x1bb2475edc08130c,
+               0xebc8f3546eb9a28d,
+               0x17930331e8cedcad, 0xd5c56172d3f44bfe,
+               0x85cb4d2044a8b607, 0x6c9877395ffcfde3,
+               0x59b8025185596813, 0x103d61e688df5915,
+               0xf061801981138bde,
+               0x8783b26ad5a73e64, 0xf5fc4b4154583a32,
+               0x0a8e693a698cd554, 0x7747c2dbebe65adc,
+               0xf1c39c658e848ef9, 0x10e1654c5046a710,
+               0x8116f4b287f4484d,
+    /*  6,4 */ 0xfb741c75bcec9c04, 0xa4a87f18e8ea3998,
+               0x42cad12f0f892574, 0x22132c2742689000,
+               0x769afb037612c87e, 0x16e7547a0e847346,
+               0xaa48f995c3552a0a,
+               0x3b30e29cd52121aa, 0x148200362989d325,
+               0x907defc6d85441be, 0xea71c5a3c4d27e33,
+               0x36a584409e68ebdd, 0x9f27bee5c598bd8a,
+               0x341f524a5384fc60,
+               0x4790d6c722ad111b, 0x5c0a5e512c5bc0f4,
+               0x30efef42647133ad, 0x419918961ba70c37,
+               0x7d5b1c5200bf080a, 0x2a0355f8783056c9,
+               0x72270e4e6ec81f34,
+    /*  6,5 */ 0x674b36222f6c70a6, 0x6288500b3206ffc9,
+               0x2bfb482178279263, 0x10752be357ab7b8c,
+               0x6657345e320a1be9, 0x673a68f43cdb833b,
+               0x792836d9068234c7,
+               0x84ec0816fdc128ba, 0x783b2aeb2b5129c0,
+               0x03474d082e2a083c, 0xb5ebda57b1f47420,
+               0x2b9d1008072ebf92, 0x1f305a60c97074b3,
+               0x5acc21ac54649e6f,
+               0x93bcabd8e537e76e, 0x3c0c1822936c2d9f,
+               0x1ad700181f968813, 0x21cb08ba73825fdd,
+               0x0f22d69b035ebef2, 0xc773341179da3232,
+               0x0ed93021fbf4c7f9,
+    /*  6,6 */ 0x038eb25aacfca6d7, 0xcd5c5434c392fb0d,
+               0x4a512b79554edf12, 0x6a901a1c1af6814c,
+               0x9118c7da9fc52de8, 0xf0fec08e78da4675,
+               0xbb11582bd3f7efb1,
+               0x2b089529e82fc9ac, 0xdf3abf193dd25fba,
+               0xc36aedb2b7875016, 0x444e81b001bebd74,
+               0xb5772fcbecec9a48, 0x24b44916fad0628b,
+               0x04cb7e0f0f9801cb,
+               0x00510008b2e1dec8, 0xd433f019f3b2e096,
+               0x56707baeb8c6a7fe, 0x5073a4f8e2f020f8,
+               0x3b98a45995bf7f3d, 0xc33187494de32b11,
+               0x3bc34391ee545db0,
+    /*  6,7 */ 0xe578a183e71d801b, 0x5e4ba6faa59e3549,
+               0xf1b137bfe9431e45, 0xfbcd16f671cf4798,
+               0xb1b37a3005737f89, 0x2abcfa3f43606ef3,
+               0x40d388f8eb5ece53,
+               0x265e34a56838d533, 0xf4bdf8561fc6d219,
+               0xa1fac16c6161727f, 0x94c18cb9d6df2492,
+               0xea7793c6e13170c1, 0x7dd420330f58780d,
+               0x7577e6b1a7d18b98,
+               0x7409f53e88a20a1a, 0x1cee0adf9fe5aa2b,
+               0x20cbcbae17677287, 0x29bce694453c499b,
+               0x7569162267a75876, 0xae5a3b543cd96411,
+               0xe0f12fee468a97a1,
+    /*  6,8 */ 0xe22d144015fb59bd, 0x4290665c3d431441,
+               0x6509ea47482f2bcc, 0xf7363f44d339b2e6,
+               0xee18d56aede6c375, 0x2eb3b89cc47cf05a,
+               0x591dfed9683f861f,
+               0x3d2a510e9697a469, 0xe73cc3518c25fe4b,
+               0xdd8e35f3603f6a08, 0x2fff96758a44ad63,
+               0x5c5bf84b13718938, 0x78bd177c429bc727,
+               0x7159d1752044c481,
+               0xdba558658bc8f21f, 0x2ae906b91e24187a,
+               0xa8e64d75bbdf541f, 0x8fcf919d892e9dcc,
+               0xc3abec2efeede24c, 0x77118fcb645514c2,
+               0x0990ffb25a91756c,
+    /*  7,1 */ 0x707b8820f4bde3ee, 0xec7bea712ef24d51,
+               0x83ea9a517f88cdf6, 0x431a4592b15cecf9,
+               0x784ebb013e9eeee4, 0x06cb31f4e15d786c,
+               0x5603fd84f4fda12f,
+               0x09f6790e99e1321f, 0x1a4e274c66a74a4c,
+               0xda5157a4b70b49a4, 0xd51be8dc7700bdda,
+               0x2761a477e0e54a60, 0x61c72b027eacfaf9,
+               0x50e2340280b91766,
+               0xf669c2de01a4d458, 0x5325579cd0721781,
+               0xf5d7b490bf3d7f84, 0x4f317cd55901d11c,
+               0x0d12eaa4d430f45f, 0xb41f4fc2f09474b7,
+               0x82deb2bcbd520eea,
+    /*  7,2 */ 0xf9ca884cfbf5844b, 0xa8899dd05c48524c,
+               0x9e7666dbffa1936b, 0xb3eaf48fef94fdd2,
+               0x4d51530d56358f81, 0x8b2d14adf9e59673,
+               0x2f850464731f6137,
+               0x39d6ae90599dcb83, 0xf958a4f89e061992,
+               0xc2770764052498f0, 0x2f551c0f2866d99c,
+               0x0d04c3708064681a, 0x8925b00ac3012c7b,
+               0x8d57fb354df89521,
+               0xdb305d3387e426c5, 0x0de70656cdc8734a,
+               0x2f02fd927f5c71a5, 0x5bb1ccf42f00875f,
+               0xed3a321ea3b40719, 0xe5ff71d77684c5bf,
+               0x3f08aee76ca3dac3,
+    /*  7,3 */ 0x5d230c788522ec8f, 0x6648c327ef9edb74,
+               0x915758457354f4a8, 0x407b6229eebaa6c8,
+               0x187cfb0329cbaf3d, 0xfd61b9eb6758b779,
+               0xc5bfebabe34ebb11,
+               0xa3b4e2bb542d239c, 0x85e13161e3f61fda,
+               0xf786ddb43fd0f3fd, 0xa827832de02cf203,
+               0xa2b791a253c589c4, 0x42b99ec06646db6d,
+               0x31cd6ca1e59bb375,
+               0x71448c0f390b6cd6, 0x845eccbc3a5cffe9,
+               0x2f5ac9bd9c1e17a0, 0xa65227078639698b,
+               0x129a4d670e285a2e, 0x7c744c876e1723aa,
+               0x4ef2b8ef492326f7,
+    /*  7,4 */ 0x4bf76968758eb660, 0x101b77dafa2b35ea,
+               0x934305654d840ea2, 0xcd0639c0a1f71031,
+               0x0bb55fffdff8dc68, 0x604b0305b8060285,
+               0x0439679376816a06,
+               0x9fe37b7913627295, 0x70205fa7073785da,
+               0xa229153b571e5ee0, 0xe946c6effce7e47f,
+               0x3576044dc57d02a7, 0x20307cec6c108abb,
+               0xe80946965f1a2e7d,
+               0x9b4fdb7cec5696bc, 0x4b4f9f2aad3fb921,
+               0xe07f000d00c50d6a, 0x99a3f71034340600,
+               0xfd2c84fa9bc6261c, 0xefbc12e8766d406e,
+               0x22d17ea5d60affe9,
+    /*  7,5 */ 0x53f202c5196a9ec2, 0x5713bcfeb2815c5b,
+               0x44ebc41e44bc2ad7, 0x67f668f86f3cecb6,
+               0xc9290720d63194d4, 0x5c2a6661a0eeddf0,
+               0x012ddeb5ae496a58,
+               0x5c64c8e4693f834b, 0x7e6b6df9f0922aa4,
+               0xe16cd0d651a6fbfb, 0x4bb17cb10e3e379a,
+               0xaa2cda76609734a8, 0x21e60e08c210b93a,
+               0x0d2a31353f7162da,
+               0xcd1679e5939c8628, 0x4f7cda1a4fee058d,
+               0xcad278ae3cdecac5, 0x1215bfa5b60f02a7,
+               0xff11492accfda308, 0x3fc189981525f002,
+               0x7c8cc1343ce26ea6,
+    /*  7,6 */ 0x825665646e4c4f47, 0x1b1752720e39c79a,
+               0x3a29e37e9db41d40, 0x48b6a74c24d75ec0,
+               0x3b10b4b251877b62, 0x20e2e18c9ca61c19,
+               0xb2f34aa6675b0574,
+               0xe43e04357a10a5c0, 0xa7dda035f6c282f3,
+               0xfea681a7992e9ef8, 0x947e5487833b18bd,
+               0x43a47708915c406b, 0x734be8c9cae8e96a,
+               0x1b596f6be6465d72,
+               0x002540f5e6344d23, 0x6398183a04d6940d,
+               0xab8def938c019e37, 0x72f202ad256870db,
+               0x7d88aafb7d5a103b, 0x63e82238b1e2d4aa,
+               0x5549e4501339cc9c,
+    /*  7,7 */ 0xa6da4df73ff2801b, 0x28680db83f74a7df,
+               0x8c352fc644268014, 0xd81a622692d04eb7,
+               0x2530686798eac886, 0xe87a36ea51bbfa9e,
+               0x3aada1989bf7f450,
+               0x83ee50f3a5fdee62, 0x22e4d50b00633b2e,
+               0x89aab483e549e182, 0xba8bef1329c08078,
+               0x0473b3395df5a32a, 0x4731a12cc0c99da2,
+               0x6663b9dae28f4d51,
+               0xd241f8a2db8ff400, 0x73f8b2041155b923,
+               0x3e1959d2aee29235, 0x5ed8f180cf7372e4,
+               0xa87ca327d9b66788, 0x3a6d34233b44bb76,
+               0x979a6fe243589759,
+    /*  7,8 */ 0xdb800065701d5599, 0x44ff36351c8fee57,
+               0xe3ac88a516982e8a, 0x73e3a887b4deff23,
+               0xaaf4d11639fde2da, 0x9b22a5de9857a0c9,
+               0x7f6f6b6410deccaa,
+               0xbc28846a3a626697, 0xdf63bfff90e2e9e9,
+               0x36027f799cca2d67, 0x8c9318aed2f06a56,
+               0xbedbdf529168b592, 0x88e8325993161dc7,
+               0x17fe0ca69bd7d653,
+               0x8c1d0fd91e672eca, 0x11b4e719367d833b,
+               0xd938f2f2d6881a68, 0x9b5ee93a6e3590dc,
+               0x94af481b0f0a6baa, 0x9fcceff0a763e34d,
+               0xb69fcf2857fee445,
+    /*  8,1 */ 0x2a8d351183d66e88, 0x0e5ffb861a1a91d0,
+               0x5496f68c27c2a785, 0xe80800499fd6399a,
+               0x2fffd1c2dc52152a, 0x5902affe8b2e600e,
+               0x5c4d2cce03b175c7,
+               0x878ad7c424f57e78, 0x038a77cf6061736f,
+               0xb97b952876012f85, 0x5392dfc8ff328451,
+               0x363a6f50753cc6dd, 0x8ec4471de89472f1,
+               0x7030f2f6f45a8602,
+               0xab053b0730724040, 0x328cd29700d62e27,
+               0xf9330aaaa4449b44, 0x8c5e298858d25762,
+               0xe8238df777109aec, 0x87de3038164d2e0a,
+               0x5d369cac47b094b9,
+    /*  8,2 */ 0x6fcbdbdcd4608f72, 0x3c21b4352235a13c,
+               0x2c15c9a6497f64bb, 0x36322d113af23831,
+               0x5c6c641775fbbf4b, 0xcd967e81e0e1520a,
+               0x980b2c63de387118,
+               0x56fa9db619ae44a2, 0xf8170281dd2176bc,
+               0x129b30fd037118a7, 0x8039626d9c485454,
+               0x50ee4ada6bb43964, 0xc16d67f5d98c3550,
+               0xf53ccc318c4d5ec9,
+               0x861240c9937d9931, 0xeab570581e5bb2ff,
+               0xeb7cb338799d4630, 0x56c9efd654b2f33c,
+               0x863ebfb0e6584ba1, 0x61866291c67cbcb5,
+               0xdf9063bc8f8e2c88,
+    /*  8,3 */ 0x92e641c843c9d012, 0x5bf18b8c7245cc9d,
+               0x3d5fd0d3684cfa97, 0xdfe6a91e2fbe39ac,
+               0x4d89bdfabb10bb8f, 0x6ecee963a9fc3bec,
+               0xf8f8cedd2035d0ac,
+               0x876d0d344fcbd449, 0x2e85b7928d3744bd,
+               0x409abb7802490c47, 0x59cba01efec9d5c6,
+               0xbbc38cb40b5e5c7e, 0xc6e644b8020816d1,
+               0x22c5907ef7beaff6,
+               0x8363e51fa5aa85e3, 0x5868402011a91968,
+               0x3b2e3e37d517d852, 0x9755ee575aaf66ee,
+               0xffa65faf7114b396, 0x679f8d313e52d35e,
+               0x66b8c60a19f563ee,
+    /*  8,4 */ 0x69a822f9adced2ac, 0x9636e6a9185dfe9f,
+               0xb9eef49735647b54, 0xcbbc8d58de1b264b,
+               0xfbe26127d88b5f6f, 0x63071540c4d5830f,
+               0x6b71ac8cf5ac8798,
+               0x47b3e3f699ffee87, 0xb78332b86e8f43d5,
+               0xe007727e74da054e, 0xc7ddf5f90aab6be1,
+               0x80eff2f611bf4a1d, 0x3b84cf3bf0e28379,
+               0xb26893a96b4618d6,
+               0xa072e72dbaa2133d, 0xfc226095caedd03e,
+               0x80fb465b2f9e1edf, 0x62e6b7d5f5a4a525,
+               0x6e72d7486d4c5a0a, 0x1b7e747b70b17430,
+               0x47ee828319a437e0,
+    /*  8,5 */ 0xe0361bf78324ff95, 0xe0f8718ad5861420,
+               0xd189e777313c7a8f, 0xc3aafc327a800a07,
+               0x9c047f7ec1ba815b, 0xbf7a3a7616627b3b,
+               0x0a95e001395ef280,
+               0x52c28fb8d316a4ec, 0x35319d77d85a7f8e,
+               0x5c9f928c5855aec7, 0x6ed3c589c247ef66,
+               0xe22c5fce1c04afa0, 0x573ab20630e85375,
+               0xf51d193549d32645,
+               0x34b75d65672bd175, 0xfadc5642323a7df9,
+               0x4628ab7c40a7e0ad, 0x38d10f4c7b2f3c90,
+               0x7857498c96f45283, 0x288c3c245ba6a1c9,
+               0x7239bd43f78146bd,
+    /*  8,6 */ 0x35054282cd35beee, 0x8ff5969569893035,
+               0x11ddc535f00a1cbe, 0x2ed000c53519e0e4,
+               0x7d76c6c9724fa92b, 0xf9a012a5aaa47eff,
+               0x5efe057fea1faa74,
+               0x9de11472c13fdc54, 0xf7b493424fc18308,
+               0xa33acf54fe71c8bb, 0xdf4d80caab8a125a,
+               0xaba1aa09661a6274, 0x98a86e6d2842d6d7,
+               0xa01d9e68e650ccb6,
+               0x040a6045cd8206eb, 0x1b5fef2709da8253,
+               0x89546b6bc3036de6, 0x43c29d2c36cbca1d,
+               0xc594a76b2ed58d84, 0x1def9df2ba94a384,
+               0x3439fa9e48438be5,
+    /*  8,7 */ 0xf7eaaba904a7df31, 0x2a22363a7adcfa5f,
+               0x8d3fbb724a52ad33, 0x2c369891ac6004fc,
+               0x895a97be347ae479, 0x015f25b49908a686,
+               0xe90fca85b4d0c888,
+               0x1860ab7997daa912, 0xf59bceffc6004392,
+               0x79e948f76604c30e, 0xb6ccb0dfa347b94c,
+               0xcdfd98f78e1a0807, 0x4dab26730f1519da,
+               0xb85572ec8d189b68,
+               0xea32a405486e1029, 0xba9a5d488d0c91b2,
+               0x7b615c1081c31e77, 0x8950e26e27952155,
+               0x49734061a31d9c39, 0x2487af0737749beb,
+               0x301c957a1b14e276,
+    /*  8,8 */ 0xe8a7de138a464ffe, 0x06ff52bebdeb6df3,
+               0x23480f2aa59a3216, 0x932cd14b8ceaa97a,
+               0xb021c5a94b94b32b, 0xf96e1dcbd22c8e13,
+               0x7ebfb04ad15ae9c4,
+               0xad904264133f3d6b, 0x0b6298dcfb507050,
+               0xf6bb66dba5eb377d, 0xce38ba870326590d,
+               0x86dd55556b6f1231, 0x20ed2107eda31ae5,
+               0x385f1123ae623cbb,
+               0xd0ba35e93f3e61b0, 0x7c63a7f1b6da4572,
+               0x8306f6f0db8f573b, 0x1271ee40a2d37af8,
+               0xb2bc43c09496adca, 0x7b63c78808361872,
+               0xe3f91dd9fcbb6997,
+    /*  9,1 */ 0xc6605418bd0518d1, 0xc0193237f809e1cb,
+               0x15af0b37a7005286, 0xcaa853c0f1fb0e0b,
+               0xbd0e6beba2fc3b97, 0x5d7c5e6a72f11f48,
+               0x575e66d26ebf0c8e,
+               0x65099477662eae3d, 0xbade53f074f96c9c,
+               0xfed7d16cfbfdbb81, 0x338c338298b4efe3,
+               0xb7347b8ec6daa112, 0x0fe4b9504a4fdf88,
+               0x2e7df4cf30c1c39b,
+               0xbabd6410065f9f94, 0x306b54563a5bd610,
+               0xd5953fc77f1ac5fb, 0xd4e096a0e769a4f8,
+               0xd5abfb5cca0751fd, 0x8b5aa9f90e0e77db,
+               0x958782ac666081e0,
+    /*  9,2 */ 0x681e023a6edd31b2, 0x45c8f76d1459ff86,
+               0xe88e37970705617b, 0x8922faac06120781,
+               0x92e22756d985c51c, 0x07fd0a03c98e4df3,
+               0x626f46a52ea51c89,
+               0x8cf8f766a486c8a2, 0xf0de8c499a288ed1,
+               0xf2a0b644d2dc63c4, 0x84a973fd47dde686,
+               0x24e786ac809a655f, 0x9e61ce8a05743e71,
+               0xdf0ba9a31cdd0d69,
+               0x4fb85c3c2224ba06, 0x2bb9e539a9797818,
+               0xbdded471a079dcd9, 0xa1458bf1fa31202d,
+               0x506d5c2b0c843c83, 0x7b4835d21eb893b8,
+               0xe5e95cc210da56cb,
+    /*  9,3 */ 0xb94042b4c0e65cab, 0xf5146ee7e1fdbea2,
+               0xd80f6edf5ee01975, 0x27cc2e819aa4ffc3,
+               0x41f9bcaf83ba9abf, 0x5ca39475f9445ce0,
+               0xcdd8f479c0199b10,
+               0xbe84c75b6334be7b, 0xe0644d648a555963,
+               0x6c39cc294d43ee13, 0xd9fe0f2afbda3a0d,
+               0xbb808e72cc1d3e22, 0xa4d61737e5461811,
+               0x0c2f0d3136148016,
+               0x73a1a7afceab0f71, 0x0a3e760f2a1a8386,
+               0xbbec01c5daf55878, 0x3957dba0afae0d42,
+               0x465700fad7acba39, 0x1489f1d91faefdf3,
+               0x859e8f885983f6f3,
+    /*  9,4 */ 0xa0ca538e400f09b6, 0x4aa167df9dad9512,
+               0xefb4c5b5a0b7da38, 0x8c220d3fd6b48189,
+               0x17b06645bb876599, 0x4fd2aefbc9aba4c2,
+               0xf8a1159585d3d001,
+               0xc1670dfa0aa6f2fa, 0x80f71dc08a374e77,
+               0x035e4048cca7cd02, 0xc1b2522a3d9ec40d,
+               0x086208b06c8f8944, 0x53372e5d1793dca1,
+               0x1677238823316a07,
+               0xbde84651e6f3b133, 0xda20adb1af755901,
+               0x8036a38e9299b79c, 0x8a841178ab323bb1,
+               0xf8fe242022374f57, 0x4b9e8d71e855259b,
+               0x303aa7cf56cbec65,
+    /*  9,5 */ 0x7c424646f2446a02, 0xc1e72b70dd558de4,
+               0x61177cefd82faf66, 0xe545d687c32360e9,
+               0x49f39fed689514b7, 0x13d66c6a8ccda9e6,
+               0xbcda20caed5c9be1,
+               0xe8e46c72949c509a, 0x53f9f9b817ce19f2,
+               0x836a062266220ef4, 0x426805ce6b1e0753,
+               0x032572ce51830385, 0xbc0d18ce46bd6e26,
+               0x3e8b847b7cadf25f,
+               0x58676e71ba3fa56f, 0xdc27944af1851727,
+               0xc9bf1a48a3b25636, 0xe11e6bb8a0ccabc8,
+               0xb066da30aeaaea96, 0x95bd619554ed64eb,
+               0x4a4e520da7e3870f,
+    /*  9,6 */ 0x41cc3e00c7e4420b, 0xd384a33538ef79c8,
+               0x0d3caf133a5960fb, 0x9e310fde89b8ec64,
+               0x61fa13a21f18c9c7, 0x1fae31ace584b649,
+               0x875adb6836aa9602,
+               0xfe9204b752e01256, 0xd95127bd2c3dc8d2,
+               0xd1d392744d2796d2, 0x225d7817b0d86064,
+               0x01d44bea8fe36fdb, 0xf1a1088e76d593ab,
+               0xae652b70e614a869,
+               0x7a11da5bd0a28dd7, 0x652d3a7718f5e404,
+               0xf391c7918eaa734c, 0x6fc683da2c1758d5,
+               0x6aa7fa15ec5c7fa4, 0x7bf64500a46db469,
+               0x16a79ef0f50b6562,
+    /*  9,7 */ 0x5742967013c79253, 0x194bfa8909716f0c,
+               0x70532e5535e7bbef, 0x151c2d59f6d230e6,
+               0xd21ee3a2f6f0fc99, 0xc64cb5728b606ece,
+               0x88ef39b4bb86c554,
+               0x831a5b12fafe013c, 0xb2f3862320bb7c57,
+               0x2934f408a39dd819, 0x9303e92a914f9cc9,
+               0x25f7f613ddcd80c3, 0x394b972aea5d0177,
+               0xea6695bb51c41380,
+               0xa574cab8898c513c, 0x0e8d8115982ec037,
+               0x34a6d3defbe25afa, 0x278ff4249e7e942f,
+               0xbf5c65e03a7c5b82, 0xb125377317f22406,
+               0xc68f07557d76b978,
+    /*  9,8 */ 0xf4f2115b8d9c1154, 0xb27a1df231c74e93,
+               0x8ee2cd534461d248, 0x34bcb36352df1401,
+               0x52e116724d3fee4f, 0x217430a8562ff788,
+               0xbcb05b3f4019070c,
+               0x8b60584448cca556, 0x32f610d0cbf4fc44,
+               0xb6ade82b6c3b7a19, 0x7556e143c5db73c8,
+               0xaa2c0a0017fc1adc, 0x50339680489929b3,
+               0x3e2125831b1da537,
+               0xcfb4afdecb4462bd, 0xd999c93c9cfd1373,
+               0x25e2189617b228d4, 0x18a403d8beb126c7,
+               0x667daa9dbd6c5bbc, 0x98b2f2f9c327fd34,
+               0x353988451ad049dc,
+    /* 10,1 */ 0x9705910484de9428, 0xa4d1620542a5abdf,
+               0xd65bb9aa0ededa16, 0x5b8dfaf9a93f71c6,
+               0x4e557ca8ee88be13, 0x896aa26781ad1d9f,
+               0xd3fbe316c6c49f4c,
+               0x1e088d8522c34c3d, 0x450dbb6d645badff,
+               0x0ab1f3e3080b8385, 0xeac0657d5ccc54c5,
+               0x596b7ef2c04e07e6, 0xeca8a73a81e9a7ba,
+               0xa0b804c8284c35cc,
+               0xa4f0dd36a6477df0, 0xa9398392d7b364a9,
+               0xbf4a6ee6abf59d87, 0x518c577dc87184ac,
+               0x1a4027050e915cb1, 0x8312dc8ec876ddd2,
+               0x9bcffdddefa7791b,
+    /* 10,2 */ 0x3ad4e06f5c1cc4d3, 0x28d00fa32e32b4f0,
+               0x39dad1956b9afc46, 0x08a0041695c39ce9,
+               0xf266fb01aa39d41e, 0x033d545af340fd7f,
+               0x2f655428e36584c6,
+               0x7414cfb1f8dff960, 0x2d0f7236ffcda814,
+               0x7f6094c6a6788d45, 0xa07eea742ad4a527,
+               0xc38d6229aa369d65, 0x90e09886397627c6,
+               0x361ca6eb38b142e5,
+               0x94f493a6535cab4d, 0x434bd8b80bccdf58,
+               0x091b650783534d7d, 0xee3ff619a2a3407a,
+               0x40961cb8fd2ef254, 0xf16f32af404db2da,
+               0xe163a7758d7aaca5,
+    /* 10,3 */ 0x09e108ec7bf62da2, 0x47adf4e84fc31719,
+               0x948ed5864aba66ac, 0x6b5eac54ca0d4b54,
+               0x22f1f177af748e4d, 0xf99b087ccb91ea62,
+               0x6508e3657bf97fd5,
+               0xf60dd84b70d459a2, 0x1bbfe66a13f071ec,
+               0x659ec139f531168c, 0xf99bbf675c05fa96,
+               0x5ceeacd46784e982, 0x0a969c2e32b58eed,
+               0x3471ecab7a2a127f,
+               0x65d88e98638fbf22, 0x49e3749b15d8c1ae,
+               0x1bd6c6dd85f88ee8, 0x78d0e8d6b201bc91,
+               0x865b3d41dcba96be, 0x5bf8fd5569c513ee,
+               0x7c720a2058c1453e,
+    /* 10,4 */ 0x904d6fe7865d22c0, 0x7a9e4157c52f9c2a,
+               0x4cc5b274d874de91, 0xf5e8a5cad5da4d71,
+               0xf8999cfba3fc49ef, 0x289fcc249a1e044c,
+               0x00e97de1932930dc,
+               0x6f4893a41d6de601, 0x2f5522e5d4c4cfe7,
+               0xaacc7daf4a95e7c1, 0x8927bb82103072df,
+               0x946ac635afa278a3, 0x48407cbdb2e26dbf,
+               0xe8c105b6844ffda6,
+               0x8c3f63b643dcdd38, 0x3117a6b4e7df8257,
+               0xab300e3934062d8d, 0x3147625c46324c9d,
+               0x4193140a8c962754, 0x0b95f0491c1e285d,
+               0x30ad3ef34b1480bf,
+    /* 10,5 */ 0x7c58d118b053e21d, 0x564660148be6148b,
+               0x32528cb6f5ee7af6, 0x103b3f0cf2ab14a8,
+               0x92c5ca70c004f053, 0xc1edbd08ea931311,
+               0x867a8c3e2391be5b,
+               0x0018f5bf19750fdf, 0xedb8cf1d520c9ad0,
+               0xf9ddb3b428a89fa1, 0xe5fa10d7b070d89c,
+               0x26649352cf23c90c, 0x627ccb7ae08b0404,
+               0xc6ca7a1b77216a02,
+               0x1080d73badb31c2d, 0x760c6cd789e2f613,
+               0x214c9bc1939b92d3, 0xd28deecc9a562072,
+               0x7f83012789d25539, 0x382f9b6a71748bfb,
+               0x8d2cf1f0fdb0b5bb,
+    /* 10,6 */ 0xddb0e5235af51aef, 0x640ba6b97312a6e7,
+               0x87ebf6ae60ed00d8, 0x356982b054e6ae8c,
+               0xac111f945e00166a, 0xd8e384670588887b,
+               0x9c7c934acfabf834,
+               0x57816858d13a3941, 0x3fb5388366cf4538,
+               0x6bafacac4d0bd11f, 0x2a014e391c5088a6,
+               0x535e063148bec9ab, 0xd6281cfe1f3b17e8,
+               0xc9eb6bdc08045c8b,
+               0xd43fabdc1f0bb322, 0xd21483b2393b1c7f,
+               0x2eeea4b4f16d865c, 0xf67c1044a8e09b23,
+               0xd4f40ee7d5d9b777, 0xc06ccc36fe837a71,
+               0xd195730a41a36adb,
+    /* 10,7 */ 0x67403fc17374d83c, 0x9f62d5ba504a68a4,
+               0x2368779e87713e39, 0x6a3e51c1ec57e5e6,
+               0x8004456b71fda195, 0xa1274a00a4c0ac94,
+               0xb98f084045bd8747,
+               0xc8acb2590fd89dc6, 0x755bbb91a67cef48,
+               0x1c8d69eef3db1ca0, 0xda5c92817475c565,
+               0xc769480c2954553e, 0xdb49d1fd5831a8a9,
+               0x3772caea1e5b14b3,
+               0x9df1d2943dfe3a21, 0x230c139a1484b81f,
+               0xb811920cfba89be0, 0xb6377c07a244f48f,
+               0xa97430347ddc183a, 0x38f381b20524a3d7,
+               0x6a93abc8ab7bdb2e,
+    /* 10,8 */ 0xd8d350c044eed653, 0x537a97dadb96e9e2,
+               0xe94e781790181567, 0xca1d7fd44ad15f27,
+               0xc1db2d840d46283f, 0x2c08393e97f2dc29,
+               0x14dc72a1a7bc90d8,
+               0x3ab139b8f1644e58, 0x73afe1dbd4d71ba8,
+               0x93795b2aa1c40111, 0x9f04d15c91743983,
+               0x7e97071dd64c0aa4, 0xcc6276c535984408,
+               0x7b6223e8e50d0cf6,
+               0xf5f6122f2057fc93, 0xe02d8cea978a8863,
+               0x8001ad3e38272c0b, 0xf1a37018878d05d7,
+               0x75377238465d7a8c, 0xa51d2d24718ac350,
+               0x02710341323d7275,
+    /* 11,1 */ 0xe844e4a51d0fb585, 0xde1e00846bef1f3c,
+               0x3b3934edef39a8e2, 0x54337188430afe33,
+               0xde4c9a3f24ac78b0, 0x9edddc9ae6a40f39,
+               0xf4701578eacd5103,
+               0xb11e396949a2f31a, 0x39d8c8a40f4b19a8,
+               0x87e066dddd10c9d2, 0x13ea28c6f9742458,
+               0x0fbe1122a9fdb511, 0x0c89f36e0267b5af,
+               0x7b1c0f774f024cd3,
+               0x381d88ab6fd619ea, 0xf63643418911b8e9,
+               0x4f33f9224b61b07b, 0xa545faa66ef3f525,
+               0x717311d1aae0046f, 0x612337ca816a3d06,
+               0x80e4ffe65f94e89c,
+    /* 11,2 */ 0x5c3089b3e73c92ac, 0x6f500ff3f27957a7,
+               0x496d43843d3d9d67, 0x98e924a4e547a19d,
+               0x8f885b552268911c, 0x4881183e0ac5fab3,
+               0xcaccea9dc788c410,
+               0xf1fbe2e95e3c6aad, 0x78b1a7b3992b3a6c,
+               0x8261005302ec587d, 0x78610632f589a0e1,
+               0xa8f9232b262acdb9, 0x1194e9c09a151e4e,
+               0xab13645849b909b2,
+               0xb481a4d5fa204119, 0xace427c6efa57cbb,
+               0x2bc94f8833f57032, 0xff24a8752f43aee9,
+               0x16e4edcd5cfdca83, 0x67843eb7f45a939c,
+               0x1f86c3acf41c74f0,
+    /* 11,3 */ 0x1323aabdef5abf10, 0x97337a95ef84f70e,
+               0xce21e20539c4f266, 0x4932841fbaea810e,
+               0xb04ced1b195da8fc, 0x227f6ff068c40f22,
+               0x7fc65910a5bbdcfe,
+               0x59cf3fec1f52d5d9, 0x26f52964bf747ef1,
+               0xd2f993ee3bd607ed, 0x31965583ff0129a8,
+               0xb04e4e4c8614a59a, 0x147ea1dbb6431c68,
+               0xad00dfb54d1a895e,
+               0x8a0a5891e94ac3b1, 0xbe4e9d08e0f3a6c4,
+               0x26febdb8ba6a2fcc, 0x0e862278a21f04cd,
+               0x6432a7c8bdff59f8, 0xda61aaae349fcedf,
+               0x175d54a66c8f5b95,
+    /* 11,4 */ 0x3d519133f6ac573c, 0x7ac9dc4a35fd4c3f,
+               0xb9fbc54022a01775, 0xecd1e561f8189542,
+               0x25f3cb024e62744d, 0x80e5a9073a0a0521,
+               0xc2fef736dcf54229,
+               0x408a6f2e306e4353, 0xcfb01634163f684d,
+               0x99a89655ae048f79, 0x05db7ecd65a24d47,
+               0xb171f6e9b8708677, 0x528a5be279fef598,
+               0x148a0a51943f79cd,
+               0x21bc210cebf26f95, 0xfe1c467b760d6544,
+               0x31bbb5b535bdd968, 0xc960d2611070011b,
+               0xf00bdf03014be2c3, 0x5079d1f42edec908,
+               0xa52b54ae374fcb69,
+    /* 11,5 */ 0x0b43620a61eff26d, 0x9859de5914cbb609,
+               0x43bffaa5500c0cb0, 0xa3cff1cae70cc52a,
+               0x5d856c2800976875, 0x237c8d333ad1b03a,
+               0xffd3b4d4ae56ce75,
+               0x554451bed5d3bb54, 0xc5bba5843e666263,
+               0x0b9d10de363d10a1, 0x0ecdae69429d79e5,
+               0x0a6a480b250cdb6c, 0x2445d28ed782446a,
+               0xe10c40d9b49d2a41,
+               0x4df41e0cb94bd4b6, 0x713894b3f0bbeda9,
+               0x1db29dac2fa4eb05, 0x052687f9e08d5c03,
+               0x511bc0035453a437, 0x21f3128f96031ade,
+               0xaa202628ca41a4b7,
+    /* 11,6 */ 0x50a994a7ce9fe530, 0xfc0018ff5582aece,
+               0xa8102b4ac3346462, 0x7e48cac6ba76c02b,
+               0xe95cc6e84417fc26, 0xee60ad95896639f5,
+               0x1611b91c3d35380d,
+               0x70f086cdc11ed4cd, 0x0993ba2b7b3502a7,
+               0x1470f50e2dd8fefa, 0x631a53f691cc3511,
+               0x42f4fa77577a59fa, 0xfb1d99937698e333,
+               0x693f14c597a0a7e5,
+               0x358e7c0674f1f2aa, 0xc677b6cfcb097e87,
+               0x885deea6a47d6b81, 0x07e542d049db25a3,
+               0x729bf4d13acd95e4, 0x8d6f37e4b59d810b,
+               0x638c0cf0cc43cc63,
+    /* 11,7 */ 0x08a97a43e7a3669c, 0xc01ab888cedb8795,
+               0x6ebec376a466e9f3, 0x528e3f98a6610f0c,
+               0xc980e7ebebe2609a, 0x040854c7f9cb9413,
+               0xa1b3a958bb52d77e,
+               0x009ec91581228018, 0xa4d3c44f94c621cc,
+               0xd5114bd7a3b31106, 0x3334f18895149d99,
+               0x0a07b6583d6d512f, 0x8e6c5856396071c3,
+               0x038edfa3a8f93d8e,
+               0xad7cd9bf36235193, 0x614d48541ff0b828,
+               0xbd1308dc154a7f14, 0x4d7302860ad1c336,
+               0xbeb293339288fe30, 0x4ca33e637145bc59,
+               0x661795087bacc896,
+    /* 11,8 */ 0x23296efc00f635bb, 0xe7fc25eb23ed573f,
+               0xa81af45ebcd0121d, 0x71e10662b4e0a0dd,
+               0x48a8df02572cd72f, 0x62da80ea2e4bad30,
+               0x0d9829bbf1b34714,
+               0x2dba15cd030b0669, 0x3d79f5489cceaad1,
+               0x53e412c23309808d, 0x00fa6731d9249ef9,
+               0xc8739f3692d11fed, 0xd6007a892dfcfc65,
+               0x3349bae4e67531b1,
+               0xdbd69e90a953786f, 0x41854d5220dac2df,
+               0x203d614c79e96fe5, 0x3bc621a0154ee25c,
+               0xf9ba3e685f2f0c7a, 0x2a08757ddf04711a,
+               0x5c6a67a08378d09e,
+    /* 12,1 */ 0x6f24684ae182401a, 0x98af0b79c1c21a70,
+               0xbb069fe1d81f8d89, 0xcf3dd7aaadf870f4,
+               0xe06e4a40f8d57f85, 0x5228c8b55aa162d8,
+               0xc34244aa9c0a1a0c,
+               0xb7b5c6cf968f544e, 0x690ca560533de23a,
+               0x2aaaa6aa5512047c, 0xa751a6a020eda5b1,
+               0xfff2baa272ea0a49, 0xb756ebf4c28a6d6c,
+               0xd747074e6178a495,
+               0xcb7ad2268b904f50, 0xdd4a22414909471f,
+               0x629b6e2aa7504e66, 0x78a21669b8e7ebc9,
+               0x0301e1d59f9d32c3, 0xf884450509017713,
+               0x53be3181e95b0780,
+    /* 12,2 */ 0x58ab9ffe79e157e3, 0xa3ef9cfe46d44dc1,
+               0xb7e3a8435551c8a4, 0xd49954a7638acc03,
+               0x90c13194f708a4eb, 0x2b68b253892a2953,
+               0xc1662c225d5b113a,
+               0xc9cfba0723a5d2bb, 0xe254ffaf6d3cc327,
+               0xf322086c6314bc67, 0x7bea72e166616312,
+               0xf40002122ff780f9, 0x62f247578a99495a,
+               0x5f479a377ce51e35,
+               0x5ce705c3520e05ea, 0xcbdea38e0fc4fc46,
+               0x35800db3f85116ce, 0xaa320d084af936b8,
+               0x9f506d8e6f4b8850, 0x060ae78a7164712c,
+               0xd0b347a585688244,
+    /* 12,3 */ 0x38e8812b66cfad0f, 0x38b56269b1f72807,
+               0x1904a5e3d4c18381, 0xe65adfc56b116284,
+               0xe1f8c7e4d683be82, 0x699ba549adc8fd99,
+               0xb551512a04b80a3b,
+               0xd8954328db6837dd, 0xa347d60836565fee,
+               0x427c79efa69ed2c7, 0x956c28d33cf62152,
+               0xd81d8ec084aedec5, 0x3ab0e31b515ee0f8,
+               0x42df6220cbcabaa1,
+               0xad2095ef3008d275, 0xc124d86fc6eb958f,
+               0x40a8c9db2632d9b5, 0x15d5607b584713fe,
+               0x9ec4b8d672d8cb69, 0x43c2367bfc98207d,
+               0xa7fb24493843a70a,
+    /* 12,4 */ 0x5ce0a0bf17a3616a, 0x8327773c1e5fa661,
+               0x1cbf3053d538b2a9, 0xa932cd5356f152a4,
+               0x5535ea0beffa9735, 0x840555a0c2c9d6ea,
+               0x36413158e41692ba,
+               0xc5cf53fb12c90ff7, 0xd2a67e48a06f7953,
+               0x86ee0bf2d4466e45, 0xaef9c54c42470e71,
+               0xa53320269da1fe28, 0x18a5681a3792fa92,
+               0xa8a54a4b0956a1bc,
+               0xb9bd5e1c70db9062, 0xcd7f6a6fa9c14711,
+               0x976d820ab8391b60, 0x461b046be15bd85c,
+               0x9cc8cce9f094a16b, 0x12475e1d3f339842,
+               0x5d82a4a0ff78c56f,
+    /* 12,5 */ 0x6ede3bb8610cdd01, 0x100db2955a5aba45,
+               0x23c4499aa62ba630, 0xb560a91013d008f6,
+               0x7ce692e3bd4fcf60, 0x9d02feaecdc21c43,
+               0x337d1f1cffa5e6bc,
+               0xa06b3d3fe71e2720, 0x60436a522b34cafe,
+               0x8240715c22a983fc, 0x27ab8076ef44eefa,
+               0x1a87576413a91459, 0x058346e77415f280,
+               0x91c4b425bf7f1b35,
+               0x7fc2a7b3d6a9c77c, 0x17fb0f5315588a61,
+               0xa4c196d9d623e0a9, 0x93dbfe1a74c0ec97,
+               0x57de5b85ea0b5686, 0xc6ad4a65990a582b,
+               0x4082ed5ae6e4a106,
+    /* 12,6 */ 0xa7687f0795a857d5, 0x18fa089ff57f644f,
+               0x83eaad61f17aba64, 0x57934e0ae21bb80b,
+               0x9cd39ebe9746c24b, 0xa0db62b06b72cfa2,
+               0x2058045d91a6064d,
+               0xde62ba33300b617d, 0x48ea24b0136a7fd4,
+               0x6707f36511b68a78, 0xba2415563f627682,
+               0xeb0a9b76eac695bf, 0xf4b15bbbf70c0b8c,
+               0xf14457ca10fe2f4e,
+               0x83d4042800c834d8, 0x39f733d6f24a31eb,
+               0xd62c510c12287d1d, 0xd26c9e80297f9c37,
+               0x968d45af763a5b65, 0x621ee7e3548fcb7e,
+               0x3da500334bbea2af,
+    /* 12,7 */ 0x2db045a048ee4c76, 0x6998d79204473ba1,
+               0xd58c4bb4bc289031, 0xdc4727e90c704525,
+               0xfdc72bc8f558dc37, 0x9a1fa8ad48d9bcf3,
+               0xf6aa0a883636a249,
+               0x09b2e82140daaa19, 0x4b0cd235697f56f1,
+               0xfcfd6f0fd88074c9, 0x5381879f36181de8,
+               0xe144a66265affda2, 0x8c071812eebdc9ee,
+               0xf9047998ea0e3a78,
+               0x400afa22b6fef149, 0xa85d0189fceddd8c,
+               0x8da117f396a5e9ac, 0x5a987bdb1de1934b,
+               0x472c53a3a1d24976, 0xd03d0f97587b5772,
+               0xffb99dcf2b639b67,
+    /* 12,8 */ 0xe095be8538700a56, 0x5a067b76fc1377b2,
+               0xd09b955de1defe99, 0x42dab6bb6d94b125,
+               0x0150114904d1c42d, 0x051a3deee7b20c39,
+               0x55a878fe6145adb3,
+               0x57345df770fc538d, 0x3d8cbd6e1b91f688,
+               0xfb97ce85f97a353f, 0xb04ef306f7013bbc,
+               0xc60ccef5ccb7589b, 0xd90559200f482bab,
+               0x7030b94096e89044,
+               0x5ccf9436844be864, 0xf1012c6d32c94e93,
+               0x795703881533d851, 0x5ff85d3f569e5889,
+               0x3d296e539f93f596, 0x45be4bf1f8816728,
+               0x29269f51466b67b3,
+    /* 13,1 */ 0xc44241f657c4bb1d, 0x37535671702f5187,
+               0xc0c0cd8a9449f397, 0xe58e280c272f772c,
+               0x3494b5ee9c1b7efe, 0x3af4731142a57b32,
+               0x80c0e1dd62cc9ef2,
+               0x3ccbc05bf675ffe3, 0x911066215cf258ce,
+               0xa69bc2c5d223928c, 0x076a9f4830e12a32,
+               0x4ed2329d5f5ef5e8, 0x81ba58a72cf27796,
+               0x38ea70d6e1b365df,
+               0x1d9f7f31d34c7e18, 0xec86573170fdcbf6,
+               0x1d9544ffddaca635, 0x8c19bf492556bece,
+               0xca08a56284dff544, 0xbe1b7050a0a6d6e8,
+               0xfb288d786960d75f,
+    /* 13,2 */ 0x835edfd25af4a11d, 0xdd313a3c53078467,
+               0xe0eef8b20086873e, 0xf3dd78c774e00ecf,
+               0x64371999f1ba65d2, 0x9be5dde9a7e8ab13,
+               0xeb146ce87a8609fa,
+               0x1c76afd6565353e9, 0xde4ffa7023dd51ba,
+               0xba7a1b7a09f2237e, 0x2b99950aca085760,
+               0x266ea5057ad97388, 0x1c4217f55e49e894,
+               0x69cfb9c5555679d0,
+               0xa5d3f14f3d559195, 0x7c52c61dac29689d,
+               0x251418c879f02b0f, 0x3c13576e5cb197fe,
+               0xe0c1966f806e6415, 0x40e773fd7bf83895,
+               0xf2eb488868be62bb,
+    /* 13,3 */ 0x3fe8e41421481e42, 0x3cec451cdbd46f7c,
+               0x364a22bff811c84f, 0x016360271f403d94,
+               0x907312dc399addb7, 0x4e33bcba39ddb4e1,
+               0x680a87a0753f2a04,
+               0x5a3aee38bc3efaa9, 0xc9ac07116778751e,
+               0x961c9c3d0aaf1af9, 0xa6f9ff84cc16ba77,
+               0xfcbda56212abd73d, 0xcec720bca4003bd7,
+               0x66b6c40cd8f66813,
+               0x1a6c3a57f1b67b33, 0x1fc6380fea06c0e5,
+               0xaea16b77a66a131c, 0xbbcfdb3147160882,
+               0xf8e6696d84613bdf, 0x79019c0a5e3c6036,
+               0x195731e42e9615ed,
+    /* 13,4 */ 0x2a4058cd45681292, 0x9315f79d4b474353,
+               0xd2583bd84e700add, 0x2d51eb774ce41e53,
+               0x379800dfe28b39fe, 0xf2c9db48fae04751,
+               0xe446f28d2f11f307,
+               0x4b2b7383084d4766, 0x48c16f0395ed6ac1,
+               0x6c684375740361bb, 0xa34b104a3685662a,
+               0x9250091c7f75472a, 0x9089407d75f23e66,
+               0xf11ea212182baf4e,
+               0xaafc2a8f24da6d54, 0x9774ae46805206d5,
+               0xe6f6d0987e38462a, 0x2eae4263bf0b39db,
+               0xc61990b3113cffbf, 0xecd0ab937b2ae75e,
+               0x196e69a54943a6bd,
+    /* 13,5 */ 0x5afc4974fb8fe549, 0xb44b90cd85c5d08e,
+               0x04067f678327ecf8, 0x164bd3654e0ef889,
+               0x7c81aeb094041a25, 0x0ccbb933f77483c6,
+               0x16fe15624ea94f2c,
+               0x8b958ecb1fad894d, 0x468e63dfc1e4d0a9,
+               0xea53559e2b19f8dd, 0x40470710cef85528,
+               0xfd385c9d9dba2c70, 0x1cce40dc9177b62e,
+               0xfe9141273cae9d69,
+               0x00ac39cd9517bd4a, 0x71587cdd94e01b4b,
+               0xec3aca1fb899f237, 0xadead12bd100ec64,
+               0x376ba9e1de6149ef, 0x28958110aae099f1,
+               0xa04cf57032d2ffa2,
+    /* 13,6 */ 0x9143356d2f08d0b0, 0x432223b11997586b,
+               0xdc2d6b81d9c0c726, 0x7b99e830260c9984,
+               0x6301eaabc030f2ea, 0x97877c76a77d87a6,
+               0x5574a5c7137181de,
+               0x4aae3cc03de39160, 0x54f696321de40ec4,
+               0xdc8e72dfbebdd7bd, 0xb29ece47846d53bc,
+               0x596c8d98128be319, 0x27e4724795341410,
+               0x083c4dd5e5836a79,
+               0xc13b8c51df0e4f44, 0x13e0a8fa742cea41,
+               0x945c1ec8fc9e33ca, 0x805beb1611b12138,
+               0x109ec67c79e15d07, 0xff45220ab8243b23,
+               0x3e8e5dbc2a77d7ba,
+    /* 13,7 */ 0xccee9d1b95ef1a35, 0x96798e21ec5ab9f1,
+               0x92043911677b5885, 0x5fdd7fdbcc2f96f0,
+               0xe44f1844e37938da, 0xcc851deba8e5e2da,
+               0xba9647db99b9e188,
+               0x7976607f0829fb9b, 0x4341da519f179a18,
+               0x8808f01e0d14870d, 0xa03cfc6e08b908d4,
+               0xc895b1521e202ee5, 0x4355a847f1a1f911,
+               0x85a40ec7c225528f,
+               0x3cf7d8e1dd737bbc, 0xae9ee9bd754e8e81,
+               0xbad008cbd318ab2a, 0x013944fac7c22ff3,
+               0xb46931c95d5b5d52, 0x0cc21f346acf1115,
+               0xc69a24d0dbd25408,
+    /* 13,8 */ 0x4c81217282561d2d, 0x03ef274c058c23b9,
+               0x6b59eeccdaebc92e, 0xd2aa4ff130e5542c,
+               0x7b7828e14153ccb0, 0xcc20af1066e7fb84,
+               0x842cfec923fdb607,
+               0xe7f5edc449d9b621, 0x5997c5e380dc1f85,
+               0x1f2bd538574ce995, 0x99bdbb5f77d9b7d2,
+               0xbdf6f1e8b590c827, 0xa642464b3db04b85,
+               0xeaf91c8a748cdd10,
+               0xc840685f72a03825, 0xef7c100474b6a3df,
+               0xec0b761b4a293c6b, 0xe9581f63b929757a,
+               0x1df5def56d6fe9fc, 0x44fcfa06b73c4787,
+               0x1cefe49d169f1bfb};
+
+#endif /* TABLE_COMB_X448_H */
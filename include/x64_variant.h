@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef X64_VARIANT_H
+#define X64_VARIANT_H
+
+/**
+ * The x64 sources are compiled once per instruction-set variant (see
+ * src/CMakeLists.txt). The baseline build uses only MULQ and keeps the
+ * plain names; the other builds define X64_VARIANT to a suffix (_bmi2,
+ * _adx) that is appended to every exported symbol, so all of them can be
+ * linked into the same library.
+ */
+#ifdef X64_VARIANT
+#define X64_CAT_(a, b) a##b
+#define X64_CAT(a, b) X64_CAT_(a, b)
+#define X64_SYMBOL(name) X64_CAT(name, X64_VARIANT)
+#else
+#define X64_SYMBOL(name) name
+#endif
+
+#ifdef X64_VARIANT
+
+#define mul2_256x256_integer_x64 X64_SYMBOL(mul2_256x256_integer_x64)
+#define sqr2_256x256_integer_x64 X64_SYMBOL(sqr2_256x256_integer_x64)
+#define red_EltFp25519_2w_x64 X64_SYMBOL(red_EltFp25519_2w_x64)
+#define mul_256x256_integer_x64 X64_SYMBOL(mul_256x256_integer_x64)
+#define sqr_256x256_integer_x64 X64_SYMBOL(sqr_256x256_integer_x64)
+#define red_EltFp25519_1w_x64 X64_SYMBOL(red_EltFp25519_1w_x64)
+#define add_EltFp25519_1w_x64 X64_SYMBOL(add_EltFp25519_1w_x64)
+#define sub_EltFp25519_1w_x64 X64_SYMBOL(sub_EltFp25519_1w_x64)
+#define mul_a24_EltFp25519_1w_x64 X64_SYMBOL(mul_a24_EltFp25519_1w_x64)
+#define ladder_step_EltFp25519_x64 X64_SYMBOL(ladder_step_EltFp25519_x64)
+#define sqrn_EltFp25519_1w_x64 X64_SYMBOL(sqrn_EltFp25519_1w_x64)
+#define inv_EltFp25519_1w_x64 X64_SYMBOL(inv_EltFp25519_1w_x64)
+#define sqrt_EltFp25519_1w_x64 X64_SYMBOL(sqrt_EltFp25519_1w_x64)
+#define inv_batch_EltFp25519_1w_x64 X64_SYMBOL(inv_batch_EltFp25519_1w_x64)
+#define fred_EltFp25519_1w_x64 X64_SYMBOL(fred_EltFp25519_1w_x64)
+
+#define mul2_448x448_integer_x64 X64_SYMBOL(mul2_448x448_integer_x64)
+#define sqr2_448x448_integer_x64 X64_SYMBOL(sqr2_448x448_integer_x64)
+#define red_EltFp448_2w_x64 X64_SYMBOL(red_EltFp448_2w_x64)
+#define mul_448x448_integer_x64 X64_SYMBOL(mul_448x448_integer_x64)
+#define sqr_448x448_integer_x64 X64_SYMBOL(sqr_448x448_integer_x64)
+#define red_EltFp448_1w_x64 X64_SYMBOL(red_EltFp448_1w_x64)
+#define add_EltFp448_1w_x64 X64_SYMBOL(add_EltFp448_1w_x64)
+#define sub_EltFp448_1w_x64 X64_SYMBOL(sub_EltFp448_1w_x64)
+#define mul_a24_EltFp448_1w_x64 X64_SYMBOL(mul_a24_EltFp448_1w_x64)
+#define sqrn_EltFp448_1w_x64 X64_SYMBOL(sqrn_EltFp448_1w_x64)
+#define inv_EltFp448_1w_x64 X64_SYMBOL(inv_EltFp448_1w_x64)
+#define sqrt_EltFp448_1w_x64 X64_SYMBOL(sqrt_EltFp448_1w_x64)
+#define inv_batch_EltFp448_1w_x64 X64_SYMBOL(inv_batch_EltFp448_1w_x64)
+#define fred_EltFp448_1w_x64 X64_SYMBOL(fred_EltFp448_1w_x64)
+
+#define X25519_x64 X64_SYMBOL(X25519_x64)
+#define X448_x64 X64_SYMBOL(X448_x64)
+#endif /* X64_VARIANT */
+
+#endif /* X64_VARIANT_H */
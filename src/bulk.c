@@ -0,0 +1,359 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rfc7748_bulk.h"
+
+#define BULK_CHUNK 64
+#define BULK_LINE_BYTES 64
+
+typedef enum {
+  BULK_X25519_KEYGEN,
+  BULK_X25519_SHARED,
+  BULK_X448_KEYGEN,
+  BULK_X448_SHARED
+} BulkOp;
+
+/**
+ * The chunks a worker has not taken yet are [begin, end), packed in range
+ * as begin | end << 32. The worker takes them from the front, and thieves
+ * take half of them from the back, both with a compare-and-swap.
+ */
+typedef struct {
+  uint64_t range;
+  pthread_t thread;
+  Rfc7748Bulk *bulk;
+  unsigned int index;
+} __attribute__((aligned(BULK_LINE_BYTES))) BulkWorker;
+
+struct Rfc7748Bulk {
+  BulkWorker *workers;
+  unsigned int num_workers;
+  int avx2;
+  pthread_mutex_t submit; /* Serializes the callers */
+  pthread_mutex_t lock;   /* Protects the fields below */
+  pthread_cond_t start;
+  pthread_cond_t done;
+  uint64_t generation;
+  unsigned int busy;
+  int running;
+  /* Job of the current generation */
+  BulkOp op;
+  argKey *output;
+  argKey *session_key;
+  argKey *private_key;
+  unsigned int n;
+};
+
+static uint64_t bulk_pack(uint32_t begin, uint32_t end) {
+  return (uint64_t)begin | (uint64_t)end << 32;
+}
+
+/* Computes the keys of one chunk, four at a time when AVX2 is available */
+static void bulk_chunk(Rfc7748Bulk *bulk, unsigned int chunk) {
+  const unsigned int first = chunk * BULK_CHUNK;
+  const unsigned int len =
+      bulk->n - first < BULK_CHUNK ? bulk->n - first : BULK_CHUNK;
+  argKey *out = bulk->output + first;
+  argKey *pk = bulk->session_key ? bulk->session_key + first : NULL;
+  argKey *sk = bulk->private_key + first;
+  unsigned int i = 0;
+
+  if (bulk->avx2) {
+    for (i = 0; i + 4 <= len; i += 4) {
+      switch (bulk->op) {
+        case BULK_X25519_KEYGEN:
+          X25519_KeyGen_4w(out + i, sk + i);
+          break;
+        case BULK_X25519_SHARED:
+          X25519_Shared_4w(out + i, pk + i, sk + i);
+          break;
+        case BULK_X448_KEYGEN:
+          X448_KeyGen_4w(out + i, sk + i);
+          break;
+        case BULK_X448_SHARED:
+          X448_Shared_4w(out + i, pk + i, sk + i);
+          break;
+      }
+    }
+  }
+  if (i < len) {
+    switch (bulk->op) {
+      case BULK_X25519_KEYGEN:
+        X25519_KeyGen_batch(out + i, sk + i, len - i);
+        break;
+      case BULK_X25519_SHARED:
+        X25519_Shared_batch(out + i, pk + i, sk + i, len - i);
+        break;
+      case BULK_X448_KEYGEN:
+        X448_KeyGen_batch(out + i, sk + i, len - i);
+        break;
+      case BULK_X448_SHARED:
+        X448_Shared_batch(out + i, pk + i, sk + i, len - i);
+        break;
+    }
+  }
+}
+
+/* Takes the first chunk left in the range of the worker */
+static int bulk_take(BulkWorker *worker, unsigned int *chunk) {
+  uint64_t range = __atomic_load_n(&worker->range, __ATOMIC_ACQUIRE);
+  for (;;) {
+    uint32_t begin = (uint32_t)range, end = (uint32_t)(range >> 32);
+    if (begin >= end) {
+      return 0;
+    }
+    if (__atomic_compare_exchange_n(&worker->range, &range,
+                                    bulk_pack(begin + 1, end), 1,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      *chunk = begin;
+      return 1;
+    }
+  }
+}
+
+/**
+ * Moves the back half of the range of another worker to the range of
+ * thief, which is empty, so that no other thread modifies it meanwhile.
+ */
+static int bulk_steal(Rfc7748Bulk *bulk, BulkWorker *thief) {
+  unsigned int i = 0;
+  for (i = 1; i < bulk->num_workers; i++) {
+    BulkWorker *victim =
+        &bulk->workers[(thief->index + i) % bulk->num_workers];
+    uint64_t range = __atomic_load_n(&victim->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+      uint32_t begin = (uint32_t)range, end = (uint32_t)(range >> 32);
+      uint32_t half = (end - begin + 1) / 2;
+      if (begin >= end) {
+        break;
+      }
+      if (__atomic_compare_exchange_n(&victim->range, &range,
+                                      bulk_pack(begin, end - half), 1,
+                                      __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&thief->range, bulk_pack(end - half, end),
+                         __ATOMIC_RELEASE);
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+/**
+ * Waits for a job, computes chunks until none is left to take or steal,
+ * and reports to bulk_submit. The last worker to finish wakes it up, so
+ * no worker still reads the ranges when the next job resets them.
+ */
+static void *bulk_worker(void *arg) {
+  BulkWorker *self = (BulkWorker *)arg;
+  Rfc7748Bulk *bulk = self->bulk;
+  uint64_t seen = 0;
+  unsigned int chunk = 0;
+
+  pthread_mutex_lock(&bulk->lock);
+  for (;;) {
+    while (bulk->running && bulk->generation == seen) {
+      pthread_cond_wait(&bulk->start, &bulk->lock);
+    }
+    if (!bulk->running) {
+      break;
+    }
+    seen = bulk->generation;
+    pthread_mutex_unlock(&bulk->lock);
+
+    do {
+      while (bulk_take(self, &chunk)) {
+        bulk_chunk(bulk, chunk);
+      }
+    } while (bulk_steal(bulk, self));
+
+    pthread_mutex_lock(&bulk->lock);
+    if (--bulk->busy == 0) {
+      pthread_cond_signal(&bulk->done);
+    }
+  }
+  pthread_mutex_unlock(&bulk->lock);
+  return NULL;
+}
+
+static void bulk_submit(Rfc7748Bulk *bulk, BulkOp op, argKey *output,
+                        argKey *session_key, argKey *private_key,
+                        unsigned int n) {
+  const uint64_t chunks = (n + (uint64_t)BULK_CHUNK - 1) / BULK_CHUNK;
+  const unsigned int num_workers = bulk->num_workers;
+  unsigned int i = 0;
+
+  if (n == 0) {
+    return;
+  }
+  pthread_mutex_lock(&bulk->submit);
+  for (i = 0; i < num_workers; i++) {
+    bulk->workers[i].range =
+        bulk_pack((uint32_t)(chunks * i / num_workers),
+                  (uint32_t)(chunks * (i + 1) / num_workers));
+  }
+  pthread_mutex_lock(&bulk->lock);
+  bulk->op = op;
+  bulk->output = output;
+  bulk->session_key = session_key;
+  bulk->private_key = private_key;
+  bulk->n = n;
+  bulk->busy = num_workers;
+  bulk->generation++;
+  pthread_cond_broadcast(&bulk->start);
+  while (bulk->busy != 0) {
+    pthread_cond_wait(&bulk->done, &bulk->lock);
+  }
+  pthread_mutex_unlock(&bulk->lock);
+  pthread_mutex_unlock(&bulk->submit);
+}
+
+/* Stops the first num_started workers and frees the engine */
+static void bulk_stop(Rfc7748Bulk *bulk, unsigned int num_started) {
+  unsigned int i = 0;
+
+  pthread_mutex_lock(&bulk->lock);
+  bulk->running = 0;
+  pthread_cond_broadcast(&bulk->start);
+  pthread_mutex_unlock(&bulk->lock);
+  for (i = 0; i < num_started; i++) {
+    pthread_join(bulk->workers[i].thread, NULL);
+  }
+  pthread_cond_destroy(&bulk->done);
+  pthread_cond_destroy(&bulk->start);
+  pthread_mutex_destroy(&bulk->lock);
+  pthread_mutex_destroy(&bulk->submit);
+  free(bulk->workers);
+  free(bulk);
+}
+
+Rfc7748Bulk *RFC7748_BulkCreate(unsigned int num_threads, int pin) {
+  Rfc7748Bulk *bulk = NULL;
+  void *memory = NULL;
+  cpu_set_t available;
+  int cpus[CPU_SETSIZE];
+  unsigned int num_cpus = 0, i = 0;
+
+  CPU_ZERO(&available);
+  if (sched_getaffinity(0, sizeof(available), &available) == 0) {
+    for (i = 0; i < CPU_SETSIZE; i++) {
+      if (CPU_ISSET(i, &available)) {
+        cpus[num_cpus++] = (int)i;
+      }
+    }
+  }
+  if (num_cpus == 0) {
+    cpus[num_cpus++] = 0;
+    pin = 0;
+  }
+
+  bulk = (Rfc7748Bulk *)calloc(1, sizeof(*bulk));
+  if (bulk == NULL) {
+    return NULL;
+  }
+  bulk->num_workers = num_threads ? num_threads : num_cpus;
+  if (posix_memalign(&memory, BULK_LINE_BYTES,
+                     bulk->num_workers * sizeof(BulkWorker)) != 0) {
+    free(bulk);
+    return NULL;
+  }
+  bulk->workers = (BulkWorker *)memory;
+  memset(bulk->workers, 0, bulk->num_workers * sizeof(BulkWorker));
+  bulk->avx2 = __builtin_cpu_supports("avx2");
+  bulk->running = 1;
+  pthread_mutex_init(&bulk->submit, NULL);
+  pthread_mutex_init(&bulk->lock, NULL);
+  pthread_cond_init(&bulk->start, NULL);
+  pthread_cond_init(&bulk->done, NULL);
+
+  for (i = 0; i < bulk->num_workers; i++) {
+    BulkWorker *worker = &bulk->workers[i];
+    pthread_attr_t attr;
+    int error = 0;
+
+    worker->bulk = bulk;
+    worker->index = i;
+    pthread_attr_init(&attr);
+    if (pin) {
+      cpu_set_t cpu;
+      CPU_ZERO(&cpu);
+      CPU_SET(cpus[i % num_cpus], &cpu);
+      pthread_attr_setaffinity_np(&attr, sizeof(cpu), &cpu);
+    }
+    error = pthread_create(&worker->thread, &attr, bulk_worker, worker);
+    pthread_attr_destroy(&attr);
+    if (error != 0) {
+      bulk_stop(bulk, i);
+      return NULL;
+    }
+  }
+  return bulk;
+}
+
+void RFC7748_BulkDestroy(Rfc7748Bulk *bulk) {
+  if (bulk != NULL) {
+    bulk_stop(bulk, bulk->num_workers);
+  }
+}
+
+unsigned int RFC7748_BulkThreads(Rfc7748Bulk *bulk) {
+  return bulk->num_workers;
+}
+
+void RFC7748_BulkX25519_KeyGen(Rfc7748Bulk *bulk, argKey *session_key,
+                               argKey *private_key, unsigned int n) {
+  bulk_submit(bulk, BULK_X25519_KEYGEN, session_key, NULL, private_key, n);
+}
+
+void RFC7748_BulkX25519_Shared(Rfc7748Bulk *bulk, argKey *shared,
+                               argKey *session_key, argKey *private_key,
+                               unsigned int n) {
+  bulk_submit(bulk, BULK_X25519_SHARED, shared, session_key, private_key, n);
+}
+
+void RFC7748_BulkX448_KeyGen(Rfc7748Bulk *bulk, argKey *session_key,
+                             argKey *private_key, unsigned int n) {
+  bulk_submit(bulk, BULK_X448_KEYGEN, session_key, NULL, private_key, n);
+}
+
+void RFC7748_BulkX448_Shared(Rfc7748Bulk *bulk, argKey *shared,
+                             argKey *session_key, argKey *private_key,
+                             unsigned int n) {
+  bulk_submit(bulk, BULK_X448_SHARED, shared, session_key, private_key, n);
+}
@@ -0,0 +1,261 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <cpuid.h>
+#include <stddef.h>
+#include "rfc7748_x64.h"
+#include "safegcd_x64.h"
+#include "x25519_avx2.h"
+#include "x448_avx2.h"
+
+/**
+ * The exported function pointers are constants, so they point to the
+ * trampolines below, which call the variant selected at load time. Until
+ * then, the MULQ variant is used because it runs on any processor.
+ */
+const X64Functions *x25519_impl_x64 = &X25519_x64;
+const X64Functions *x448_impl_x64 = &X448_x64;
+static Rfc7748Impl current_impl = RFC7748_IMPL_MULQ;
+
+Rfc7748Table keygen_table_x64 = RFC7748_TABLE_LADDER;
+
+#define CPUID_7_EBX_BMI2 (1 << 8)
+#define CPUID_7_EBX_ADX (1 << 19)
+
+int RFC7748_HasImpl(Rfc7748Impl impl) {
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (impl == RFC7748_IMPL_AUTO || impl == RFC7748_IMPL_MULQ) {
+    return 1;
+  }
+  if (__get_cpuid_max(0, NULL) >= 7) {
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  }
+  switch (impl) {
+    case RFC7748_IMPL_BMI2:
+      return (ebx & CPUID_7_EBX_BMI2) != 0;
+    case RFC7748_IMPL_ADX:
+      return (ebx & CPUID_7_EBX_BMI2) != 0 && (ebx & CPUID_7_EBX_ADX) != 0;
+    default:
+      return 0;
+  }
+}
+
+int RFC7748_SetImpl(Rfc7748Impl impl) {
+  if (impl == RFC7748_IMPL_AUTO) {
+    impl = RFC7748_HasImpl(RFC7748_IMPL_ADX)
+               ? RFC7748_IMPL_ADX
+               : RFC7748_HasImpl(RFC7748_IMPL_BMI2) ? RFC7748_IMPL_BMI2
+                                                    : RFC7748_IMPL_MULQ;
+  }
+  if (!RFC7748_HasImpl(impl)) {
+    return -1;
+  }
+  switch (impl) {
+    case RFC7748_IMPL_ADX:
+      x25519_impl_x64 = &X25519_x64_adx;
+      x448_impl_x64 = &X448_x64_adx;
+      break;
+    case RFC7748_IMPL_BMI2:
+      x25519_impl_x64 = &X25519_x64_bmi2;
+      x448_impl_x64 = &X448_x64_bmi2;
+      break;
+    default:
+      x25519_impl_x64 = &X25519_x64;
+      x448_impl_x64 = &X448_x64;
+      break;
+  }
+  current_impl = impl;
+  return 0;
+}
+
+Rfc7748Impl RFC7748_GetImpl(void) { return current_impl; }
+
+void RFC7748_SetInv(Rfc7748Inv inv) {
+  inv_safegcd_x64 = (inv == RFC7748_INV_SAFEGCD);
+}
+
+Rfc7748Inv RFC7748_GetInv(void) {
+  return inv_safegcd_x64 ? RFC7748_INV_SAFEGCD : RFC7748_INV_FERMAT;
+}
+
+int RFC7748_SetTable(Rfc7748Table table) {
+  if (table < RFC7748_TABLE_LADDER || table > RFC7748_TABLE_COMB) {
+    return -1;
+  }
+  keygen_table_x64 = table;
+  return 0;
+}
+
+Rfc7748Table RFC7748_GetTable(void) { return keygen_table_x64; }
+
+size_t RFC7748_X25519_TableMemory(const void **table) {
+  *table = x25519_impl_x64->tables[keygen_table_x64];
+  return x25519_impl_x64->table_sizes[keygen_table_x64];
+}
+
+size_t RFC7748_X448_TableMemory(const void **table) {
+  *table = x448_impl_x64->tables[keygen_table_x64];
+  return x448_impl_x64->table_sizes[keygen_table_x64];
+}
+
+__attribute__((constructor)) static void select_impl(void) {
+  RFC7748_SetImpl(RFC7748_IMPL_AUTO);
+}
+
+static void x25519_keygen(argKey session_key, argKey private_key) {
+  x25519_impl_x64->keygen(session_key, private_key);
+}
+
+static void x25519_shared(argKey shared, argKey session_key,
+                          argKey private_key) {
+  x25519_impl_x64->shared(shared, session_key, private_key);
+}
+
+static void x25519_keygen_batch(argKey *session_key, argKey *private_key,
+                                unsigned int n) {
+  x25519_impl_x64->keygen_batch(session_key, private_key, n);
+}
+
+static void x25519_shared_batch(argKey *shared, argKey *session_key,
+                                argKey *private_key, unsigned int n) {
+  x25519_impl_x64->shared_batch(shared, session_key, private_key, n);
+}
+
+static void x25519_precompute(argPeerTable table, argKey session_key) {
+  x25519_impl_x64->precompute(table, session_key);
+}
+
+static void x25519_shared_peer(argKey shared, argPeerTable table,
+                               argKey private_key) {
+  x25519_impl_x64->shared_peer(shared, table, private_key);
+}
+
+/**
+ * Computes four public keys; it uses the AVX2 ladder whenever the
+ * processor supports it and otherwise falls back to the x64 variant.
+ */
+static void x25519_keygen_4w(argKey *session_key, argKey *private_key) {
+  int i = 0;
+  if (__builtin_cpu_supports("avx2")) {
+    x25519_keygen_precmp_4w_avx2(session_key, private_key);
+    return;
+  }
+  for (i = 0; i < 4; i++) {
+    x25519_impl_x64->keygen(session_key[i], private_key[i]);
+  }
+}
+
+/**
+ * Computes four shared secrets; it uses the AVX2 ladder whenever the
+ * processor supports it and otherwise falls back to the x64 variant.
+ */
+static void x25519_shared_4w(argKey *shared, argKey *session_key,
+                             argKey *private_key) {
+  int i = 0;
+  if (__builtin_cpu_supports("avx2")) {
+    x25519_shared_secret_4w_avx2(shared, session_key, private_key);
+    return;
+  }
+  for (i = 0; i < 4; i++) {
+    x25519_impl_x64->shared(shared[i], session_key[i], private_key[i]);
+  }
+}
+
+static void x448_keygen(argKey public_key, argKey private_key) {
+  x448_impl_x64->keygen(public_key, private_key);
+}
+
+static void x448_shared(argKey shared, argKey session_key,
+                        argKey private_key) {
+  x448_impl_x64->shared(shared, session_key, private_key);
+}
+
+static void x448_keygen_batch(argKey *public_key, argKey *private_key,
+                              unsigned int n) {
+  x448_impl_x64->keygen_batch(public_key, private_key, n);
+}
+
+static void x448_shared_batch(argKey *shared, argKey *session_key,
+                              argKey *private_key, unsigned int n) {
+  x448_impl_x64->shared_batch(shared, session_key, private_key, n);
+}
+
+static void x448_precompute(argPeerTable table, argKey session_key) {
+  x448_impl_x64->precompute(table, session_key);
+}
+
+static void x448_shared_peer(argKey shared, argPeerTable table,
+                             argKey private_key) {
+  x448_impl_x64->shared_peer(shared, table, private_key);
+}
+
+static void x448_keygen_4w(argKey *public_key, argKey *private_key) {
+  int i = 0;
+  if (__builtin_cpu_supports("avx2")) {
+    x448_keygen_4w_avx2(public_key, private_key);
+    return;
+  }
+  for (i = 0; i < 4; i++) {
+    x448_impl_x64->keygen(public_key[i], private_key[i]);
+  }
+}
+
+static void x448_shared_4w(argKey *shared, argKey *session_key,
+                           argKey *private_key) {
+  int i = 0;
+  if (__builtin_cpu_supports("avx2")) {
+    x448_shared_4w_avx2(shared, session_key, private_key);
+    return;
+  }
+  for (i = 0; i < 4; i++) {
+    x448_impl_x64->shared(shared[i], session_key[i], private_key[i]);
+  }
+}
+
+const KeyGen X25519_KeyGen = x25519_keygen;
+const Shared X25519_Shared = x25519_shared;
+const KeyGenBatch X25519_KeyGen_batch = x25519_keygen_batch;
+const SharedBatch X25519_Shared_batch = x25519_shared_batch;
+const KeyGen4w X25519_KeyGen_4w = x25519_keygen_4w;
+const Shared4w X25519_Shared_4w = x25519_shared_4w;
+const Precompute X25519_Precompute = x25519_precompute;
+const SharedPeer X25519_Shared_peer = x25519_shared_peer;
+const KeyGen X448_KeyGen = x448_keygen;
+const Shared X448_Shared = x448_shared;
+const KeyGenBatch X448_KeyGen_batch = x448_keygen_batch;
+const SharedBatch X448_Shared_batch = x448_shared_batch;
+const KeyGen4w X448_KeyGen_4w = x448_keygen_4w;
+const Shared4w X448_Shared_4w = x448_shared_4w;
+const Precompute X448_Precompute = x448_precompute;
+const SharedPeer X448_Shared_peer = x448_shared_peer;
@@ -0,0 +1,360 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "fp25519_avx2.h"
+#include <immintrin.h>
+
+#define LOAD(A, I) _mm256_load_si256((__m256i *)(A) + (I))
+#define STORE(C, I, X) _mm256_store_si256((__m256i *)(C) + (I), (X))
+/* Full unrolling resolves the digit-dependent branches at compile time */
+#define UNROLL _Pragma("GCC unroll 16")
+#define BITS(I) ((I)&1 ? 25 : 26)
+
+/* Position of the least significant bit of each digit */
+static const int pos_Fp25519_avx2[NUM_DIGITS_FP25519_AVX2] = {
+    0, 26, 51, 77, 102, 128, 153, 179, 204, 230};
+
+/* Splits an EltFp25519_1w_x64 element into ten digits */
+static inline void digits_EltFp25519_avx2(uint64_t *const d,
+                                          const uint64_t *const A) {
+  int i = 0;
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    const int w = pos_Fp25519_avx2[i] / 64;
+    const int s = pos_Fp25519_avx2[i] % 64;
+    uint64_t digit = A[w] >> s;
+    if (s + BITS(i) > 64) {
+      digit |= A[w + 1] << (64 - s);
+    }
+    d[i] = digit & (((uint64_t)1 << BITS(i)) - 1);
+  }
+  /* 2^255 = 19 */
+  d[0] += 19 * (A[3] >> 63);
+}
+
+/**
+ * Converts four elements of GF(2^255-19) from the 1w_x64 representation.
+ * @param c Four elements in radix 2^25.5.
+ * @param a Four consecutive EltFp25519_1w_x64 elements (16 words).
+ */
+void load_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  uint64_t d[NUM_DIGITS_FP25519_AVX2];
+  int i = 0, j = 0;
+  UNROLL
+  for (j = 0; j < 4; j++) {
+    digits_EltFp25519_avx2(d, a + 4 * j);
+    UNROLL
+    for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+      c[4 * i + j] = d[i];
+    }
+  }
+}
+
+/**
+ * Copies one element of GF(2^255-19) in the 1w_x64 representation to the
+ * four lanes of C.
+ */
+void broadcast_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  uint64_t d[NUM_DIGITS_FP25519_AVX2];
+  int i = 0;
+  digits_EltFp25519_avx2(d, a);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    STORE(c, i, _mm256_set1_epi64x(d[i]));
+  }
+}
+
+/**
+ * Converts four elements of GF(2^255-19) to the 1w_x64 representation.
+ * The input must have its carries propagated, i.e. be the output of a
+ * multiplication, squaring, carry or load, so that it fits in 256 bits.
+ * @param c Four consecutive EltFp25519_1w_x64 elements (16 words).
+ * @param a Four elements in radix 2^25.5.
+ */
+void store_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  int i = 0, j = 0, k = 0;
+  UNROLL
+  for (j = 0; j < 4; j++) {
+    uint64_t C[5] = {0, 0, 0, 0, 0};
+    UNROLL
+    for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+      const int w = pos_Fp25519_avx2[i] / 64;
+      const int s = pos_Fp25519_avx2[i] % 64;
+      const uint64_t digit = a[4 * i + j];
+      uint64_t lo = digit << s;
+      uint64_t hi = s == 0 ? 0 : digit >> (64 - s);
+      C[w] += lo;
+      hi += C[w] < lo;
+      UNROLL
+      for (k = w + 1; k < 5; k++) {
+        C[k] += hi;
+        hi = C[k] < hi;
+      }
+    }
+    c[4 * j + 0] = C[0];
+    c[4 * j + 1] = C[1];
+    c[4 * j + 2] = C[2];
+    c[4 * j + 3] = C[3];
+  }
+}
+
+void add_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a,
+                            uint64_t *const b) {
+  int i = 0;
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    STORE(c, i, _mm256_add_epi64(LOAD(a, i), LOAD(b, i)));
+  }
+}
+
+/**
+ * Computes C = A-B+2p, so digits remain non-negative. B must be the
+ * output of a multiplication, squaring, carry or load.
+ */
+void sub_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a,
+                            uint64_t *const b) {
+  int i = 0;
+  const __m256i two_p0 = _mm256_set1_epi64x(((uint64_t)1 << 27) - 38);
+  const __m256i two_p_even = _mm256_set1_epi64x(((uint64_t)1 << 27) - 2);
+  const __m256i two_p_odd = _mm256_set1_epi64x(((uint64_t)1 << 26) - 2);
+
+  STORE(c, 0, _mm256_sub_epi64(_mm256_add_epi64(LOAD(a, 0), two_p0),
+                               LOAD(b, 0)));
+  UNROLL
+  for (i = 1; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    const __m256i two_p = i & 1 ? two_p_odd : two_p_even;
+    STORE(c, i, _mm256_sub_epi64(_mm256_add_epi64(LOAD(a, i), two_p),
+                                 LOAD(b, i)));
+  }
+}
+
+/**
+ * Carry propagation of 64-bit digits in the same order as in ref10.
+ * For digits below 2^63, on output even (odd) digits have at most 26
+ * (25) bits, except digits 1 and 5 that may exceed 2^25 by up to 2^17
+ * and 2^13, since they receive the carries of digits 0 and 4 after
+ * their own.
+ */
+static inline void carry_Fp25519_4w_avx2(__m256i *const h) {
+  static const int order[12] = {0, 4, 1, 5, 2, 6, 3, 7, 4, 8, 9, 0};
+  const __m256i mask26 = _mm256_set1_epi64x(((uint64_t)1 << 26) - 1);
+  const __m256i mask25 = _mm256_set1_epi64x(((uint64_t)1 << 25) - 1);
+  int k = 0;
+
+  UNROLL
+  for (k = 0; k < 12; k++) {
+    const int i = order[k];
+    __m256i c;
+    if (i & 1) {
+      c = _mm256_srli_epi64(h[i], 25);
+      h[i] = _mm256_and_si256(h[i], mask25);
+    } else {
+      c = _mm256_srli_epi64(h[i], 26);
+      h[i] = _mm256_and_si256(h[i], mask26);
+    }
+    if (i == 9) {
+      /* 2^255 = 19 = 16+2+1 */
+      c = _mm256_add_epi64(_mm256_add_epi64(c, _mm256_slli_epi64(c, 1)),
+                           _mm256_slli_epi64(c, 4));
+      h[0] = _mm256_add_epi64(h[0], c);
+    } else {
+      h[i + 1] = _mm256_add_epi64(h[i + 1], c);
+    }
+  }
+}
+
+/**
+ * Propagates the carries of C, so that it can be used as the subtrahend
+ * of sub_EltFp25519_4w_avx2 or stored.
+ */
+void carry_EltFp25519_4w_avx2(uint64_t *const c) {
+  __m256i h[NUM_DIGITS_FP25519_AVX2];
+  int i = 0;
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    h[i] = LOAD(c, i);
+  }
+  carry_Fp25519_4w_avx2(h);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    STORE(c, i, h[i]);
+  }
+}
+
+/**
+ * Schoolbook multiplication with products accumulated in 64-bit lanes.
+ * vpmuludq reads only the low 32 bits of 2*a[i] and 19*b[j], so every
+ * input digit must be below 2^32/19 (about 3.37*2^26).
+ *
+ * The ladders of x25519_avx2.c pass outputs of mul, sqr, mul_a24, carry
+ * or load, or one add or sub (+2p) of two of them. Outputs have digits up
+ * to 2^26 (2^25 odd), except digit 0 (2^26+18 after load) and digits 1
+ * and 5 (2^25+2^11), so inputs stay below 3*2^26 for even digits and
+ * 3*2^25+2^11 for odd ones. That leaves 2^24 of headroom below 2^32/19,
+ * and the accumulators stay below 2^63. A longer chain of adds needs a
+ * carry first.
+ */
+void mul_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a,
+                            uint64_t *const b) {
+  __m256i f[NUM_DIGITS_FP25519_AVX2], f2[NUM_DIGITS_FP25519_AVX2];
+  __m256i g[NUM_DIGITS_FP25519_AVX2], g19[NUM_DIGITS_FP25519_AVX2];
+  __m256i h[NUM_DIGITS_FP25519_AVX2];
+  const __m256i nineteen = _mm256_set1_epi64x(19);
+  int i = 0, j = 0;
+
+  UNROLL
+
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    f[i] = LOAD(a, i);
+    f2[i] = _mm256_add_epi64(f[i], f[i]);
+    g[i] = LOAD(b, i);
+    g19[i] = _mm256_mul_epu32(g[i], nineteen);
+    h[i] = _mm256_setzero_si256();
+  }
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    UNROLL
+    for (j = 0; j < NUM_DIGITS_FP25519_AVX2; j++) {
+      const int k = i + j;
+      /* 2^(25.5*(i+j)) carries an extra factor 2 when i and j are odd */
+      const __m256i fi = (i & j & 1) ? f2[i] : f[i];
+      if (k < NUM_DIGITS_FP25519_AVX2) {
+        h[k] = _mm256_add_epi64(h[k], _mm256_mul_epu32(fi, g[j]));
+      } else {
+        h[k - NUM_DIGITS_FP25519_AVX2] =
+            _mm256_add_epi64(h[k - NUM_DIGITS_FP25519_AVX2],
+                             _mm256_mul_epu32(fi, g19[j]));
+      }
+    }
+  }
+  carry_Fp25519_4w_avx2(h);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    STORE(c, i, h[i]);
+  }
+}
+
+/**
+ * Squaring; it computes the 55 distinct cross products only.
+ * Same input bounds as mul_EltFp25519_4w_avx2.
+ */
+void sqr_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  __m256i f[NUM_DIGITS_FP25519_AVX2], f2[NUM_DIGITS_FP25519_AVX2];
+  __m256i f19[NUM_DIGITS_FP25519_AVX2];
+  __m256i h[NUM_DIGITS_FP25519_AVX2];
+  const __m256i nineteen = _mm256_set1_epi64x(19);
+  int i = 0, j = 0;
+
+  UNROLL
+
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    f[i] = LOAD(a, i);
+    f2[i] = _mm256_add_epi64(f[i], f[i]);
+    f19[i] = _mm256_mul_epu32(f[i], nineteen);
+    h[i] = _mm256_setzero_si256();
+  }
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    /* Square terms */
+    const int k = 2 * i;
+    const __m256i fi = (i & 1) ? f2[i] : f[i];
+    if (k < NUM_DIGITS_FP25519_AVX2) {
+      h[k] = _mm256_add_epi64(h[k], _mm256_mul_epu32(fi, f[i]));
+    } else {
+      h[k - NUM_DIGITS_FP25519_AVX2] =
+          _mm256_add_epi64(h[k - NUM_DIGITS_FP25519_AVX2],
+                           _mm256_mul_epu32(fi, f19[i]));
+    }
+    /* Cross terms appear twice */
+    UNROLL
+    for (j = i + 1; j < NUM_DIGITS_FP25519_AVX2; j++) {
+      const int l = i + j;
+      const int both_odd = i & j & 1;
+      if (l < NUM_DIGITS_FP25519_AVX2) {
+        const __m256i fj = both_odd ? f2[j] : f[j];
+        h[l] = _mm256_add_epi64(h[l], _mm256_mul_epu32(f2[i], fj));
+      } else {
+        __m256i t = _mm256_mul_epu32(f2[i], f19[j]);
+        if (both_odd) {
+          t = _mm256_slli_epi64(t, 1);
+        }
+        h[l - NUM_DIGITS_FP25519_AVX2] =
+            _mm256_add_epi64(h[l - NUM_DIGITS_FP25519_AVX2], t);
+      }
+    }
+  }
+  carry_Fp25519_4w_avx2(h);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    STORE(c, i, h[i]);
+  }
+}
+
+/**
+ * Multiplication by a24 = (A+2)/4 = (486662+2)/4 = 121666
+ **/
+void mul_a24_EltFp25519_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  __m256i h[NUM_DIGITS_FP25519_AVX2];
+  const __m256i a24 = _mm256_set1_epi64x(121666);
+  int i = 0;
+
+  UNROLL
+
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    h[i] = _mm256_mul_epu32(LOAD(a, i), a24);
+  }
+  carry_Fp25519_4w_avx2(h);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    STORE(c, i, h[i]);
+  }
+}
+
+/**
+ * Swaps A and B in the lanes where MASK is all-ones.
+ * @param mask Four 64-bit words, each one either zero or all-ones.
+ */
+void cswap_EltFp25519_4w_avx2(uint64_t *const mask, uint64_t *const a,
+                              uint64_t *const b) {
+  const __m256i m = LOAD(mask, 0);
+  int i = 0;
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP25519_AVX2; i++) {
+    const __m256i A = LOAD(a, i);
+    const __m256i B = LOAD(b, i);
+    const __m256i t = _mm256_and_si256(m, _mm256_xor_si256(A, B));
+    STORE(a, i, _mm256_xor_si256(A, t));
+    STORE(b, i, _mm256_xor_si256(B, t));
+  }
+}
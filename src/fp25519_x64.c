@@ -35,6 +35,8 @@
  */
 
 #include "fp25519_x64.h"
+#include "fp25519_x64_inline.h"
+#include "safegcd_x64.h"
 
 /**
  *
@@ -1142,136 +1144,987 @@ void red_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a) {
 #endif
 }
 
-inline void add_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a, uint64_t *const b) {
-#ifdef __ADX__
-  __asm__ __volatile__(
-    "mov     $38, %%eax ;"
-    "xorl  %%ecx, %%ecx ;"
-    "movq   (%2),  %%r8 ;"  "adcx   (%1),  %%r8 ;"
-    "movq  8(%2),  %%r9 ;"  "adcx  8(%1),  %%r9 ;"
-    "movq 16(%2), %%r10 ;"  "adcx 16(%1), %%r10 ;"
-    "movq 24(%2), %%r11 ;"  "adcx 24(%1), %%r11 ;"
-    "cmovc %%eax, %%ecx ;"
-    "xorl %%eax, %%eax  ;"
-    "adcx %%rcx,  %%r8  ;"
-    "adcx %%rax,  %%r9  ;"  "movq  %%r9,  8(%0) ;"
-    "adcx %%rax, %%r10  ;"  "movq %%r10, 16(%0) ;"
-    "adcx %%rax, %%r11  ;"  "movq %%r11, 24(%0) ;"
-    "mov     $38, %%ecx ;"
-    "cmovc %%ecx, %%eax ;"
-    "addq %%rax,  %%r8  ;"  "movq  %%r8,   (%0) ;"
-  :
-  : "r" (c), "r" (a), "r" (b)
-  : "memory", "cc", "%rax", "%rcx", "%r8", "%r9", "%r10", "%r11"
-  );
-#else
-  __asm__ __volatile__(
-    "mov     $38, %%eax ;"
-    "movq   (%2),  %%r8 ;"  "addq   (%1),  %%r8 ;"
-    "movq  8(%2),  %%r9 ;"  "adcq  8(%1),  %%r9 ;"
-    "movq 16(%2), %%r10 ;"  "adcq 16(%1), %%r10 ;"
-    "movq 24(%2), %%r11 ;"  "adcq 24(%1), %%r11 ;"
-    "mov      $0, %%ecx ;"
-    "cmovc %%eax, %%ecx ;"
-    "addq %%rcx,  %%r8  ;"
-    "adcq    $0,  %%r9  ;"  "movq  %%r9,  8(%0) ;"
-    "adcq    $0, %%r10  ;"  "movq %%r10, 16(%0) ;"
-    "adcq    $0, %%r11  ;"  "movq %%r11, 24(%0) ;"
-    "mov     $0, %%ecx  ;"
-    "cmovc %%eax, %%ecx ;"
-    "addq %%rcx,  %%r8  ;"  "movq  %%r8,   (%0) ;"
-  :
-  : "r" (c), "r" (a), "r" (b)
-  : "memory", "cc", "%rax", "%rcx", "%r8", "%r9", "%r10", "%r11"
-  );
-#endif
+void add_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a,
+                           uint64_t *const b) {
+  add_EltFp25519_1w_x64_inline(c, a, b);
 }
 
-inline void sub_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a, uint64_t *const b) {
-  __asm__ __volatile__(
-    "mov     $38, %%eax ;"
-    "movq   (%1),  %%r8 ;"  "subq   (%2),  %%r8 ;"
-    "movq  8(%1),  %%r9 ;"  "sbbq  8(%2),  %%r9 ;"
-    "movq 16(%1), %%r10 ;"  "sbbq 16(%2), %%r10 ;"
-    "movq 24(%1), %%r11 ;"  "sbbq 24(%2), %%r11 ;"
-    "mov      $0, %%ecx ;"
-    "cmovc %%eax, %%ecx ;"
-    "subq %%rcx,  %%r8  ;"
-    "sbbq    $0,  %%r9  ;"  "movq  %%r9,  8(%0) ;"
-    "sbbq    $0, %%r10  ;"  "movq %%r10, 16(%0) ;"
-    "sbbq    $0, %%r11  ;"  "movq %%r11, 24(%0) ;"
-    "mov     $0, %%ecx  ;"
-    "cmovc %%eax, %%ecx ;"
-    "subq %%rcx,  %%r8  ;"  "movq  %%r8,   (%0) ;"
-  :
-  : "r" (c), "r" (a), "r" (b)
-  : "memory", "cc", "%rax", "%rcx", "%r8", "%r9", "%r10", "%r11"
-  );
+void sub_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a,
+                           uint64_t *const b) {
+  sub_EltFp25519_1w_x64_inline(c, a, b);
+}
+
+void mul_a24_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a) {
+  mul_a24_EltFp25519_1w_x64_inline(c, a);
 }
 
 /**
- * Multiplication by a24 = (A+2)/4 = (486662+2)/4 = 121666
+ * One step of the Montgomery ladder. P = [X2|Z2|X3|Z3] holds both points
+ * and X1 their difference; (X2:Z2) is replaced by the double of (X2:Z2),
+ * or of (X3:Z3) if swap = 1, and (X3:Z3) by the sum of both points.
+ * With MULX, the whole step is one asm block: the additions are fused in
+ * pairs and each product is reduced in registers, so it neither calls
+ * other functions nor writes 512-bit buffers.
  **/
-inline void mul_a24_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a) {
-  const uint64_t a24 = 121666;
+void ladder_step_EltFp25519_x64(uint64_t *const P, uint64_t *const X1,
+                                uint64_t swap) {
 #ifdef __BMI2__
+  /**
+   * [A|B|C|D|DA|T], where T holds the lower half of each product. The
+   * same code serves ADX: with the step bound by MULX throughput, the
+   * ADCX/ADOX multipliers were not faster here.
+   */
+  ALIGN uint64_t workspace[6 * NUM_WORDS_ELTFP25519_X64];
   __asm__ __volatile__(
-    "movq     %2, %%rdx ;"
-    "mulx   (%1),  %%r8, %%r10 ;"
-    "mulx  8(%1),  %%r9, %%r11 ;"  "addq %%r10,  %%r9 ;"
-    "mulx 16(%1), %%r10, %%rax ;"  "adcq %%r11, %%r10 ;"
-    "mulx 24(%1), %%r11, %%rcx ;"  "adcq %%rax, %%r11 ;"
-    /***************************/  "adcq    $0, %%rcx ;"
-    "movl   $38, %%edx ;" /* 2*c = 38 = 2^256 mod 2^255-19*/
-    "imul %%rdx, %%rcx ;"
-    "addq %%rcx,  %%r8 ;"
-    "adcq    $0,  %%r9 ;"  "movq  %%r9,  8(%0) ;"
-    "adcq    $0, %%r10 ;"  "movq %%r10, 16(%0) ;"
-    "adcq    $0, %%r11 ;"  "movq %%r11, 24(%0) ;"
-    "mov     $0, %%ecx ;"
-    "cmovc %%edx, %%ecx ;"
-    "addq %%rcx,  %%r8 ;"  "movq  %%r8,   (%0) ;"
-  :
-  : "r" (c), "r" (a), "r" (a24)
-  : "memory", "cc", "%rax", "%rcx", "%rdx", "%r8", "%r9", "%r10", "%r11"
-  );
-#else /* Without BMI2 */
-  __asm__ __volatile__(
-  "movq %2, %%rax;" "mulq  0(%1);" "movq %%rax,  %%r8;" "movq %%rdx,  %%r9;"
-  "movq %2, %%rax;" "mulq  8(%1);" "movq %%rax, %%r12;" "movq %%rdx, %%r10;"
-  "movq %2, %%rax;" "mulq 16(%1);" "movq %%rax, %%r13;" "movq %%rdx, %%r11;"
-  "movq %2, %%rax;" "mulq 24(%1);"
-  "addq %%r12,  %%r9;"
-  "adcq %%r13, %%r10;"
-  "adcq %%rax, %%r11;"
-  "adcq    $0, %%rdx;"
-  "movl   $38, %%eax;" /* 2*c = 38 = 2^256 mod 2^255-19*/
-  "imulq %%rax, %%rdx;"
-  "addq %%rdx, %%r8;"
-  "adcq $0,  %%r9;"  "movq  %%r9,  8(%0);"
-  "adcq $0, %%r10;"  "movq %%r10, 16(%0);"
-  "adcq $0, %%r11;"  "movq %%r11, 24(%0);"
-  "movq $0, %%rdx;"
-  "cmovc %%rax, %%rdx;"
-  "addq %%rdx, %%r8;" "movq %%r8,  0(%0);"
+    /* A = X2+Z2, B = X2-Z2 */
+    "movl      $38,  %%eax ;"
+    "movq     (%0),   %%r8 ;"
+    "movq    8(%0),  %%r10 ;"
+    "movq   16(%0),   %%r9 ;"
+    "movq   24(%0),  %%r11 ;"
+    "movq     %%r8,  %%r12 ;"
+    "movq    %%r10,  %%r13 ;"
+    "movq     %%r9,  %%r14 ;"
+    "movq    %%r11,  %%rbx ;"
+    "addq   32(%0),   %%r8 ;"
+    "adcq   40(%0),  %%r10 ;"
+    "adcq   48(%0),   %%r9 ;"
+    "adcq   56(%0),  %%r11 ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "addq    %%rcx,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "addq    %%rcx,   %%r8 ;"
+    "subq   32(%0),  %%r12 ;"
+    "sbbq   40(%0),  %%r13 ;"
+    "sbbq   48(%0),  %%r14 ;"
+    "sbbq   56(%0),  %%rbx ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "subq    %%rcx,  %%r12 ;"
+    "sbbq       $0,  %%r13 ;"
+    "sbbq       $0,  %%r14 ;"
+    "sbbq       $0,  %%rbx ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "subq    %%rcx,  %%r12 ;"
+    "movq     %%r8,   (%1) ;"
+    "movq    %%r10,  8(%1) ;"
+    "movq     %%r9, 16(%1) ;"
+    "movq    %%r11, 24(%1) ;"
+    "movq    %%r12, 32(%1) ;"
+    "movq    %%r13, 40(%1) ;"
+    "movq    %%r14, 48(%1) ;"
+    "movq    %%rbx, 56(%1) ;"
+
+    /* C = X3+Z3, D = X3-Z3 */
+    "movl      $38,  %%eax ;"
+    "movq   64(%0),   %%r8 ;"
+    "movq   72(%0),  %%r10 ;"
+    "movq   80(%0),   %%r9 ;"
+    "movq   88(%0),  %%r11 ;"
+    "movq     %%r8,  %%r12 ;"
+    "movq    %%r10,  %%r13 ;"
+    "movq     %%r9,  %%r14 ;"
+    "movq    %%r11,  %%rbx ;"
+    "addq   96(%0),   %%r8 ;"
+    "adcq  104(%0),  %%r10 ;"
+    "adcq  112(%0),   %%r9 ;"
+    "adcq  120(%0),  %%r11 ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "addq    %%rcx,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "addq    %%rcx,   %%r8 ;"
+    "subq   96(%0),  %%r12 ;"
+    "sbbq  104(%0),  %%r13 ;"
+    "sbbq  112(%0),  %%r14 ;"
+    "sbbq  120(%0),  %%rbx ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "subq    %%rcx,  %%r12 ;"
+    "sbbq       $0,  %%r13 ;"
+    "sbbq       $0,  %%r14 ;"
+    "sbbq       $0,  %%rbx ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "subq    %%rcx,  %%r12 ;"
+    "movq     %%r8, 64(%1) ;"
+    "movq    %%r10, 72(%1) ;"
+    "movq     %%r9, 80(%1) ;"
+    "movq    %%r11, 88(%1) ;"
+    "movq    %%r12, 96(%1) ;"
+    "movq    %%r13, 104(%1) ;"
+    "movq    %%r14, 112(%1) ;"
+    "movq    %%rbx, 120(%1) ;"
+
+    /* DA = D*A */
+    "movq   96(%1),  %%rdx ;"          /* A[0] */
+    "mulx     (%1),   %%r8,  %%r12 ;"  /* A[0]*B[0] */ "movq     %%r8, 160(%1) ;"
+    "mulx    8(%1),  %%r10,  %%rax ;"  /* A[0]*B[1] */ "addq    %%r10,  %%r12 ;"
+    "mulx   16(%1),   %%r8,  %%rbx ;"  /* A[0]*B[2] */ "adcq     %%r8,  %%rax ;"
+    "mulx   24(%1),  %%r10,  %%rcx ;"  /* A[0]*B[3] */ "adcq    %%r10,  %%rbx ;"
+    "adcq       $0,  %%rcx ;"
+    "movq  104(%1),  %%rdx ;"          /* A[1] */
+    "mulx     (%1),   %%r8,   %%r9 ;"  /* A[1]*B[0] */ "addq    %%r12,   %%r8 ;"
+    "movq     %%r8, 168(%1) ;"
+    "mulx    8(%1),  %%r10,  %%r11 ;"  /* A[1]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   16(%1),   %%r8,  %%r13 ;"  /* A[1]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   24(%1),  %%r10,  %%r12 ;"  /* A[1]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%r12 ;"
+    "addq     %%r9,  %%rax ;"
+    "adcq    %%r11,  %%rbx ;"
+    "adcq    %%r13,  %%rcx ;"
+    "adcq       $0,  %%r12 ;"
+    "movq  112(%1),  %%rdx ;"          /* A[2] */
+    "mulx     (%1),   %%r8,   %%r9 ;"  /* A[2]*B[0] */ "addq    %%rax,   %%r8 ;"
+    "movq     %%r8, 176(%1) ;"
+    "mulx    8(%1),  %%r10,  %%r11 ;"  /* A[2]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   16(%1),   %%r8,  %%r13 ;"  /* A[2]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   24(%1),  %%r10,  %%rax ;"  /* A[2]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rax ;"
+    "addq     %%r9,  %%rbx ;"
+    "adcq    %%r11,  %%rcx ;"
+    "adcq    %%r13,  %%r12 ;"
+    "adcq       $0,  %%rax ;"
+    "movq  120(%1),  %%rdx ;"          /* A[3] */
+    "mulx     (%1),   %%r8,   %%r9 ;"  /* A[3]*B[0] */ "addq    %%rbx,   %%r8 ;"
+    "movq     %%r8, 184(%1) ;"
+    "mulx    8(%1),  %%r10,  %%r11 ;"  /* A[3]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   16(%1),   %%r8,  %%r13 ;"  /* A[3]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   24(%1),  %%r10,  %%rbx ;"  /* A[3]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rbx ;"
+    "addq     %%r9,  %%rcx ;"
+    "adcq    %%r11,  %%r12 ;"
+    "adcq    %%r13,  %%rax ;"
+    "adcq       $0,  %%rbx ;"
+    "movl      $38,  %%edx ;"          /* 2*c = 38 = 2^256 */
+    "mulx    %%rcx,   %%r8,   %%r9 ;"  /* c*C[4] */
+    "mulx    %%r12,  %%r10,  %%r11 ;"  /* c*C[5] */    "addq     %%r9,  %%r10 ;"
+    "mulx    %%rax,   %%r9,  %%r12 ;"  /* c*C[6] */    "adcq    %%r11,   %%r9 ;"
+    "mulx    %%rbx,  %%r11,  %%rax ;"  /* c*C[7] */    "adcq    %%r12,  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "addq  160(%1),   %%r8 ;"
+    "adcq  168(%1),  %%r10 ;"
+    "adcq  176(%1),   %%r9 ;"
+    "adcq  184(%1),  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "imul    %%rdx,  %%rax ;"
+    "addq    %%rax,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0,  %%eax ;"
+    "cmovc   %%edx,  %%eax ;"
+    "addq    %%rax,   %%r8 ;"
+    "movq     %%r8, 128(%1) ;"
+    "movq    %%r10, 136(%1) ;"
+    "movq     %%r9, 144(%1) ;"
+    "movq    %%r11, 152(%1) ;"
+
+    /* CB = C*B */
+    "movq   64(%1),  %%rdx ;"          /* A[0] */
+    "mulx   32(%1),   %%r8,  %%r12 ;"  /* A[0]*B[0] */ "movq     %%r8, 160(%1) ;"
+    "mulx   40(%1),  %%r10,  %%rax ;"  /* A[0]*B[1] */ "addq    %%r10,  %%r12 ;"
+    "mulx   48(%1),   %%r8,  %%rbx ;"  /* A[0]*B[2] */ "adcq     %%r8,  %%rax ;"
+    "mulx   56(%1),  %%r10,  %%rcx ;"  /* A[0]*B[3] */ "adcq    %%r10,  %%rbx ;"
+    "adcq       $0,  %%rcx ;"
+    "movq   72(%1),  %%rdx ;"          /* A[1] */
+    "mulx   32(%1),   %%r8,   %%r9 ;"  /* A[1]*B[0] */ "addq    %%r12,   %%r8 ;"
+    "movq     %%r8, 168(%1) ;"
+    "mulx   40(%1),  %%r10,  %%r11 ;"  /* A[1]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   48(%1),   %%r8,  %%r13 ;"  /* A[1]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   56(%1),  %%r10,  %%r12 ;"  /* A[1]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%r12 ;"
+    "addq     %%r9,  %%rax ;"
+    "adcq    %%r11,  %%rbx ;"
+    "adcq    %%r13,  %%rcx ;"
+    "adcq       $0,  %%r12 ;"
+    "movq   80(%1),  %%rdx ;"          /* A[2] */
+    "mulx   32(%1),   %%r8,   %%r9 ;"  /* A[2]*B[0] */ "addq    %%rax,   %%r8 ;"
+    "movq     %%r8, 176(%1) ;"
+    "mulx   40(%1),  %%r10,  %%r11 ;"  /* A[2]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   48(%1),   %%r8,  %%r13 ;"  /* A[2]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   56(%1),  %%r10,  %%rax ;"  /* A[2]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rax ;"
+    "addq     %%r9,  %%rbx ;"
+    "adcq    %%r11,  %%rcx ;"
+    "adcq    %%r13,  %%r12 ;"
+    "adcq       $0,  %%rax ;"
+    "movq   88(%1),  %%rdx ;"          /* A[3] */
+    "mulx   32(%1),   %%r8,   %%r9 ;"  /* A[3]*B[0] */ "addq    %%rbx,   %%r8 ;"
+    "movq     %%r8, 184(%1) ;"
+    "mulx   40(%1),  %%r10,  %%r11 ;"  /* A[3]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   48(%1),   %%r8,  %%r13 ;"  /* A[3]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   56(%1),  %%r10,  %%rbx ;"  /* A[3]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rbx ;"
+    "addq     %%r9,  %%rcx ;"
+    "adcq    %%r11,  %%r12 ;"
+    "adcq    %%r13,  %%rax ;"
+    "adcq       $0,  %%rbx ;"
+    "movl      $38,  %%edx ;"          /* 2*c = 38 = 2^256 */
+    "mulx    %%rcx,   %%r8,   %%r9 ;"  /* c*C[4] */
+    "mulx    %%r12,  %%r10,  %%r11 ;"  /* c*C[5] */    "addq     %%r9,  %%r10 ;"
+    "mulx    %%rax,   %%r9,  %%r12 ;"  /* c*C[6] */    "adcq    %%r11,   %%r9 ;"
+    "mulx    %%rbx,  %%r11,  %%rax ;"  /* c*C[7] */    "adcq    %%r12,  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "addq  160(%1),   %%r8 ;"
+    "adcq  168(%1),  %%r10 ;"
+    "adcq  176(%1),   %%r9 ;"
+    "adcq  184(%1),  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "imul    %%rdx,  %%rax ;"
+    "addq    %%rax,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0,  %%eax ;"
+    "cmovc   %%edx,  %%eax ;"
+    "addq    %%rax,   %%r8 ;"
+
+    /* X3 = CB+DA, Z3 = CB-DA; the sign of Z3 vanishes when squaring */
+    "movl      $38,  %%eax ;"
+    "movq     %%r8,  %%r12 ;"
+    "movq    %%r10,  %%r13 ;"
+    "movq     %%r9,  %%r14 ;"
+    "movq    %%r11,  %%rbx ;"
+    "addq  128(%1),   %%r8 ;"
+    "adcq  136(%1),  %%r10 ;"
+    "adcq  144(%1),   %%r9 ;"
+    "adcq  152(%1),  %%r11 ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "addq    %%rcx,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "addq    %%rcx,   %%r8 ;"
+    "subq  128(%1),  %%r12 ;"
+    "sbbq  136(%1),  %%r13 ;"
+    "sbbq  144(%1),  %%r14 ;"
+    "sbbq  152(%1),  %%rbx ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "subq    %%rcx,  %%r12 ;"
+    "sbbq       $0,  %%r13 ;"
+    "sbbq       $0,  %%r14 ;"
+    "sbbq       $0,  %%rbx ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "subq    %%rcx,  %%r12 ;"
+    "movq     %%r8, 64(%0) ;"
+    "movq    %%r10, 72(%0) ;"
+    "movq     %%r9, 80(%0) ;"
+    "movq    %%r11, 88(%0) ;"
+    "movq    %%r12, 96(%0) ;"
+    "movq    %%r13, 104(%0) ;"
+    "movq    %%r14, 112(%0) ;"
+    "movq    %%rbx, 120(%0) ;"
+
+    /* Doubles (X3:Z3) instead of (X2:Z2) if swap = 1: A = C, B = D */
+    "movq       %3,  %%rax ;"
+    "testq   %%rax,  %%rax ;"
+    "movq     (%1),   %%r8 ;"
+    "movq    8(%1),  %%r10 ;"
+    "movq   16(%1),   %%r9 ;"
+    "movq   24(%1),  %%r11 ;"
+    "movq   32(%1),  %%r12 ;"
+    "movq   40(%1),  %%r13 ;"
+    "movq   48(%1),  %%r14 ;"
+    "movq   56(%1),  %%rbx ;"
+    "cmovnzq  64(%1),   %%r8 ;"
+    "cmovnzq  72(%1),  %%r10 ;"
+    "cmovnzq  80(%1),   %%r9 ;"
+    "cmovnzq  88(%1),  %%r11 ;"
+    "cmovnzq  96(%1),  %%r12 ;"
+    "cmovnzq 104(%1),  %%r13 ;"
+    "cmovnzq 112(%1),  %%r14 ;"
+    "cmovnzq 120(%1),  %%rbx ;"
+    "movq     %%r8,   (%1) ;"
+    "movq    %%r10,  8(%1) ;"
+    "movq     %%r9, 16(%1) ;"
+    "movq    %%r11, 24(%1) ;"
+    "movq    %%r12, 32(%1) ;"
+    "movq    %%r13, 40(%1) ;"
+    "movq    %%r14, 48(%1) ;"
+    "movq    %%rbx, 56(%1) ;"
+
+    /* AA = A^2 */
+    "movq    8(%1),  %%rdx ;"          /* A[1] */
+    "mulx     (%1),   %%r8,   %%r9 ;"  /* A[0]*A[1] */
+    "mulx   16(%1),  %%r10,  %%r11 ;"  /* A[2]*A[1] */
+    "mulx   24(%1),  %%rcx,  %%r14 ;"  /* A[3]*A[1] */
+    "movq   16(%1),  %%rdx ;"          /* A[2] */
+    "mulx   24(%1),  %%r12,  %%r13 ;"  /* A[3]*A[2] */
+    "mulx     (%1),  %%rax,  %%rdx ;"  /* A[0]*A[2] */ "addq    %%rax,   %%r9 ;"
+    "adcq    %%rdx,  %%r10 ;"
+    "adcq    %%rcx,  %%r11 ;"
+    "adcq    %%r14,  %%r12 ;"
+    "adcq       $0,  %%r13 ;"
+    "movl       $0, %%r14d ;"
+    "adcq       $0,  %%r14 ;"
+    "movq     (%1),  %%rdx ;"          /* A[0] */
+    "mulx   24(%1),  %%rax,  %%rcx ;"  /* A[0]*A[3] */ "addq    %%rax,  %%r10 ;"
+    "adcq    %%rcx,  %%r11 ;"
+    "adcq       $0,  %%r12 ;"
+    "adcq       $0,  %%r13 ;"
+    "adcq       $0,  %%r14 ;"
+    "shldq      $1,  %%r13,  %%r14 ;"
+    "shldq      $1,  %%r12,  %%r13 ;"
+    "shldq      $1,  %%r11,  %%r12 ;"
+    "shldq      $1,  %%r10,  %%r11 ;"
+    "shldq      $1,   %%r9,  %%r10 ;"
+    "shldq      $1,   %%r8,   %%r9 ;"
+    "shlq       $1,   %%r8 ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[0]^2 */    "movq    %%rax, 160(%1) ;"
+    "addq    %%rcx,   %%r8 ;"
+    "movq     %%r8, 168(%1) ;"
+    "movq    8(%1),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[1]^2 */    "adcq    %%rax,   %%r9 ;"
+    "movq     %%r9, 176(%1) ;"
+    "adcq    %%rcx,  %%r10 ;"
+    "movq    %%r10, 184(%1) ;"
+    "movq   16(%1),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[2]^2 */    "adcq    %%rax,  %%r11 ;"
+    "adcq    %%rcx,  %%r12 ;"
+    "movq   24(%1),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[3]^2 */    "adcq    %%rax,  %%r13 ;"
+    "adcq    %%rcx,  %%r14 ;"
+    "movq    %%r11,  %%rax ;"
+    "movl      $38,  %%edx ;"          /* 2*c = 38 = 2^256 */
+    "mulx    %%rax,   %%r8,   %%r9 ;"  /* c*C[4] */
+    "mulx    %%r12,  %%r10,  %%r11 ;"  /* c*C[5] */    "addq     %%r9,  %%r10 ;"
+    "mulx    %%r13,   %%r9,  %%r12 ;"  /* c*C[6] */    "adcq    %%r11,   %%r9 ;"
+    "mulx    %%r14,  %%r11,  %%r13 ;"  /* c*C[7] */    "adcq    %%r12,  %%r11 ;"
+    "adcq       $0,  %%r13 ;"
+    "addq  160(%1),   %%r8 ;"
+    "adcq  168(%1),  %%r10 ;"
+    "adcq  176(%1),   %%r9 ;"
+    "adcq  184(%1),  %%r11 ;"
+    "adcq       $0,  %%r13 ;"
+    "imul    %%rdx,  %%r13 ;"
+    "addq    %%r13,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0, %%r13d ;"
+    "cmovc   %%edx, %%r13d ;"
+    "addq    %%r13,   %%r8 ;"
+    "movq     %%r8,   (%1) ;"
+    "movq    %%r10,  8(%1) ;"
+    "movq     %%r9, 16(%1) ;"
+    "movq    %%r11, 24(%1) ;"
+
+    /* BB = B^2 */
+    "movq   40(%1),  %%rdx ;"          /* A[1] */
+    "mulx   32(%1),   %%r8,   %%r9 ;"  /* A[0]*A[1] */
+    "mulx   48(%1),  %%r10,  %%r11 ;"  /* A[2]*A[1] */
+    "mulx   56(%1),  %%rcx,  %%r14 ;"  /* A[3]*A[1] */
+    "movq   48(%1),  %%rdx ;"          /* A[2] */
+    "mulx   56(%1),  %%r12,  %%r13 ;"  /* A[3]*A[2] */
+    "mulx   32(%1),  %%rax,  %%rdx ;"  /* A[0]*A[2] */ "addq    %%rax,   %%r9 ;"
+    "adcq    %%rdx,  %%r10 ;"
+    "adcq    %%rcx,  %%r11 ;"
+    "adcq    %%r14,  %%r12 ;"
+    "adcq       $0,  %%r13 ;"
+    "movl       $0, %%r14d ;"
+    "adcq       $0,  %%r14 ;"
+    "movq   32(%1),  %%rdx ;"          /* A[0] */
+    "mulx   56(%1),  %%rax,  %%rcx ;"  /* A[0]*A[3] */ "addq    %%rax,  %%r10 ;"
+    "adcq    %%rcx,  %%r11 ;"
+    "adcq       $0,  %%r12 ;"
+    "adcq       $0,  %%r13 ;"
+    "adcq       $0,  %%r14 ;"
+    "shldq      $1,  %%r13,  %%r14 ;"
+    "shldq      $1,  %%r12,  %%r13 ;"
+    "shldq      $1,  %%r11,  %%r12 ;"
+    "shldq      $1,  %%r10,  %%r11 ;"
+    "shldq      $1,   %%r9,  %%r10 ;"
+    "shldq      $1,   %%r8,   %%r9 ;"
+    "shlq       $1,   %%r8 ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[0]^2 */    "movq    %%rax, 160(%1) ;"
+    "addq    %%rcx,   %%r8 ;"
+    "movq     %%r8, 168(%1) ;"
+    "movq   40(%1),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[1]^2 */    "adcq    %%rax,   %%r9 ;"
+    "movq     %%r9, 176(%1) ;"
+    "adcq    %%rcx,  %%r10 ;"
+    "movq    %%r10, 184(%1) ;"
+    "movq   48(%1),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[2]^2 */    "adcq    %%rax,  %%r11 ;"
+    "adcq    %%rcx,  %%r12 ;"
+    "movq   56(%1),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[3]^2 */    "adcq    %%rax,  %%r13 ;"
+    "adcq    %%rcx,  %%r14 ;"
+    "movq    %%r11,  %%rax ;"
+    "movl      $38,  %%edx ;"          /* 2*c = 38 = 2^256 */
+    "mulx    %%rax,   %%r8,   %%r9 ;"  /* c*C[4] */
+    "mulx    %%r12,  %%r10,  %%r11 ;"  /* c*C[5] */    "addq     %%r9,  %%r10 ;"
+    "mulx    %%r13,   %%r9,  %%r12 ;"  /* c*C[6] */    "adcq    %%r11,   %%r9 ;"
+    "mulx    %%r14,  %%r11,  %%r13 ;"  /* c*C[7] */    "adcq    %%r12,  %%r11 ;"
+    "adcq       $0,  %%r13 ;"
+    "addq  160(%1),   %%r8 ;"
+    "adcq  168(%1),  %%r10 ;"
+    "adcq  176(%1),   %%r9 ;"
+    "adcq  184(%1),  %%r11 ;"
+    "adcq       $0,  %%r13 ;"
+    "imul    %%rdx,  %%r13 ;"
+    "addq    %%r13,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0, %%r13d ;"
+    "cmovc   %%edx, %%r13d ;"
+    "addq    %%r13,   %%r8 ;"
+    "movq     %%r8, 32(%1) ;"
+    "movq    %%r10, 40(%1) ;"
+    "movq     %%r9, 48(%1) ;"
+    "movq    %%r11, 56(%1) ;"
+
+    /* E = AA-BB */
+    "movl      $38,  %%eax ;"
+    "movq     (%1),  %%r12 ;"
+    "movq    8(%1),  %%r13 ;"
+    "movq   16(%1),  %%r14 ;"
+    "movq   24(%1),  %%rbx ;"
+    "subq     %%r8,  %%r12 ;"
+    "sbbq    %%r10,  %%r13 ;"
+    "sbbq     %%r9,  %%r14 ;"
+    "sbbq    %%r11,  %%rbx ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "subq    %%rcx,  %%r12 ;"
+    "sbbq       $0,  %%r13 ;"
+    "sbbq       $0,  %%r14 ;"
+    "sbbq       $0,  %%rbx ;"
+    "movl       $0,  %%ecx ;"
+    "cmovc   %%eax,  %%ecx ;"
+    "subq    %%rcx,  %%r12 ;"
+    "movq    %%r12, 64(%1) ;"
+    "movq    %%r13, 72(%1) ;"
+    "movq    %%r14, 80(%1) ;"
+    "movq    %%rbx, 88(%1) ;"
+
+    /* F = a24*E+BB */
+    "movl  $121666,  %%edx ;"
+    "mulx   64(%1),  %%r12,  %%r13 ;"
+    "mulx   72(%1),  %%rcx,  %%r14 ;"                  "addq    %%rcx,  %%r13 ;"
+    "mulx   80(%1),  %%rcx,  %%rbx ;"                  "adcq    %%rcx,  %%r14 ;"
+    "mulx   88(%1),  %%rcx,  %%rax ;"                  "adcq    %%rcx,  %%rbx ;"
+    "adcq       $0,  %%rax ;"
+    "addq     %%r8,  %%r12 ;"
+    "adcq    %%r10,  %%r13 ;"
+    "adcq     %%r9,  %%r14 ;"
+    "adcq    %%r11,  %%rbx ;"
+    "adcq       $0,  %%rax ;"
+    "movl      $38,  %%edx ;"
+    "imul    %%rdx,  %%rax ;"
+    "addq    %%rax,  %%r12 ;"
+    "adcq       $0,  %%r13 ;"
+    "adcq       $0,  %%r14 ;"
+    "adcq       $0,  %%rbx ;"
+    "movl       $0,  %%eax ;"
+    "cmovc   %%edx,  %%eax ;"
+    "addq    %%rax,  %%r12 ;"
+    "movq    %%r12, 96(%1) ;"
+    "movq    %%r13, 104(%1) ;"
+    "movq    %%r14, 112(%1) ;"
+    "movq    %%rbx, 120(%1) ;"
+
+    /* X2 = AA*BB */
+    "movq     (%1),  %%rdx ;"          /* A[0] */
+    "mulx   32(%1),   %%r8,  %%r12 ;"  /* A[0]*B[0] */ "movq     %%r8, 160(%1) ;"
+    "mulx   40(%1),  %%r10,  %%rax ;"  /* A[0]*B[1] */ "addq    %%r10,  %%r12 ;"
+    "mulx   48(%1),   %%r8,  %%rbx ;"  /* A[0]*B[2] */ "adcq     %%r8,  %%rax ;"
+    "mulx   56(%1),  %%r10,  %%rcx ;"  /* A[0]*B[3] */ "adcq    %%r10,  %%rbx ;"
+    "adcq       $0,  %%rcx ;"
+    "movq    8(%1),  %%rdx ;"          /* A[1] */
+    "mulx   32(%1),   %%r8,   %%r9 ;"  /* A[1]*B[0] */ "addq    %%r12,   %%r8 ;"
+    "movq     %%r8, 168(%1) ;"
+    "mulx   40(%1),  %%r10,  %%r11 ;"  /* A[1]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   48(%1),   %%r8,  %%r13 ;"  /* A[1]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   56(%1),  %%r10,  %%r12 ;"  /* A[1]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%r12 ;"
+    "addq     %%r9,  %%rax ;"
+    "adcq    %%r11,  %%rbx ;"
+    "adcq    %%r13,  %%rcx ;"
+    "adcq       $0,  %%r12 ;"
+    "movq   16(%1),  %%rdx ;"          /* A[2] */
+    "mulx   32(%1),   %%r8,   %%r9 ;"  /* A[2]*B[0] */ "addq    %%rax,   %%r8 ;"
+    "movq     %%r8, 176(%1) ;"
+    "mulx   40(%1),  %%r10,  %%r11 ;"  /* A[2]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   48(%1),   %%r8,  %%r13 ;"  /* A[2]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   56(%1),  %%r10,  %%rax ;"  /* A[2]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rax ;"
+    "addq     %%r9,  %%rbx ;"
+    "adcq    %%r11,  %%rcx ;"
+    "adcq    %%r13,  %%r12 ;"
+    "adcq       $0,  %%rax ;"
+    "movq   24(%1),  %%rdx ;"          /* A[3] */
+    "mulx   32(%1),   %%r8,   %%r9 ;"  /* A[3]*B[0] */ "addq    %%rbx,   %%r8 ;"
+    "movq     %%r8, 184(%1) ;"
+    "mulx   40(%1),  %%r10,  %%r11 ;"  /* A[3]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   48(%1),   %%r8,  %%r13 ;"  /* A[3]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   56(%1),  %%r10,  %%rbx ;"  /* A[3]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rbx ;"
+    "addq     %%r9,  %%rcx ;"
+    "adcq    %%r11,  %%r12 ;"
+    "adcq    %%r13,  %%rax ;"
+    "adcq       $0,  %%rbx ;"
+    "movl      $38,  %%edx ;"          /* 2*c = 38 = 2^256 */
+    "mulx    %%rcx,   %%r8,   %%r9 ;"  /* c*C[4] */
+    "mulx    %%r12,  %%r10,  %%r11 ;"  /* c*C[5] */    "addq     %%r9,  %%r10 ;"
+    "mulx    %%rax,   %%r9,  %%r12 ;"  /* c*C[6] */    "adcq    %%r11,   %%r9 ;"
+    "mulx    %%rbx,  %%r11,  %%rax ;"  /* c*C[7] */    "adcq    %%r12,  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "addq  160(%1),   %%r8 ;"
+    "adcq  168(%1),  %%r10 ;"
+    "adcq  176(%1),   %%r9 ;"
+    "adcq  184(%1),  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "imul    %%rdx,  %%rax ;"
+    "addq    %%rax,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0,  %%eax ;"
+    "cmovc   %%edx,  %%eax ;"
+    "addq    %%rax,   %%r8 ;"
+    "movq     %%r8,   (%0) ;"
+    "movq    %%r10,  8(%0) ;"
+    "movq     %%r9, 16(%0) ;"
+    "movq    %%r11, 24(%0) ;"
+
+    /* Z2 = E*F */
+    "movq   64(%1),  %%rdx ;"          /* A[0] */
+    "mulx   96(%1),   %%r8,  %%r12 ;"  /* A[0]*B[0] */ "movq     %%r8, 160(%1) ;"
+    "mulx  104(%1),  %%r10,  %%rax ;"  /* A[0]*B[1] */ "addq    %%r10,  %%r12 ;"
+    "mulx  112(%1),   %%r8,  %%rbx ;"  /* A[0]*B[2] */ "adcq     %%r8,  %%rax ;"
+    "mulx  120(%1),  %%r10,  %%rcx ;"  /* A[0]*B[3] */ "adcq    %%r10,  %%rbx ;"
+    "adcq       $0,  %%rcx ;"
+    "movq   72(%1),  %%rdx ;"          /* A[1] */
+    "mulx   96(%1),   %%r8,   %%r9 ;"  /* A[1]*B[0] */ "addq    %%r12,   %%r8 ;"
+    "movq     %%r8, 168(%1) ;"
+    "mulx  104(%1),  %%r10,  %%r11 ;"  /* A[1]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx  112(%1),   %%r8,  %%r13 ;"  /* A[1]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx  120(%1),  %%r10,  %%r12 ;"  /* A[1]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%r12 ;"
+    "addq     %%r9,  %%rax ;"
+    "adcq    %%r11,  %%rbx ;"
+    "adcq    %%r13,  %%rcx ;"
+    "adcq       $0,  %%r12 ;"
+    "movq   80(%1),  %%rdx ;"          /* A[2] */
+    "mulx   96(%1),   %%r8,   %%r9 ;"  /* A[2]*B[0] */ "addq    %%rax,   %%r8 ;"
+    "movq     %%r8, 176(%1) ;"
+    "mulx  104(%1),  %%r10,  %%r11 ;"  /* A[2]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx  112(%1),   %%r8,  %%r13 ;"  /* A[2]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx  120(%1),  %%r10,  %%rax ;"  /* A[2]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rax ;"
+    "addq     %%r9,  %%rbx ;"
+    "adcq    %%r11,  %%rcx ;"
+    "adcq    %%r13,  %%r12 ;"
+    "adcq       $0,  %%rax ;"
+    "movq   88(%1),  %%rdx ;"          /* A[3] */
+    "mulx   96(%1),   %%r8,   %%r9 ;"  /* A[3]*B[0] */ "addq    %%rbx,   %%r8 ;"
+    "movq     %%r8, 184(%1) ;"
+    "mulx  104(%1),  %%r10,  %%r11 ;"  /* A[3]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx  112(%1),   %%r8,  %%r13 ;"  /* A[3]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx  120(%1),  %%r10,  %%rbx ;"  /* A[3]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rbx ;"
+    "addq     %%r9,  %%rcx ;"
+    "adcq    %%r11,  %%r12 ;"
+    "adcq    %%r13,  %%rax ;"
+    "adcq       $0,  %%rbx ;"
+    "movl      $38,  %%edx ;"          /* 2*c = 38 = 2^256 */
+    "mulx    %%rcx,   %%r8,   %%r9 ;"  /* c*C[4] */
+    "mulx    %%r12,  %%r10,  %%r11 ;"  /* c*C[5] */    "addq     %%r9,  %%r10 ;"
+    "mulx    %%rax,   %%r9,  %%r12 ;"  /* c*C[6] */    "adcq    %%r11,   %%r9 ;"
+    "mulx    %%rbx,  %%r11,  %%rax ;"  /* c*C[7] */    "adcq    %%r12,  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "addq  160(%1),   %%r8 ;"
+    "adcq  168(%1),  %%r10 ;"
+    "adcq  176(%1),   %%r9 ;"
+    "adcq  184(%1),  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "imul    %%rdx,  %%rax ;"
+    "addq    %%rax,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0,  %%eax ;"
+    "cmovc   %%edx,  %%eax ;"
+    "addq    %%rax,   %%r8 ;"
+    "movq     %%r8, 32(%0) ;"
+    "movq    %%r10, 40(%0) ;"
+    "movq     %%r9, 48(%0) ;"
+    "movq    %%r11, 56(%0) ;"
+
+    /* X3 = (DA+CB)^2 */
+    "movq   72(%0),  %%rdx ;"          /* A[1] */
+    "mulx   64(%0),   %%r8,   %%r9 ;"  /* A[0]*A[1] */
+    "mulx   80(%0),  %%r10,  %%r11 ;"  /* A[2]*A[1] */
+    "mulx   88(%0),  %%rcx,  %%r14 ;"  /* A[3]*A[1] */
+    "movq   80(%0),  %%rdx ;"          /* A[2] */
+    "mulx   88(%0),  %%r12,  %%r13 ;"  /* A[3]*A[2] */
+    "mulx   64(%0),  %%rax,  %%rdx ;"  /* A[0]*A[2] */ "addq    %%rax,   %%r9 ;"
+    "adcq    %%rdx,  %%r10 ;"
+    "adcq    %%rcx,  %%r11 ;"
+    "adcq    %%r14,  %%r12 ;"
+    "adcq       $0,  %%r13 ;"
+    "movl       $0, %%r14d ;"
+    "adcq       $0,  %%r14 ;"
+    "movq   64(%0),  %%rdx ;"          /* A[0] */
+    "mulx   88(%0),  %%rax,  %%rcx ;"  /* A[0]*A[3] */ "addq    %%rax,  %%r10 ;"
+    "adcq    %%rcx,  %%r11 ;"
+    "adcq       $0,  %%r12 ;"
+    "adcq       $0,  %%r13 ;"
+    "adcq       $0,  %%r14 ;"
+    "shldq      $1,  %%r13,  %%r14 ;"
+    "shldq      $1,  %%r12,  %%r13 ;"
+    "shldq      $1,  %%r11,  %%r12 ;"
+    "shldq      $1,  %%r10,  %%r11 ;"
+    "shldq      $1,   %%r9,  %%r10 ;"
+    "shldq      $1,   %%r8,   %%r9 ;"
+    "shlq       $1,   %%r8 ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[0]^2 */    "movq    %%rax, 160(%1) ;"
+    "addq    %%rcx,   %%r8 ;"
+    "movq     %%r8, 168(%1) ;"
+    "movq   72(%0),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[1]^2 */    "adcq    %%rax,   %%r9 ;"
+    "movq     %%r9, 176(%1) ;"
+    "adcq    %%rcx,  %%r10 ;"
+    "movq    %%r10, 184(%1) ;"
+    "movq   80(%0),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[2]^2 */    "adcq    %%rax,  %%r11 ;"
+    "adcq    %%rcx,  %%r12 ;"
+    "movq   88(%0),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[3]^2 */    "adcq    %%rax,  %%r13 ;"
+    "adcq    %%rcx,  %%r14 ;"
+    "movq    %%r11,  %%rax ;"
+    "movl      $38,  %%edx ;"          /* 2*c = 38 = 2^256 */
+    "mulx    %%rax,   %%r8,   %%r9 ;"  /* c*C[4] */
+    "mulx    %%r12,  %%r10,  %%r11 ;"  /* c*C[5] */    "addq     %%r9,  %%r10 ;"
+    "mulx    %%r13,   %%r9,  %%r12 ;"  /* c*C[6] */    "adcq    %%r11,   %%r9 ;"
+    "mulx    %%r14,  %%r11,  %%r13 ;"  /* c*C[7] */    "adcq    %%r12,  %%r11 ;"
+    "adcq       $0,  %%r13 ;"
+    "addq  160(%1),   %%r8 ;"
+    "adcq  168(%1),  %%r10 ;"
+    "adcq  176(%1),   %%r9 ;"
+    "adcq  184(%1),  %%r11 ;"
+    "adcq       $0,  %%r13 ;"
+    "imul    %%rdx,  %%r13 ;"
+    "addq    %%r13,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0, %%r13d ;"
+    "cmovc   %%edx, %%r13d ;"
+    "addq    %%r13,   %%r8 ;"
+    "movq     %%r8, 64(%0) ;"
+    "movq    %%r10, 72(%0) ;"
+    "movq     %%r9, 80(%0) ;"
+    "movq    %%r11, 88(%0) ;"
+
+    /* Z3 = (DA-CB)^2 */
+    "movq  104(%0),  %%rdx ;"          /* A[1] */
+    "mulx   96(%0),   %%r8,   %%r9 ;"  /* A[0]*A[1] */
+    "mulx  112(%0),  %%r10,  %%r11 ;"  /* A[2]*A[1] */
+    "mulx  120(%0),  %%rcx,  %%r14 ;"  /* A[3]*A[1] */
+    "movq  112(%0),  %%rdx ;"          /* A[2] */
+    "mulx  120(%0),  %%r12,  %%r13 ;"  /* A[3]*A[2] */
+    "mulx   96(%0),  %%rax,  %%rdx ;"  /* A[0]*A[2] */ "addq    %%rax,   %%r9 ;"
+    "adcq    %%rdx,  %%r10 ;"
+    "adcq    %%rcx,  %%r11 ;"
+    "adcq    %%r14,  %%r12 ;"
+    "adcq       $0,  %%r13 ;"
+    "movl       $0, %%r14d ;"
+    "adcq       $0,  %%r14 ;"
+    "movq   96(%0),  %%rdx ;"          /* A[0] */
+    "mulx  120(%0),  %%rax,  %%rcx ;"  /* A[0]*A[3] */ "addq    %%rax,  %%r10 ;"
+    "adcq    %%rcx,  %%r11 ;"
+    "adcq       $0,  %%r12 ;"
+    "adcq       $0,  %%r13 ;"
+    "adcq       $0,  %%r14 ;"
+    "shldq      $1,  %%r13,  %%r14 ;"
+    "shldq      $1,  %%r12,  %%r13 ;"
+    "shldq      $1,  %%r11,  %%r12 ;"
+    "shldq      $1,  %%r10,  %%r11 ;"
+    "shldq      $1,   %%r9,  %%r10 ;"
+    "shldq      $1,   %%r8,   %%r9 ;"
+    "shlq       $1,   %%r8 ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[0]^2 */    "movq    %%rax, 160(%1) ;"
+    "addq    %%rcx,   %%r8 ;"
+    "movq     %%r8, 168(%1) ;"
+    "movq  104(%0),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[1]^2 */    "adcq    %%rax,   %%r9 ;"
+    "movq     %%r9, 176(%1) ;"
+    "adcq    %%rcx,  %%r10 ;"
+    "movq    %%r10, 184(%1) ;"
+    "movq  112(%0),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[2]^2 */    "adcq    %%rax,  %%r11 ;"
+    "adcq    %%rcx,  %%r12 ;"
+    "movq  120(%0),  %%rdx ;"
+    "mulx    %%rdx,  %%rax,  %%rcx ;"  /* A[3]^2 */    "adcq    %%rax,  %%r13 ;"
+    "adcq    %%rcx,  %%r14 ;"
+    "movq    %%r11,  %%rax ;"
+    "movl      $38,  %%edx ;"          /* 2*c = 38 = 2^256 */
+    "mulx    %%rax,   %%r8,   %%r9 ;"  /* c*C[4] */
+    "mulx    %%r12,  %%r10,  %%r11 ;"  /* c*C[5] */    "addq     %%r9,  %%r10 ;"
+    "mulx    %%r13,   %%r9,  %%r12 ;"  /* c*C[6] */    "adcq    %%r11,   %%r9 ;"
+    "mulx    %%r14,  %%r11,  %%r13 ;"  /* c*C[7] */    "adcq    %%r12,  %%r11 ;"
+    "adcq       $0,  %%r13 ;"
+    "addq  160(%1),   %%r8 ;"
+    "adcq  168(%1),  %%r10 ;"
+    "adcq  176(%1),   %%r9 ;"
+    "adcq  184(%1),  %%r11 ;"
+    "adcq       $0,  %%r13 ;"
+    "imul    %%rdx,  %%r13 ;"
+    "addq    %%r13,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0, %%r13d ;"
+    "cmovc   %%edx, %%r13d ;"
+    "addq    %%r13,   %%r8 ;"
+    "movq     %%r8, 96(%0) ;"
+    "movq    %%r10, 104(%0) ;"
+    "movq     %%r9, 112(%0) ;"
+    "movq    %%r11, 120(%0) ;"
+
+    /* Z3 = X1*Z3 */
+    "movq   96(%0),  %%rdx ;"          /* A[0] */
+    "mulx     (%2),   %%r8,  %%r12 ;"  /* A[0]*B[0] */ "movq     %%r8, 160(%1) ;"
+    "mulx    8(%2),  %%r10,  %%rax ;"  /* A[0]*B[1] */ "addq    %%r10,  %%r12 ;"
+    "mulx   16(%2),   %%r8,  %%rbx ;"  /* A[0]*B[2] */ "adcq     %%r8,  %%rax ;"
+    "mulx   24(%2),  %%r10,  %%rcx ;"  /* A[0]*B[3] */ "adcq    %%r10,  %%rbx ;"
+    "adcq       $0,  %%rcx ;"
+    "movq  104(%0),  %%rdx ;"          /* A[1] */
+    "mulx     (%2),   %%r8,   %%r9 ;"  /* A[1]*B[0] */ "addq    %%r12,   %%r8 ;"
+    "movq     %%r8, 168(%1) ;"
+    "mulx    8(%2),  %%r10,  %%r11 ;"  /* A[1]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   16(%2),   %%r8,  %%r13 ;"  /* A[1]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   24(%2),  %%r10,  %%r12 ;"  /* A[1]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%r12 ;"
+    "addq     %%r9,  %%rax ;"
+    "adcq    %%r11,  %%rbx ;"
+    "adcq    %%r13,  %%rcx ;"
+    "adcq       $0,  %%r12 ;"
+    "movq  112(%0),  %%rdx ;"          /* A[2] */
+    "mulx     (%2),   %%r8,   %%r9 ;"  /* A[2]*B[0] */ "addq    %%rax,   %%r8 ;"
+    "movq     %%r8, 176(%1) ;"
+    "mulx    8(%2),  %%r10,  %%r11 ;"  /* A[2]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   16(%2),   %%r8,  %%r13 ;"  /* A[2]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   24(%2),  %%r10,  %%rax ;"  /* A[2]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rax ;"
+    "addq     %%r9,  %%rbx ;"
+    "adcq    %%r11,  %%rcx ;"
+    "adcq    %%r13,  %%r12 ;"
+    "adcq       $0,  %%rax ;"
+    "movq  120(%0),  %%rdx ;"          /* A[3] */
+    "mulx     (%2),   %%r8,   %%r9 ;"  /* A[3]*B[0] */ "addq    %%rbx,   %%r8 ;"
+    "movq     %%r8, 184(%1) ;"
+    "mulx    8(%2),  %%r10,  %%r11 ;"  /* A[3]*B[1] */ "adcq    %%r10,   %%r9 ;"
+    "mulx   16(%2),   %%r8,  %%r13 ;"  /* A[3]*B[2] */ "adcq     %%r8,  %%r11 ;"
+    "mulx   24(%2),  %%r10,  %%rbx ;"  /* A[3]*B[3] */ "adcq    %%r10,  %%r13 ;"
+    "adcq       $0,  %%rbx ;"
+    "addq     %%r9,  %%rcx ;"
+    "adcq    %%r11,  %%r12 ;"
+    "adcq    %%r13,  %%rax ;"
+    "adcq       $0,  %%rbx ;"
+    "movl      $38,  %%edx ;"          /* 2*c = 38 = 2^256 */
+    "mulx    %%rcx,   %%r8,   %%r9 ;"  /* c*C[4] */
+    "mulx    %%r12,  %%r10,  %%r11 ;"  /* c*C[5] */    "addq     %%r9,  %%r10 ;"
+    "mulx    %%rax,   %%r9,  %%r12 ;"  /* c*C[6] */    "adcq    %%r11,   %%r9 ;"
+    "mulx    %%rbx,  %%r11,  %%rax ;"  /* c*C[7] */    "adcq    %%r12,  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "addq  160(%1),   %%r8 ;"
+    "adcq  168(%1),  %%r10 ;"
+    "adcq  176(%1),   %%r9 ;"
+    "adcq  184(%1),  %%r11 ;"
+    "adcq       $0,  %%rax ;"
+    "imul    %%rdx,  %%rax ;"
+    "addq    %%rax,   %%r8 ;"
+    "adcq       $0,  %%r10 ;"
+    "adcq       $0,   %%r9 ;"
+    "adcq       $0,  %%r11 ;"
+    "movl       $0,  %%eax ;"
+    "cmovc   %%edx,  %%eax ;"
+    "addq    %%rax,   %%r8 ;"
+    "movq     %%r8, 96(%0) ;"
+    "movq    %%r10, 104(%0) ;"
+    "movq     %%r9, 112(%0) ;"
+    "movq    %%r11, 120(%0) ;"
+
   :
-  : "r" (c), "r" (a), "r" (a24)
-  : "memory", "cc", "%rax", "%rdx", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13"
+  : "r" (P), "r" (workspace), "r" (X1), "m" (swap)
+  : "memory", "cc", "%rax", "%rbx", "%rcx", "%rdx",
+    "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14"
   );
+#else    /* Without BMI2 */
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t workspace[6 * NUM_WORDS_ELTFP25519_X64];
+  uint64_t *const buffer_1w = buffer;
+  uint64_t *const buffer_2w = buffer;
+  uint64_t *const X2 = P + 0;
+  uint64_t *const Z2 = P + 4;
+  uint64_t *const X3 = P + 8;
+  uint64_t *const Z3 = P + 12;
+  uint64_t *const A = workspace + 0;
+  uint64_t *const B = workspace + 4;
+  uint64_t *const D = workspace + 8;
+  uint64_t *const C = workspace + 12;
+  uint64_t *const DA = workspace + 16;
+  uint64_t *const CB = workspace + 20;
+  const uint64_t mask = -swap;
+  int i = 0;
+
+  add_EltFp25519_1w_x64_inline(A, X2, Z2);  /* A = (X2+Z2)                   */
+  sub_EltFp25519_1w_x64_inline(B, X2, Z2);  /* B = (X2-Z2)                   */
+  add_EltFp25519_1w_x64_inline(C, X3, Z3);  /* C = (X3+Z3)                   */
+  sub_EltFp25519_1w_x64_inline(D, X3, Z3);  /* D = (X3-Z3)                   */
+  mul_EltFp25519_2w_x64(DA, A, D);          /* [DA|CB] = [A|B]*[D|C]         */
+
+  for (i = 0; i < NUM_WORDS_ELTFP25519_X64; i++) {
+    A[i] ^= (A[i] ^ C[i]) & mask;           /* A = swap ? C : A              */
+    B[i] ^= (B[i] ^ D[i]) & mask;           /* B = swap ? D : B              */
+  }
+
+  sqr_EltFp25519_2w_x64(A);                 /* [AA|BB] = [A^2|B^2]           */
+  add_EltFp25519_1w_x64_inline(X3, DA, CB); /* X3 = (DA+CB)                  */
+  sub_EltFp25519_1w_x64_inline(Z3, DA, CB); /* Z3 = (DA-CB)                  */
+  sqr_EltFp25519_2w_x64(X3);                /* [X3|Z3] = [(DA+CB)|(DA-CB)]^2 */
+
+  copy_EltFp25519_1w_x64(X2, B);            /* X2 = BB                       */
+  sub_EltFp25519_1w_x64_inline(Z2, A, B);   /* Z2 = E = AA-BB                */
+  mul_a24_EltFp25519_1w_x64_inline(B, Z2);  /* B = a24*E                     */
+  add_EltFp25519_1w_x64_inline(B, B, X2);   /* B = a24*E+BB                  */
+  mul_EltFp25519_2w_x64(X2, X2, A);         /* [X2|Z2] = [BB|E]*[AA|a24*E+BB] */
+  mul_EltFp25519_1w_x64(Z3, Z3, X1);        /* Z3 = Z3*X1                    */
 #endif
 }
 
-void inv_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a) {
-#define sqrn_EltFp25519_1w_x64(A, times)\
-  counter = times;\
-  while ( counter-- > 0) {\
-      sqr_EltFp25519_1w_x64(A);\
+/**
+ * Computes C = A^(2^n), i.e., n consecutive squarings; C and A may overlap.
+ * With MULX, the element stays in registers across the squarings and each
+ * reduction is folded into the squaring, so no 512-bit buffer is needed.
+ **/
+void sqrn_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a,
+                            unsigned int n) {
+#ifdef __BMI2__
+  uint64_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+  uint64_t counter = n;
+  if (counter > 0) {
+    __asm__ __volatile__(
+      "1: ;"
+      "movq     %0, %%rdx        ;" /* A[0]      */
+      "mulx     %1,  %%r8, %%r12 ;" /* A[0]*A[1] */
+      "mulx     %2,  %%r9, %%rbx ;" /* A[0]*A[2] */
+      "mulx     %3, %%r10, %%r11 ;" /* A[0]*A[3] */
+      "addq %%r12,  %%r9 ;"
+      "adcq %%rbx, %%r10 ;"
+      "adcq    $0, %%r11 ;"
+      "movq     %3, %%rdx        ;" /* A[3]      */
+      "mulx     %1, %%rax, %%r12 ;" /* A[3]*A[1] */
+      "mulx     %2, %%rcx, %%rbx ;" /* A[3]*A[2] */
+      "addq %%rax, %%r11 ;"
+      "adcq %%rcx, %%r12 ;"
+      "adcq    $0, %%rbx ;"
+      "movq     %1, %%rdx        ;" /* A[1]      */
+      "mulx     %2, %%rax, %%rcx ;" /* A[1]*A[2] */
+      "addq %%rax, %%r10 ;"
+      "adcq %%rcx, %%r11 ;"
+      "adcq    $0, %%r12 ;"
+      "adcq    $0, %%rbx ;"
+      "movl    $0, %%ecx ;"
+      "adcq    $0, %%rcx ;"
+
+      /* Doubles the cross products: (rcx,rbx,r12,r11,r10,r9,r8) */
+      "addq  %%r8,  %%r8 ;"
+      "adcq  %%r9,  %%r9 ;"
+      "adcq %%r10, %%r10 ;"
+      "adcq %%r11, %%r11 ;"
+      "adcq %%r12, %%r12 ;"
+      "adcq %%rbx, %%rbx ;"
+      "adcq %%rcx, %%rcx ;"
+
+      /* Adds the squares; A[i] is overwritten once it is no longer needed */
+      "movq     %0, %%rdx ;"  "mulx %%rdx,   %0, %%rax ;" /* A[0]^2 */
+      "addq %%rax,  %%r8 ;"
+      "movq     %1, %%rdx ;"  "mulx %%rdx,   %1, %%rax ;" /* A[1]^2 */
+      "adcq    %1,  %%r9 ;"
+      "adcq %%rax, %%r10 ;"
+      "movq     %2, %%rdx ;"  "mulx %%rdx,   %2, %%rax ;" /* A[2]^2 */
+      "adcq    %2, %%r11 ;"
+      "adcq %%rax, %%r12 ;"
+      "movq     %3, %%rdx ;"  "mulx %%rdx,   %3, %%rax ;" /* A[3]^2 */
+      "adcq    %3, %%rbx ;"
+      "adcq %%rax, %%rcx ;"
+
+      /* Reduces (rcx,rbx,r12,r11,r10,r9,r8,%0) as red_EltFp25519_1w_x64 */
+      "movl   $38, %%edx ;" /* 2*c = 38 = 2^256 */
+      "mulx %%r11,    %1, %%rax ;" /* c*C[4] */
+      "mulx %%r12,    %2, %%r11 ;" /* c*C[5] */  "addq %%rax,    %2 ;"
+      "mulx %%rbx,    %3, %%r12 ;" /* c*C[6] */  "adcq %%r11,    %3 ;"
+      "mulx %%rcx,  %%rax, %%rbx ;" /* c*C[7] */  "adcq %%r12, %%rax ;"
+      /*****************************************/  "adcq    $0, %%rbx ;"
+      "addq    %0,    %1 ;"
+      "adcq  %%r8,    %2 ;"
+      "adcq  %%r9,    %3 ;"
+      "adcq %%r10, %%rax ;"
+      "adcq    $0, %%rbx ;"
+      "imul %%rdx, %%rbx ;" /* c*C[4], cf=0 */
+      "addq %%rbx,    %1 ;"
+      "adcq    $0,    %2 ;"
+      "adcq    $0,    %3 ;"
+      "adcq    $0, %%rax ;"
+      "movl    $0, %%ebx ;"
+      "cmovc %%rdx, %%rbx ;"
+      "addq %%rbx,    %1 ;"
+
+      "movq    %1,    %0 ;"
+      "movq    %2,    %1 ;"
+      "movq    %3,    %2 ;"
+      "movq %%rax,    %3 ;"
+      "decq    %4 ;"
+      "jnz 1b ;"
+    : "+r" (a0), "+r" (a1), "+r" (a2), "+r" (a3), "+r" (counter)
+    :
+    : "cc", "%rax", "%rbx", "%rcx", "%rdx",
+      "%r8", "%r9", "%r10", "%r11", "%r12"
+    );
   }
+  c[0] = a0;
+  c[1] = a1;
+  c[2] = a2;
+  c[3] = a3;
+#else    /* Without BMI2 */
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  copy_EltFp25519_1w_x64(c, a);
+  while (n-- > 0) {
+    sqr_EltFp25519_1w_x64(c);
+  }
+#endif
+}
 
+void inv_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a) {
   EltFp25519_1w_Buffer_x64 buffer_1w;
   EltFp25519_1w_x64 x0, x1, x2;
   uint64_t * T[5];
-  uint64_t counter;
+
+  if (inv_safegcd_x64) {
+    inv_safegcd_EltFp25519_1w_x64(c, a);
+    return;
+  }
 
   T[0] = x0;
   T[1] = c; /* x^(-1) */
@@ -1279,72 +2132,154 @@ void inv_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a) {
   T[3] = x2;
   T[4] = a; /* x */
 
-  copy_EltFp25519_1w_x64(T[1], a);
-  sqrn_EltFp25519_1w_x64(T[1], 1);
-  copy_EltFp25519_1w_x64(T[2], T[1]);
-  sqrn_EltFp25519_1w_x64(T[2], 2);
+  sqrn_EltFp25519_1w_x64(T[1], a, 1);
+  sqrn_EltFp25519_1w_x64(T[2], T[1], 2);
   mul_EltFp25519_1w_x64(T[0], a, T[2]);
   mul_EltFp25519_1w_x64(T[1], T[1], T[0]);
-  copy_EltFp25519_1w_x64(T[2], T[1]);
-  sqrn_EltFp25519_1w_x64(T[2], 1);
+  sqrn_EltFp25519_1w_x64(T[2], T[1], 1);
   mul_EltFp25519_1w_x64(T[0], T[0], T[2]);
-  copy_EltFp25519_1w_x64(T[2], T[0]);
-  sqrn_EltFp25519_1w_x64(T[2], 5);
+  sqrn_EltFp25519_1w_x64(T[2], T[0], 5);
   mul_EltFp25519_1w_x64(T[0], T[0], T[2]);
-  copy_EltFp25519_1w_x64(T[2], T[0]);
-  sqrn_EltFp25519_1w_x64(T[2], 10);
+  sqrn_EltFp25519_1w_x64(T[2], T[0], 10);
   mul_EltFp25519_1w_x64(T[2], T[2], T[0]);
-  copy_EltFp25519_1w_x64(T[3], T[2]);
-  sqrn_EltFp25519_1w_x64(T[3], 20);
+  sqrn_EltFp25519_1w_x64(T[3], T[2], 20);
   mul_EltFp25519_1w_x64(T[3], T[3], T[2]);
-  sqrn_EltFp25519_1w_x64(T[3], 10);
+  sqrn_EltFp25519_1w_x64(T[3], T[3], 10);
   mul_EltFp25519_1w_x64(T[3], T[3], T[0]);
-  copy_EltFp25519_1w_x64(T[0], T[3]);
-  sqrn_EltFp25519_1w_x64(T[0], 50);
+  sqrn_EltFp25519_1w_x64(T[0], T[3], 50);
   mul_EltFp25519_1w_x64(T[0], T[0], T[3]);
-  copy_EltFp25519_1w_x64(T[2], T[0]);
-  sqrn_EltFp25519_1w_x64(T[2], 100);
+  sqrn_EltFp25519_1w_x64(T[2], T[0], 100);
   mul_EltFp25519_1w_x64(T[2], T[2], T[0]);
-  sqrn_EltFp25519_1w_x64(T[2], 50);
+  sqrn_EltFp25519_1w_x64(T[2], T[2], 50);
   mul_EltFp25519_1w_x64(T[2], T[2], T[3]);
-  sqrn_EltFp25519_1w_x64(T[2], 5);
+  sqrn_EltFp25519_1w_x64(T[2], T[2], 5);
   mul_EltFp25519_1w_x64(T[1], T[1], T[2]);
-#undef sqrn_EltFp25519_1w_x64
 }
 
+/* sqrt(-1) = 2^((p-1)/4) mod p */
+static const EltFp25519_1w_x64 sqrt_minus_one_fp25519 = {
+    0xc4ee1b274a0ea0b0, 0x2f431806ad2fe478, 0x2b4d00993dfbd7a7,
+    0x2b8324804fc1df0b};
+
 /**
- * Given C, a 256-bit number, fred_EltFp25519_1w_x64 updates C
- * with a number such that 0 <= C < 2**255-19.
- * Contributed by: Samuel Neves.
+ * Computes C = sqrt(A) as A^((p+3)/8), multiplied by sqrt(-1) when its
+ * square is -A, since p = 5 mod 8. Returns 1 if A is a square and 0
+ * otherwise, in which case C is not a root. Runs in constant time.
  **/
-inline void fred_EltFp25519_1w_x64(uint64_t *const c) {
-  uint64_t tmp0, tmp1;
-  __asm__ __volatile__ (
-    "movl   $19,   %k5 ;"
-    "movl   $38,   %k4 ;"
-
-    "btrq   $63,    %3 ;" /* Put bit 255 in carry flag and clear */
-    "cmovncl %k5,   %k4 ;" /* c[255] ? 38 : 19 */
-
-    /* Add either 19 or 38 to c */
-    "addq    %4,   %0 ;"
-    "adcq    $0,   %1 ;"
-    "adcq    $0,   %2 ;"
-    "adcq    $0,   %3 ;"
-
-    /* Test for bit 255 again; only triggered on overflow modulo 2^255-19 */
-    "movl    $0,  %k4 ;"
-    "cmovnsl %k5,  %k4 ;" /* c[255] ? 0 : 19 */
-    "btrq   $63,   %3 ;" /* Clear bit 255 */
-
-    /* Subtract 19 if necessary */
-    "subq    %4,   %0 ;"
-    "sbbq    $0,   %1 ;"
-    "sbbq    $0,   %2 ;"
-    "sbbq    $0,   %3 ;"
-
-    : "+r"(c[0]), "+r"(c[1]), "+r"(c[2]), "+r"(c[3]), "=r"(tmp0), "=r"(tmp1)
-    :
-    : "memory", "cc"
-  );
+int sqrt_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a) {
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  EltFp25519_1w_x64 x0, x1, x2, x3, a_red, minus_a;
+  uint64_t zero[NUM_WORDS_ELTFP25519_X64] = {0};
+  uint64_t diff_pos = 0, diff_neg = 0, mask = 0;
+  int i = 0;
+
+  sqrn_EltFp25519_1w_x64(x0, a, 1);
+  sqrn_EltFp25519_1w_x64(x1, x0, 2);
+  mul_EltFp25519_1w_x64(x1, x1, a);          /* x1 = a^9         */
+  mul_EltFp25519_1w_x64(x0, x0, x1);         /* x0 = a^11        */
+  sqrn_EltFp25519_1w_x64(x0, x0, 1);
+  mul_EltFp25519_1w_x64(x0, x0, x1);         /* x0 = a^(2^5-1)   */
+  sqrn_EltFp25519_1w_x64(x1, x0, 5);
+  mul_EltFp25519_1w_x64(x1, x1, x0);         /* x1 = a^(2^10-1)  */
+  sqrn_EltFp25519_1w_x64(x2, x1, 10);
+  mul_EltFp25519_1w_x64(x2, x2, x1);         /* x2 = a^(2^20-1)  */
+  sqrn_EltFp25519_1w_x64(x3, x2, 20);
+  mul_EltFp25519_1w_x64(x3, x3, x2);         /* x3 = a^(2^40-1)  */
+  sqrn_EltFp25519_1w_x64(x3, x3, 10);
+  mul_EltFp25519_1w_x64(x3, x3, x1);         /* x3 = a^(2^50-1)  */
+  sqrn_EltFp25519_1w_x64(x0, x3, 50);
+  mul_EltFp25519_1w_x64(x0, x0, x3);         /* x0 = a^(2^100-1) */
+  sqrn_EltFp25519_1w_x64(x2, x0, 100);
+  mul_EltFp25519_1w_x64(x2, x2, x0);         /* x2 = a^(2^200-1) */
+  sqrn_EltFp25519_1w_x64(x2, x2, 50);
+  mul_EltFp25519_1w_x64(x2, x2, x3);         /* x2 = a^(2^250-1) */
+  sqrn_EltFp25519_1w_x64(x2, x2, 1);
+  mul_EltFp25519_1w_x64(x2, x2, a);          /* x2 = a^(2^251-1) */
+  sqrn_EltFp25519_1w_x64(x2, x2, 1);         /* x2 = a^((p+3)/8) */
+
+  /* Compares x2^2 with a and -a */
+  copy_EltFp25519_1w_x64(a_red, a);
+  fred_EltFp25519_1w_x64(a_red);
+  sub_EltFp25519_1w_x64(minus_a, zero, a_red);
+  fred_EltFp25519_1w_x64(minus_a);
+  sqrn_EltFp25519_1w_x64(x0, x2, 1);
+  fred_EltFp25519_1w_x64(x0);
+  for (i = 0; i < NUM_WORDS_ELTFP25519_X64; i++) {
+    diff_pos |= x0[i] ^ a_red[i];
+    diff_neg |= x0[i] ^ minus_a[i];
+  }
+  diff_pos = (diff_pos | -diff_pos) >> 63; /* 0 iff x2^2 = a  */
+  diff_neg = (diff_neg | -diff_neg) >> 63; /* 0 iff x2^2 = -a */
+
+  mul_EltFp25519_1w_x64(x1, x2, (uint64_t *)sqrt_minus_one_fp25519);
+  mask = diff_neg - 1;
+  for (i = 0; i < NUM_WORDS_ELTFP25519_X64; i++) {
+    c[i] = x2[i] ^ ((x2[i] ^ x1[i]) & mask);
+  }
+  return (int)((diff_pos & diff_neg) ^ 1);
+}
+
+/**
+ * Sets C=A if A is not congruent to zero, otherwise sets C=1.
+ * Returns an all-ones mask if A was not congruent to zero, and zero otherwise.
+ * Runs in constant time.
+ **/
+static inline uint64_t nonzero_EltFp25519_1w_x64(uint64_t *const c,
+                                                 uint64_t *const a) {
+  uint64_t z, mask;
+  copy_EltFp25519_1w_x64(c, a);
+  fred_EltFp25519_1w_x64_inline(c);
+  z = c[0] | c[1] | c[2] | c[3];
+  mask = (uint64_t)0 - ((z | ((uint64_t)0 - z)) >> 63);
+  c[0] = (c[0] & mask) | (1 & ~mask);
+  return mask;
+}
+
+/**
+ * Simultaneous inversion (Montgomery's trick) of N field elements.
+ * Computes C[i] = A[i]^-1 for 0 <= i < N using a single call to
+ * inv_EltFp25519_1w_x64 and 3(N-1) multiplications. As in the 1-way
+ * inversion, elements congruent to zero are mapped to zero.
+ * @param c Output array of N elements; it must not overlap with A.
+ * @param a Input array of N elements.
+ * @param n Number of elements.
+ **/
+void inv_batch_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a,
+                                 unsigned int n) {
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  EltFp25519_1w_x64 acc, t;
+  uint64_t mask;
+  unsigned int i;
+
+  if (n == 0) {
+    return;
+  }
+  /* c[i] = a[0]*a[1]*...*a[i] */
+  nonzero_EltFp25519_1w_x64(c, a);
+  for (i = 1; i < n; i++) {
+    uint64_t *const Ci = c + NUM_WORDS_ELTFP25519_X64 * i;
+    nonzero_EltFp25519_1w_x64(t, a + NUM_WORDS_ELTFP25519_X64 * i);
+    mul_EltFp25519_1w_x64(Ci, Ci - NUM_WORDS_ELTFP25519_X64, t);
+  }
+  inv_EltFp25519_1w_x64(acc, c + NUM_WORDS_ELTFP25519_X64 * (n - 1));
+  /* c[i] = acc*c[i-1], acc = acc*a[i] */
+  for (i = n - 1; i > 0; i--) {
+    uint64_t *const Ci = c + NUM_WORDS_ELTFP25519_X64 * i;
+    mask = nonzero_EltFp25519_1w_x64(t, a + NUM_WORDS_ELTFP25519_X64 * i);
+    mul_EltFp25519_1w_x64(Ci, acc, Ci - NUM_WORDS_ELTFP25519_X64);
+    mul_EltFp25519_1w_x64(acc, acc, t);
+    Ci[0] &= mask;
+    Ci[1] &= mask;
+    Ci[2] &= mask;
+    Ci[3] &= mask;
+  }
+  mask = nonzero_EltFp25519_1w_x64(t, a);
+  c[0] = acc[0] & mask;
+  c[1] = acc[1] & mask;
+  c[2] = acc[2] & mask;
+  c[3] = acc[3] & mask;
+}
+
+void fred_EltFp25519_1w_x64(uint64_t *const c) {
+  fred_EltFp25519_1w_x64_inline(c);
 }
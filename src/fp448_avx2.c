@@ -0,0 +1,338 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "fp448_avx2.h"
+#include <immintrin.h>
+
+#define LOAD(A, I) _mm256_load_si256((__m256i *)(A) + (I))
+#define STORE(C, I, X) _mm256_store_si256((__m256i *)(C) + (I), (X))
+/* Full unrolling resolves the digit-dependent branches at compile time */
+#define UNROLL _Pragma("GCC unroll 32")
+#define BITS_DIGIT 28
+#define NUM_WORDS_X64 7
+
+/* Splits an EltFp448_1w_x64 element into sixteen digits */
+static inline void digits_EltFp448_avx2(uint64_t *const d,
+                                        const uint64_t *const A) {
+  int i = 0;
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    const int w = (BITS_DIGIT * i) / 64;
+    const int s = (BITS_DIGIT * i) % 64;
+    uint64_t digit = A[w] >> s;
+    if (s + BITS_DIGIT > 64) {
+      digit |= A[w + 1] << (64 - s);
+    }
+    d[i] = digit & (((uint64_t)1 << BITS_DIGIT) - 1);
+  }
+}
+
+/**
+ * Converts four elements of GF(2^448-2^224-1) from the 1w_x64
+ * representation.
+ * @param c Four elements in radix 2^28.
+ * @param a Four consecutive EltFp448_1w_x64 elements (28 words).
+ */
+void load_EltFp448_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  uint64_t d[NUM_DIGITS_FP448_AVX2];
+  int i = 0, j = 0;
+  UNROLL
+  for (j = 0; j < 4; j++) {
+    digits_EltFp448_avx2(d, a + NUM_WORDS_X64 * j);
+    UNROLL
+    for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+      c[4 * i + j] = d[i];
+    }
+  }
+}
+
+/**
+ * Copies one element of GF(2^448-2^224-1) in the 1w_x64 representation to
+ * the four lanes of C.
+ */
+void broadcast_EltFp448_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  uint64_t d[NUM_DIGITS_FP448_AVX2];
+  int i = 0;
+  digits_EltFp448_avx2(d, a);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    STORE(c, i, _mm256_set1_epi64x(d[i]));
+  }
+}
+
+/**
+ * Converts four elements of GF(2^448-2^224-1) to the 1w_x64 representation.
+ * The input must have its carries propagated, i.e. be the output of a
+ * multiplication, squaring, carry or load, so that it fits in 448 bits.
+ * @param c Four consecutive EltFp448_1w_x64 elements (28 words).
+ * @param a Four elements in radix 2^28.
+ */
+void store_EltFp448_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  int i = 0, j = 0, k = 0;
+  for (j = 0; j < 4; j++) {
+    uint64_t C[NUM_WORDS_X64 + 1] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+      const int w = (BITS_DIGIT * i) / 64;
+      const int s = (BITS_DIGIT * i) % 64;
+      const uint64_t digit = a[4 * i + j];
+      uint64_t lo = digit << s;
+      uint64_t hi = s == 0 ? 0 : digit >> (64 - s);
+      C[w] += lo;
+      hi += C[w] < lo;
+      for (k = w + 1; k < NUM_WORDS_X64 + 1; k++) {
+        C[k] += hi;
+        hi = C[k] < hi;
+      }
+    }
+    for (k = 0; k < NUM_WORDS_X64; k++) {
+      c[NUM_WORDS_X64 * j + k] = C[k];
+    }
+  }
+}
+
+void add_EltFp448_4w_avx2(uint64_t *const c, uint64_t *const a,
+                          uint64_t *const b) {
+  int i = 0;
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    STORE(c, i, _mm256_add_epi64(LOAD(a, i), LOAD(b, i)));
+  }
+}
+
+/**
+ * Computes C = A-B+2p, so digits remain non-negative. B must be the
+ * output of a multiplication, squaring, carry or load.
+ */
+void sub_EltFp448_4w_avx2(uint64_t *const c, uint64_t *const a,
+                          uint64_t *const b) {
+  int i = 0;
+  /* 2p = 2^449-2^225-2 */
+  const __m256i two_p = _mm256_set1_epi64x(((uint64_t)1 << 29) - 2);
+  const __m256i two_p8 = _mm256_set1_epi64x(((uint64_t)1 << 29) - 4);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    const __m256i t = i == 8 ? two_p8 : two_p;
+    STORE(c, i, _mm256_sub_epi64(_mm256_add_epi64(LOAD(a, i), t),
+                                 LOAD(b, i)));
+  }
+}
+
+/**
+ * Carry propagation of sixteen 64-bit digits as two interleaved chains
+ * starting at digits 0 and 8; the carry out of digit 15 is added to
+ * digits 0 and 8, since 2^448 = 2^224+1. For digits below 2^63, on
+ * output digits have at most 28 bits, except digits 1 and 9 that take
+ * the last carries of digits 0 and 8 and may reach 2^28+2^8; for the
+ * outputs of red_Fp448_4w_avx2 and mul_a24 they reach at most 2^28.
+ */
+static inline void carry_Fp448_4w_avx2(__m256i *const h) {
+  const __m256i mask = _mm256_set1_epi64x(((uint64_t)1 << BITS_DIGIT) - 1);
+  __m256i c0, c8;
+  int i = 0;
+
+  UNROLL
+  for (i = 0; i < 8; i++) {
+    c0 = _mm256_srli_epi64(h[i], BITS_DIGIT);
+    c8 = _mm256_srli_epi64(h[i + 8], BITS_DIGIT);
+    h[i] = _mm256_and_si256(h[i], mask);
+    h[i + 8] = _mm256_and_si256(h[i + 8], mask);
+    h[i + 1] = _mm256_add_epi64(h[i + 1], c0);
+    if (i < 7) {
+      h[i + 9] = _mm256_add_epi64(h[i + 9], c8);
+    } else {
+      h[0] = _mm256_add_epi64(h[0], c8);
+      h[8] = _mm256_add_epi64(h[8], c8);
+    }
+  }
+  c0 = _mm256_srli_epi64(h[0], BITS_DIGIT);
+  c8 = _mm256_srli_epi64(h[8], BITS_DIGIT);
+  h[0] = _mm256_and_si256(h[0], mask);
+  h[8] = _mm256_and_si256(h[8], mask);
+  h[1] = _mm256_add_epi64(h[1], c0);
+  h[9] = _mm256_add_epi64(h[9], c8);
+}
+
+/**
+ * Reduces the 31 columns of a product, each one below 2^64, to sixteen
+ * digits. Columns are first carried in parallel to ~36 bits, so that
+ * folding them with 2^448 = 2^224+1 cannot overflow.
+ */
+static inline void red_Fp448_4w_avx2(__m256i *const h, __m256i *const col) {
+  const __m256i mask = _mm256_set1_epi64x(((uint64_t)1 << BITS_DIGIT) - 1);
+  int i = 0;
+
+  col[2 * NUM_DIGITS_FP448_AVX2 - 1] = _mm256_setzero_si256();
+  UNROLL
+  for (i = 2 * NUM_DIGITS_FP448_AVX2 - 2; i >= 0; i--) {
+    const __m256i c = _mm256_srli_epi64(col[i], BITS_DIGIT);
+    col[i] = _mm256_and_si256(col[i], mask);
+    col[i + 1] = _mm256_add_epi64(col[i + 1], c);
+  }
+  UNROLL
+  for (i = 2 * NUM_DIGITS_FP448_AVX2 - 1; i >= NUM_DIGITS_FP448_AVX2; i--) {
+    col[i - 8] = _mm256_add_epi64(col[i - 8], col[i]);
+    col[i - 16] = _mm256_add_epi64(col[i - 16], col[i]);
+  }
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    h[i] = col[i];
+  }
+  carry_Fp448_4w_avx2(h);
+}
+
+/**
+ * Propagates the carries of C, so that it can be used as the subtrahend
+ * of sub_EltFp448_4w_avx2 or stored.
+ */
+void carry_EltFp448_4w_avx2(uint64_t *const c) {
+  __m256i h[NUM_DIGITS_FP448_AVX2];
+  int i = 0;
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    h[i] = LOAD(c, i);
+  }
+  carry_Fp448_4w_avx2(h);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    STORE(c, i, h[i]);
+  }
+}
+
+/**
+ * Schoolbook multiplication with products accumulated in 64-bit lanes.
+ * Each column adds up to 16 products, so input digits must be below 2^30
+ * for the columns to stay below 2^64 (and 2*a[i] to fit the 32 bits read
+ * by vpmuludq in the squaring).
+ *
+ * The ladders of x448_avx2.c pass outputs of mul, sqr, mul_a24, carry
+ * or load, or one add or sub (+2p) of two of them. Outputs have digits
+ * below 2^28, except digits 1 and 9, which may equal 2^28. Inputs
+ * therefore stay at most 3*2^28-2. That leaves a factor 4/3 of headroom
+ * below 2^30, with columns below 2^63.2. A longer chain of adds needs a
+ * carry first.
+ */
+void mul_EltFp448_4w_avx2(uint64_t *const c, uint64_t *const a,
+                          uint64_t *const b) {
+  __m256i f[NUM_DIGITS_FP448_AVX2], g[NUM_DIGITS_FP448_AVX2];
+  __m256i col[2 * NUM_DIGITS_FP448_AVX2], h[NUM_DIGITS_FP448_AVX2];
+  int i = 0, j = 0;
+
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    f[i] = LOAD(a, i);
+    g[i] = LOAD(b, i);
+    col[i] = _mm256_setzero_si256();
+    col[i + NUM_DIGITS_FP448_AVX2] = _mm256_setzero_si256();
+  }
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    UNROLL
+    for (j = 0; j < NUM_DIGITS_FP448_AVX2; j++) {
+      col[i + j] = _mm256_add_epi64(col[i + j], _mm256_mul_epu32(f[i], g[j]));
+    }
+  }
+  red_Fp448_4w_avx2(h, col);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    STORE(c, i, h[i]);
+  }
+}
+
+/**
+ * Squaring; it computes the 136 distinct cross products only.
+ * Same input bounds as mul_EltFp448_4w_avx2.
+ */
+void sqr_EltFp448_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  __m256i f[NUM_DIGITS_FP448_AVX2], f2[NUM_DIGITS_FP448_AVX2];
+  __m256i col[2 * NUM_DIGITS_FP448_AVX2], h[NUM_DIGITS_FP448_AVX2];
+  int i = 0, j = 0;
+
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    f[i] = LOAD(a, i);
+    f2[i] = _mm256_add_epi64(f[i], f[i]);
+    col[i] = _mm256_setzero_si256();
+    col[i + NUM_DIGITS_FP448_AVX2] = _mm256_setzero_si256();
+  }
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    col[2 * i] = _mm256_add_epi64(col[2 * i], _mm256_mul_epu32(f[i], f[i]));
+    UNROLL
+    for (j = i + 1; j < NUM_DIGITS_FP448_AVX2; j++) {
+      col[i + j] = _mm256_add_epi64(col[i + j], _mm256_mul_epu32(f2[i], f[j]));
+    }
+  }
+  red_Fp448_4w_avx2(h, col);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    STORE(c, i, h[i]);
+  }
+}
+
+/**
+ * Multiplication by a24 = (A+2)/4 = (156326+2)/4 = 39082
+ **/
+void mul_a24_EltFp448_4w_avx2(uint64_t *const c, uint64_t *const a) {
+  __m256i h[NUM_DIGITS_FP448_AVX2];
+  const __m256i a24 = _mm256_set1_epi64x(39082);
+  int i = 0;
+
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    h[i] = _mm256_mul_epu32(LOAD(a, i), a24);
+  }
+  carry_Fp448_4w_avx2(h);
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    STORE(c, i, h[i]);
+  }
+}
+
+/**
+ * Swaps A and B in the lanes where MASK is all-ones.
+ * @param mask Four 64-bit words, each one either zero or all-ones.
+ */
+void cswap_EltFp448_4w_avx2(uint64_t *const mask, uint64_t *const a,
+                            uint64_t *const b) {
+  const __m256i m = LOAD(mask, 0);
+  int i = 0;
+  UNROLL
+  for (i = 0; i < NUM_DIGITS_FP448_AVX2; i++) {
+    const __m256i A = LOAD(a, i);
+    const __m256i B = LOAD(b, i);
+    const __m256i t = _mm256_and_si256(m, _mm256_xor_si256(A, B));
+    STORE(a, i, _mm256_xor_si256(A, t));
+    STORE(b, i, _mm256_xor_si256(B, t));
+  }
+}
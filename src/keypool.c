@@ -0,0 +1,323 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rfc7748_keypool.h"
+
+#define POOL_LINE_BYTES 64
+#define POOL_DEFAULT_CAPACITY 1024
+#define POOL_MAX_CAPACITY (1u << 24)
+#define POOL_DEFAULT_BATCH 64
+
+/**
+ * One key pair of the ring. As in Vyukov's bounded queue, seq equals the
+ * position of the slot while it is free, and the position plus one once
+ * the producer has filled it.
+ */
+typedef struct {
+  uint64_t seq;
+  uint8_t public_key[X448_KEYSIZE_BYTES];
+  uint8_t private_key[X448_KEYSIZE_BYTES];
+} __attribute__((aligned(POOL_LINE_BYTES))) PoolSlot;
+
+struct Rfc7748KeyPool {
+  /* Written by the threads calling RFC7748_PoolPop */
+  uint64_t head __attribute__((aligned(POOL_LINE_BYTES)));
+  uint64_t pops;
+  uint64_t misses;
+  /* Written by the background thread */
+  uint64_t tail __attribute__((aligned(POOL_LINE_BYTES)));
+  uint64_t generated;
+  uint64_t refills;
+  /* Shared by both sides, and used only to sleep and wake up */
+  int running __attribute__((aligned(POOL_LINE_BYTES)));
+  int waiting;
+  pthread_mutex_t lock;
+  pthread_cond_t wakeup;
+  pthread_t thread;
+  /* Read-only after RFC7748_PoolCreate */
+  PoolSlot *ring;
+  uint64_t mask;
+  unsigned int key_size;
+  unsigned int low;
+  unsigned int high;
+  unsigned int batch;
+  KeyGen keygen;
+  KeyGenBatch keygen_batch;
+  void (*random)(uint8_t *buffer, int num_bytes);
+  /* Scratch of the background thread for KeyGen_batch */
+  uint8_t *keys;
+  argKey *public_keys;
+  argKey *private_keys;
+};
+
+/* Unlike memset, it is not removed when the memory is freed right after */
+static void pool_wipe(void *buffer, size_t num_bytes) {
+  volatile uint8_t *p = (volatile uint8_t *)buffer;
+  while (num_bytes--) {
+    *p++ = 0;
+  }
+}
+
+/* Pairs in the ring; it may be stale when other threads push or pop */
+static unsigned int pool_level(Rfc7748KeyPool *pool) {
+  uint64_t head = __atomic_load_n(&pool->head, __ATOMIC_SEQ_CST);
+  uint64_t tail = __atomic_load_n(&pool->tail, __ATOMIC_ACQUIRE);
+  return (unsigned int)(tail - head);
+}
+
+/* Called only by the background thread; returns 0 if the ring is full */
+static int pool_push(Rfc7748KeyPool *pool, const uint8_t *public_key,
+                     const uint8_t *private_key) {
+  uint64_t pos = __atomic_load_n(&pool->tail, __ATOMIC_RELAXED);
+  PoolSlot *slot = &pool->ring[pos & pool->mask];
+
+  if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos) {
+    return 0;
+  }
+  memcpy(slot->public_key, public_key, pool->key_size);
+  memcpy(slot->private_key, private_key, pool->key_size);
+  __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+  __atomic_store_n(&pool->tail, pos + 1, __ATOMIC_RELEASE);
+  return 1;
+}
+
+/* Called by any thread; returns 0 if the ring is empty */
+static int pool_take(Rfc7748KeyPool *pool, argKey public_key,
+                     argKey private_key) {
+  uint64_t pos = __atomic_load_n(&pool->head, __ATOMIC_RELAXED);
+
+  for (;;) {
+    PoolSlot *slot = &pool->ring[pos & pool->mask];
+    uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+    int64_t diff = (int64_t)(seq - (pos + 1));
+
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&pool->head, &pos, pos + 1, 1,
+                                      __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        memcpy(public_key, slot->public_key, pool->key_size);
+        memcpy(private_key, slot->private_key, pool->key_size);
+        pool_wipe(slot->private_key, pool->key_size);
+        __atomic_store_n(&slot->seq, pos + pool->mask + 1, __ATOMIC_RELEASE);
+        return 1;
+      }
+    } else if (diff < 0) {
+      return 0;
+    } else {
+      pos = __atomic_load_n(&pool->head, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+/**
+ * Background thread: fills the ring up to the high watermark, one call to
+ * KeyGen_batch at a time, then sleeps until a pop leaves fewer than low
+ * pairs. The waiting flag is set before the level is checked, and pops
+ * update head before reading the flag, so no wakeup is lost.
+ */
+static void *pool_refill(void *arg) {
+  Rfc7748KeyPool *pool = (Rfc7748KeyPool *)arg;
+  unsigned int i = 0, n = 0, level = 0;
+  int running = 1;
+
+  while (running) {
+    level = pool_level(pool);
+    if (level < pool->high) {
+      n = pool->high - level < pool->batch ? pool->high - level : pool->batch;
+      for (i = 0; i < n; i++) {
+        pool->random(pool->private_keys[i], (int)pool->key_size);
+      }
+      pool->keygen_batch(pool->public_keys, pool->private_keys, n);
+      for (i = 0; i < n; i++) {
+        if (!pool_push(pool, pool->public_keys[i], pool->private_keys[i])) {
+          break;
+        }
+      }
+      pool_wipe(pool->keys, (size_t)2 * pool->batch * pool->key_size);
+      __atomic_store_n(&pool->generated, pool->generated + i,
+                       __ATOMIC_RELAXED);
+      running = __atomic_load_n(&pool->running, __ATOMIC_ACQUIRE);
+      continue;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    __atomic_store_n(&pool->waiting, 1, __ATOMIC_SEQ_CST);
+    while (pool->running && pool_level(pool) >= pool->low) {
+      pthread_cond_wait(&pool->wakeup, &pool->lock);
+    }
+    __atomic_store_n(&pool->waiting, 0, __ATOMIC_RELAXED);
+    running = pool->running;
+    pthread_mutex_unlock(&pool->lock);
+    if (running) {
+      __atomic_store_n(&pool->refills, pool->refills + 1, __ATOMIC_RELAXED);
+    }
+  }
+  return NULL;
+}
+
+static void pool_free(Rfc7748KeyPool *pool) {
+  if (pool->ring != NULL) {
+    pool_wipe(pool->ring, ((size_t)pool->mask + 1) * sizeof(PoolSlot));
+  }
+  free(pool->ring);
+  free(pool->keys);
+  free(pool->public_keys);
+  free(pool->private_keys);
+  free(pool);
+}
+
+Rfc7748KeyPool *RFC7748_PoolCreate(Rfc7748PoolCurve curve,
+                                   const Rfc7748PoolConfig *config) {
+  Rfc7748KeyPool *pool = NULL;
+  void *memory = NULL;
+  unsigned int capacity = 1, i = 0;
+
+  if (config == NULL || config->random == NULL ||
+      config->capacity > POOL_MAX_CAPACITY ||
+      (curve != RFC7748_POOL_X25519 && curve != RFC7748_POOL_X448)) {
+    return NULL;
+  }
+  if (posix_memalign(&memory, POOL_LINE_BYTES, sizeof(*pool)) != 0) {
+    return NULL;
+  }
+  pool = (Rfc7748KeyPool *)memory;
+  memset(pool, 0, sizeof(*pool));
+
+  while (capacity < (config->capacity ? config->capacity
+                                      : POOL_DEFAULT_CAPACITY)) {
+    capacity <<= 1;
+  }
+  pool->mask = capacity - 1;
+  pool->high = config->high_watermark ? config->high_watermark : capacity;
+  pool->low = config->low_watermark ? config->low_watermark : pool->high / 4;
+  pool->batch = config->batch ? config->batch : POOL_DEFAULT_BATCH;
+  pool->random = config->random;
+  if (curve == RFC7748_POOL_X25519) {
+    pool->key_size = X25519_KEYSIZE_BYTES;
+    pool->keygen = X25519_KeyGen;
+    pool->keygen_batch = X25519_KeyGen_batch;
+  } else {
+    pool->key_size = X448_KEYSIZE_BYTES;
+    pool->keygen = X448_KeyGen;
+    pool->keygen_batch = X448_KeyGen_batch;
+  }
+  if (pool->high > capacity || pool->low > pool->high) {
+    pool_free(pool);
+    return NULL;
+  }
+  /* A refill never generates more than high pairs */
+  if (pool->batch > pool->high) {
+    pool->batch = pool->high;
+  }
+
+  memory = NULL;
+  if (posix_memalign(&memory, POOL_LINE_BYTES,
+                     (size_t)capacity * sizeof(PoolSlot))) {
+    pool_free(pool);
+    return NULL;
+  }
+  pool->ring = (PoolSlot *)memory;
+  pool->keys = (uint8_t *)malloc((size_t)2 * pool->batch * pool->key_size);
+  pool->public_keys = (argKey *)malloc((size_t)pool->batch * sizeof(argKey));
+  pool->private_keys = (argKey *)malloc((size_t)pool->batch * sizeof(argKey));
+  if (pool->keys == NULL || pool->public_keys == NULL ||
+      pool->private_keys == NULL) {
+    pool_free(pool);
+    return NULL;
+  }
+  for (i = 0; i < capacity; i++) {
+    pool->ring[i].seq = i;
+  }
+  for (i = 0; i < pool->batch; i++) {
+    pool->public_keys[i] = pool->keys + (size_t)pool->key_size * (2 * i);
+    pool->private_keys[i] = pool->keys + (size_t)pool->key_size * (2 * i + 1);
+  }
+
+  pool->running = 1;
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->wakeup, NULL);
+  if (pthread_create(&pool->thread, NULL, pool_refill, pool) != 0) {
+    pthread_cond_destroy(&pool->wakeup);
+    pthread_mutex_destroy(&pool->lock);
+    pool_free(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+void RFC7748_PoolDestroy(Rfc7748KeyPool *pool) {
+  if (pool == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&pool->lock);
+  __atomic_store_n(&pool->running, 0, __ATOMIC_RELEASE);
+  pthread_cond_signal(&pool->wakeup);
+  pthread_mutex_unlock(&pool->lock);
+  pthread_join(pool->thread, NULL);
+
+  pthread_cond_destroy(&pool->wakeup);
+  pthread_mutex_destroy(&pool->lock);
+  pool_free(pool);
+}
+
+int RFC7748_PoolPop(Rfc7748KeyPool *pool, argKey public_key,
+                    argKey private_key) {
+  int hit = pool_take(pool, public_key, private_key);
+
+  if (!hit) {
+    pool->random(private_key, (int)pool->key_size);
+    pool->keygen(public_key, private_key);
+    __atomic_fetch_add(&pool->misses, 1, __ATOMIC_RELAXED);
+  }
+  __atomic_fetch_add(&pool->pops, 1, __ATOMIC_RELAXED);
+
+  if (__atomic_load_n(&pool->waiting, __ATOMIC_SEQ_CST) &&
+      pool_level(pool) < pool->low) {
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_signal(&pool->wakeup);
+    pthread_mutex_unlock(&pool->lock);
+  }
+  return hit ? 0 : 1;
+}
+
+void RFC7748_PoolGetStats(Rfc7748KeyPool *pool, Rfc7748PoolStats *stats) {
+  stats->pops = __atomic_load_n(&pool->pops, __ATOMIC_RELAXED);
+  stats->misses = __atomic_load_n(&pool->misses, __ATOMIC_RELAXED);
+  stats->generated = __atomic_load_n(&pool->generated, __ATOMIC_RELAXED);
+  stats->refills = __atomic_load_n(&pool->refills, __ATOMIC_RELAXED);
+  stats->ready = pool_level(pool);
+}
@@ -0,0 +1,278 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "safegcd_x64.h"
+#include "fp25519_x64.h"
+#include "fp448_x64.h"
+
+#ifdef INV_SAFEGCD
+int inv_safegcd_x64 = 1;
+#else
+int inv_safegcd_x64 = 0;
+#endif
+
+/**
+ * Integers are represented in radix 2^62 with signed limbs, the top one
+ * carrying the sign; the layout follows the signed62 representation of
+ * libsecp256k1's modinv64. Each batch of 62 divsteps is accumulated into
+ * a 2x2 transition matrix that is then applied to the full-size numbers.
+ */
+__extension__ typedef __int128 int128_t;
+
+#define SAFEGCD_MAX_LIMBS 8
+#define M62 ((int64_t)(UINT64_MAX >> 2))
+
+typedef struct {
+  int64_t v[SAFEGCD_MAX_LIMBS];
+} Signed62;
+
+typedef struct {
+  int64_t u, v, q, r;
+} Trans2x2;
+
+typedef struct {
+  Signed62 modulus;       /* p in radix 2^62                           */
+  uint64_t modulus_inv62; /* p^-1 mod 2^62                             */
+  int limbs;              /* number of radix-2^62 limbs                */
+  int batches;            /* ceil(divsteps/62), with the bound of [BY19] */
+} ModInfo;
+
+/**
+ * Bounds from Theorem 11.2 of [BY19]: floor((49d+80)/17) divsteps with
+ * delta starting at 1 reach g = 0 for d-bit inputs, i.e., 739 for d=255
+ * and 1296 for d=448.
+ */
+static const ModInfo modinfo_25519 = {
+    {{-19, 0, 0, 0, 128}}, 0x39435e50d79435e5, 5, 12};
+
+static const ModInfo modinfo_448 = {
+    {{-1, 0, 0, -((int64_t)1 << 38), 0, 0, 0, (int64_t)1 << 14}},
+    0x3fffffffffffffff,
+    8,
+    21};
+
+/**
+ * Runs 62 divsteps on the low bits of f and g, with eta = -delta.
+ * Returns the new eta, and sets t such that
+ * 2^62 [f',g'] = t [f,g].
+ */
+static int64_t divsteps_62(int64_t eta, uint64_t f0, uint64_t g0,
+                           Trans2x2 *t) {
+  uint64_t u = 1, v = 0, q = 0, r = 1;
+  uint64_t c1, c2, f = f0, g = g0, x, y, z;
+  int i;
+
+  for (i = 0; i < 62; i++) {
+    /* c1 = -1 if delta > 0, c2 = -1 if g is odd */
+    c1 = (uint64_t)(eta >> 63);
+    c2 = -(g & 1);
+    /* If g is odd, subtract f (delta > 0) or add f (delta <= 0) to g */
+    x = (f ^ c1) - c1;
+    y = (u ^ c1) - c1;
+    z = (v ^ c1) - c1;
+    g += x & c2;
+    q += y & c2;
+    r += z & c2;
+    /* If delta > 0 and g was odd, swap: f = old g, delta = 1 - delta */
+    c1 &= c2;
+    eta = (eta ^ (int64_t)c1) - ((int64_t)c1 + 1);
+    f += g & c1;
+    u += q & c1;
+    v += r & c1;
+    g >>= 1;
+    u <<= 1;
+    v <<= 1;
+  }
+  t->u = (int64_t)u;
+  t->v = (int64_t)v;
+  t->q = (int64_t)q;
+  t->r = (int64_t)r;
+  return eta;
+}
+
+/**
+ * Sets [d,e] = t [d,e] / 2^62 mod p, adding multiples of p so that the
+ * division is exact. Inputs and outputs are in (-2p, p).
+ */
+static inline void update_de_62(Signed62 *d, Signed62 *e, const Trans2x2 *t,
+                                const ModInfo *m) {
+  const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+  const int64_t sd = d->v[m->limbs - 1] >> 63;
+  const int64_t se = e->v[m->limbs - 1] >> 63;
+  int64_t md, me;
+  int128_t cd, ce;
+  int i;
+
+  /* Adds [u,q] if d < 0 and [v,r] if e < 0, to keep the range */
+  md = (u & sd) + (v & se);
+  me = (q & sd) + (r & se);
+  cd = (int128_t)u * d->v[0] + (int128_t)v * e->v[0];
+  ce = (int128_t)q * d->v[0] + (int128_t)r * e->v[0];
+  /* Chooses md, me so that the low 62 bits of t[d,e]+p[md,me] vanish */
+  md -= (int64_t)((m->modulus_inv62 * (uint64_t)cd + (uint64_t)md) & M62);
+  me -= (int64_t)((m->modulus_inv62 * (uint64_t)ce + (uint64_t)me) & M62);
+  cd += (int128_t)m->modulus.v[0] * md;
+  ce += (int128_t)m->modulus.v[0] * me;
+  cd >>= 62;
+  ce >>= 62;
+  for (i = 1; i < m->limbs; i++) {
+    cd += (int128_t)u * d->v[i] + (int128_t)v * e->v[i];
+    ce += (int128_t)q * d->v[i] + (int128_t)r * e->v[i];
+    if (m->modulus.v[i]) {
+      cd += (int128_t)m->modulus.v[i] * md;
+      ce += (int128_t)m->modulus.v[i] * me;
+    }
+    d->v[i - 1] = (int64_t)cd & M62;
+    e->v[i - 1] = (int64_t)ce & M62;
+    cd >>= 62;
+    ce >>= 62;
+  }
+  d->v[m->limbs - 1] = (int64_t)cd;
+  e->v[m->limbs - 1] = (int64_t)ce;
+}
+
+/* Sets [f,g] = t [f,g] / 2^62, where the division is exact. */
+static inline void update_fg_62(Signed62 *f, Signed62 *g, const Trans2x2 *t,
+                                int limbs) {
+  const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+  int128_t cf, cg;
+  int i;
+
+  cf = (int128_t)u * f->v[0] + (int128_t)v * g->v[0];
+  cg = (int128_t)q * f->v[0] + (int128_t)r * g->v[0];
+  cf >>= 62;
+  cg >>= 62;
+  for (i = 1; i < limbs; i++) {
+    cf += (int128_t)u * f->v[i] + (int128_t)v * g->v[i];
+    cg += (int128_t)q * f->v[i] + (int128_t)r * g->v[i];
+    f->v[i - 1] = (int64_t)cf & M62;
+    g->v[i - 1] = (int64_t)cg & M62;
+    cf >>= 62;
+    cg >>= 62;
+  }
+  f->v[limbs - 1] = (int64_t)cf;
+  g->v[limbs - 1] = (int64_t)cg;
+}
+
+/* Adds p to x if x < 0; the sign is read from the top limb */
+static inline void cond_add_modulus_62(Signed62 *x, const ModInfo *m) {
+  const int64_t mask = x->v[m->limbs - 1] >> 63;
+  int i;
+  for (i = 0; i < m->limbs; i++) {
+    x->v[i] += m->modulus.v[i] & mask;
+  }
+}
+
+/* Brings the limbs of x back to [0, 2^62), except the top one */
+static inline void carry_62(Signed62 *x, int limbs) {
+  int i;
+  for (i = 0; i < limbs - 1; i++) {
+    x->v[i + 1] += x->v[i] >> 62;
+    x->v[i] &= M62;
+  }
+}
+
+/* Maps d from (-2p, p) to [0, p), negating it if sign < 0 */
+static inline void normalize_62(Signed62 *d, int64_t sign, const ModInfo *m) {
+  const int64_t neg = sign >> 63;
+  int i;
+  cond_add_modulus_62(d, m);
+  for (i = 0; i < m->limbs; i++) {
+    d->v[i] = (d->v[i] ^ neg) - neg;
+  }
+  carry_62(d, m->limbs);
+  cond_add_modulus_62(d, m);
+  carry_62(d, m->limbs);
+}
+
+/* Converts between 64-bit words and 62-bit limbs; both are little-endian */
+static inline void to_signed62(Signed62 *x, const uint64_t *a, int words,
+                               int limbs) {
+  int i;
+  for (i = 0; i < limbs; i++) {
+    const int bit = 62 * i, w = bit / 64, s = bit % 64;
+    uint64_t limb = a[w] >> s;
+    if (s > 2 && w + 1 < words) {
+      limb |= a[w + 1] << (64 - s);
+    }
+    x->v[i] = (int64_t)(limb & M62);
+  }
+}
+
+static inline void from_signed62(uint64_t *a, const Signed62 *x, int words) {
+  int i;
+  for (i = 0; i < words; i++) {
+    const int bit = 64 * i, l = bit / 62, s = bit % 62;
+    uint64_t word = (uint64_t)x->v[l] >> s;
+    word |= (uint64_t)x->v[l + 1] << (62 - s);
+    a[i] = word;
+  }
+}
+
+/* Sets x = x^-1 mod p, for 0 <= x < p; zero is mapped to zero. */
+static inline void safegcd_62(Signed62 *x, const ModInfo *m) {
+  Signed62 d = {{0}}, e = {{1}}, f = m->modulus, g = *x;
+  Trans2x2 t;
+  int64_t eta = -1;
+  int i;
+
+  for (i = 0; i < m->batches; i++) {
+    eta = divsteps_62(eta, (uint64_t)f.v[0], (uint64_t)g.v[0], &t);
+    update_de_62(&d, &e, &t, m);
+    update_fg_62(&f, &g, &t, m->limbs);
+  }
+  /* Now g = 0 and f = +/-1, so d*x = f mod p */
+  normalize_62(&d, f.v[m->limbs - 1], m);
+  *x = d;
+}
+
+void inv_safegcd_EltFp25519_1w_x64(uint64_t *const c, uint64_t *const a) {
+  EltFp25519_1w_x64 x;
+  Signed62 s;
+  copy_EltFp25519_1w_x64(x, a);
+  fred_EltFp25519_1w_x64(x);
+  to_signed62(&s, x, NUM_WORDS_ELTFP25519_X64, modinfo_25519.limbs);
+  safegcd_62(&s, &modinfo_25519);
+  from_signed62(c, &s, NUM_WORDS_ELTFP25519_X64);
+}
+
+void inv_safegcd_EltFp448_1w_x64(uint64_t *const c, uint64_t *const a) {
+  EltFp448_1w_x64 x;
+  Signed62 s;
+  copy_EltFp448_1w_x64(x, a);
+  fred_EltFp448_1w_x64(x);
+  to_signed62(&s, x, NUM_WORDS_ELTFP448_X64, modinfo_448.limbs);
+  safegcd_62(&s, &modinfo_448);
+  from_signed62(c, &s, NUM_WORDS_ELTFP448_X64);
+}
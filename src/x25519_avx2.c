@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <string.h>
+#include "fp25519_avx2.h"
+#include "fp25519_x64.h"
+#include "rfc7748_x64.h"
+#include "table_ladder_x25519.h"
+#include "x25519_avx2.h"
+
+void x25519_shared_secret_4w_avx2(argKey *shared, argKey *session_key,
+                                  argKey *private_key) {
+  EltFp25519_4w_avx2 X1, X2, Z2, X3, Z3;
+  EltFp25519_4w_avx2 A, B, C, D, AA, BB, E, DA, CB;
+  ALIGN uint64_t U[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t X[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t Z[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t key[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t mask[4];
+  uint64_t prev[4] = {0, 0, 0, 0};
+  int i = 0, lane = 0;
+
+  for (lane = 0; lane < 4; lane++) {
+    uint8_t *const k = (uint8_t *)(key + NUM_WORDS_ELTFP25519_X64 * lane);
+    memcpy(k, private_key[lane], X25519_KEYSIZE_BYTES);
+    memcpy(U + NUM_WORDS_ELTFP25519_X64 * lane, session_key[lane],
+           X25519_KEYSIZE_BYTES);
+
+    /* clampC function */
+    k[0] = k[0] & (~(uint8_t)0x7);
+    k[X25519_KEYSIZE_BYTES - 1] =
+        (uint8_t)64 | (k[X25519_KEYSIZE_BYTES - 1] & (uint8_t)0x7F);
+    /* As in x25519_shared_ladder_x64, the most significant bit is masked */
+    U[NUM_WORDS_ELTFP25519_X64 * lane + 3] &= ((uint64_t)1 << 63) - 1;
+  }
+
+  load_EltFp25519_4w_avx2(X1, U);
+  for (i = 0; i < NUM_WORDS_ELTFP25519_AVX2; i++) {
+    X2[i] = i < 4;
+    Z2[i] = 0;
+    X3[i] = X1[i];
+    Z3[i] = i < 4;
+  }
+
+  /* main-loop, as in the RFC-7748 */
+  for (i = 254; i >= 0; i--) {
+    for (lane = 0; lane < 4; lane++) {
+      const uint64_t bit =
+          (key[NUM_WORDS_ELTFP25519_X64 * lane + i / 64] >> (i % 64)) & 0x1;
+      mask[lane] = -(bit ^ prev[lane]);
+      prev[lane] = bit;
+    }
+    cswap_EltFp25519_4w_avx2(mask, X2, X3);
+    cswap_EltFp25519_4w_avx2(mask, Z2, Z3);
+
+    add_EltFp25519_4w_avx2(A, X2, Z2);   /* A = (X2+Z2)          */
+    sub_EltFp25519_4w_avx2(B, X2, Z2);   /* B = (X2-Z2)          */
+    add_EltFp25519_4w_avx2(C, X3, Z3);   /* C = (X3+Z3)          */
+    sub_EltFp25519_4w_avx2(D, X3, Z3);   /* D = (X3-Z3)          */
+    mul_EltFp25519_4w_avx2(DA, D, A);    /* DA = D*A             */
+    mul_EltFp25519_4w_avx2(CB, C, B);    /* CB = C*B             */
+    sqr_EltFp25519_4w_avx2(AA, A);       /* AA = A^2             */
+    sqr_EltFp25519_4w_avx2(BB, B);       /* BB = B^2             */
+
+    add_EltFp25519_4w_avx2(X3, DA, CB);  /* X3 = (DA+CB)^2       */
+    sqr_EltFp25519_4w_avx2(X3, X3);
+    sub_EltFp25519_4w_avx2(Z3, DA, CB);  /* Z3 = X1*(DA-CB)^2    */
+    sqr_EltFp25519_4w_avx2(Z3, Z3);
+    mul_EltFp25519_4w_avx2(Z3, Z3, X1);
+
+    sub_EltFp25519_4w_avx2(E, AA, BB);   /* E = AA-BB            */
+    mul_EltFp25519_4w_avx2(X2, AA, BB);  /* X2 = AA*BB           */
+    mul_a24_EltFp25519_4w_avx2(Z2, E);   /* Z2 = E*(BB+a24*E)    */
+    add_EltFp25519_4w_avx2(Z2, Z2, BB);
+    mul_EltFp25519_4w_avx2(Z2, Z2, E);
+  }
+  /* The last three bits of the keys are zero, so no final swap is needed */
+
+  store_EltFp25519_4w_avx2(X, X2);
+  store_EltFp25519_4w_avx2(Z, Z2);
+  x25519_impl_x64->to_affine_4w(shared, X, Z);
+}
+
+/**
+ * Computes four public keys at once with the precomputed ladder of
+ * x25519_keygen_precmp_ladder_x64; all lanes read the same table entry at
+ * each step, so it is converted once and broadcast to the four lanes.
+ */
+void x25519_keygen_precmp_4w_avx2(argKey *session_key, argKey *private_key) {
+  EltFp25519_4w_avx2 Ur1, Zr1, Ur2, Zr2, M, A, B, C, D;
+  ALIGN uint64_t U[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t Z[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t key[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t mask[4];
+  uint64_t swap[4] = {1, 1, 1, 1};
+  /* G-S */
+  ALIGN uint64_t GS[NUM_WORDS_ELTFP25519_X64] = {
+      0x7e94e1fec82faabd, 0xbbf095ae14b2edf8, 0xadc7a0b9235d48e2,
+      0x1eaecdeee27cab34};
+  const int q = 3;
+  int i = 0, lane = 0;
+
+  for (lane = 0; lane < 4; lane++) {
+    uint8_t *const k = (uint8_t *)(key + NUM_WORDS_ELTFP25519_X64 * lane);
+    memcpy(k, private_key[lane], X25519_KEYSIZE_BYTES);
+
+    /* clampC function */
+    k[0] = k[0] & (~(uint8_t)0x7);
+    k[X25519_KEYSIZE_BYTES - 1] =
+        (uint8_t)64 | (k[X25519_KEYSIZE_BYTES - 1] & (uint8_t)0x7F);
+  }
+
+  broadcast_EltFp25519_4w_avx2(Ur2, GS);
+  for (i = 0; i < NUM_WORDS_ELTFP25519_AVX2; i++) {
+    Ur1[i] = i < 4;
+    Zr1[i] = i < 4;
+    Zr2[i] = i < 4;
+  }
+
+  /* main-loop */
+  for (i = q; i < 255; i++) {
+    for (lane = 0; lane < 4; lane++) {
+      const uint64_t bit =
+          (key[NUM_WORDS_ELTFP25519_X64 * lane + i / 64] >> (i % 64)) & 0x1;
+      mask[lane] = -(swap[lane] ^ bit);
+      swap[lane] = bit;
+    }
+    cswap_EltFp25519_4w_avx2(mask, Ur1, Ur2);
+    cswap_EltFp25519_4w_avx2(mask, Zr1, Zr2);
+
+    broadcast_EltFp25519_4w_avx2(
+        M, (uint64_t *)&Table_Ladder_8k[NUM_WORDS_ELTFP25519_X64 * (i - q)]);
+    /** Addition */
+    sub_EltFp25519_4w_avx2(B, Ur1, Zr1); /* B = Ur1-Zr1                 */
+    add_EltFp25519_4w_avx2(A, Ur1, Zr1); /* A = Ur1+Zr1                 */
+    carry_EltFp25519_4w_avx2(A);
+    mul_EltFp25519_4w_avx2(C, M, B);     /* C = M*B                     */
+    sub_EltFp25519_4w_avx2(B, A, C);     /* B = (Ur1+Zr1) - M*(Ur1-Zr1) */
+    add_EltFp25519_4w_avx2(A, A, C);     /* A = (Ur1+Zr1) + M*(Ur1-Zr1) */
+    sqr_EltFp25519_4w_avx2(A, A);        /* A = A^2                     */
+    sqr_EltFp25519_4w_avx2(B, B);        /* B = B^2                     */
+    mul_EltFp25519_4w_avx2(Ur1, Zr2, A); /* Ur1 = Zr2*A                 */
+    mul_EltFp25519_4w_avx2(Zr1, Ur2, B); /* Zr1 = Ur2*B                 */
+  }
+
+  /** Doubling */
+  for (i = 0; i < q; i++) {
+    add_EltFp25519_4w_avx2(A, Ur1, Zr1); /*  A = Ur1+Zr1   */
+    sub_EltFp25519_4w_avx2(B, Ur1, Zr1); /*  B = Ur1-Zr1   */
+    sqr_EltFp25519_4w_avx2(A, A);        /*  A = A**2      */
+    sqr_EltFp25519_4w_avx2(B, B);        /*  B = B**2      */
+    sub_EltFp25519_4w_avx2(C, A, B);     /*  C = A-B       */
+    mul_a24_EltFp25519_4w_avx2(D, C);    /*  D = my_a24*C  */
+    add_EltFp25519_4w_avx2(D, D, B);     /*  D = D+B       */
+    mul_EltFp25519_4w_avx2(Ur1, A, B);   /*  Ur1 = A*B     */
+    mul_EltFp25519_4w_avx2(Zr1, C, D);   /*  Zr1 = C*D     */
+  }
+
+  /* Convert to affine coordinates */
+  store_EltFp25519_4w_avx2(U, Ur1);
+  store_EltFp25519_4w_avx2(Z, Zr1);
+  x25519_impl_x64->to_affine_4w(session_key, U, Z);
+}
@@ -35,9 +35,14 @@
 
 #include <string.h>
 #include "fp25519_x64.h"
-#include "rfc7748_precomputed.h"
+#include "fp25519_x64_inline.h"
+#include "rfc7748_x64.h"
+#include "table_comb_x25519.h"
 #include "table_ladder_x25519.h"
 
+/* Number of keys sharing one inversion in the batch functions */
+#define BATCH_SIZE_X25519 64
+
 static inline void cswap(uint8_t bit, uint64_t *const px, uint64_t *const py) {
   uint64_t temp;
   __asm__ __volatile__(
@@ -52,50 +57,58 @@ static inline void cswap(uint8_t bit, uint64_t *const px, uint64_t *const py) {
       : "cc");
 }
 
-static inline void cselect(uint8_t bit, uint64_t *const px,
-                           uint64_t *const py) {
-  __asm__ __volatile__(
-      "test %4, %4;"
-      "cmovnzq %5, %0; cmovnzq %6, %1; cmovnzq %7, %2; cmovnzq %8, %3;"
-      : "+r"(px[0]), "+r"(px[1]), "+r"(px[2]), "+r"(px[3])
-      : "r"(bit), "rm"(py[0]), "rm"(py[1]), "rm"(py[2]), "rm"(py[3])
-      : "cc");
-}
-
-static void x25519_shared_secret_x64(argKey shared, argKey session_key,
-                                     argKey private_key) {
-  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP25519_X64];
+/**
+ * Runs the Montgomery ladder over bits 254, ..., 0 of key, which is not
+ * clamped, and returns the projective coordinates (X:Z) of key*(X1:1).
+ */
+static void x25519_ladder_x64(uint64_t *const X, uint64_t *const Z,
+                              uint64_t *const X1, const uint64_t *const key) {
   ALIGN uint64_t coordinates[4 * NUM_WORDS_ELTFP25519_X64];
-  ALIGN uint64_t workspace[6 * NUM_WORDS_ELTFP25519_X64];
-  ALIGN uint8_t session[X25519_KEYSIZE_BYTES];
-  ALIGN uint8_t private[X25519_KEYSIZE_BYTES];
 
   int i = 0, j = 0;
   uint64_t prev = 0;
-  uint64_t *const X1 = (uint64_t *)session;
-  uint64_t *const key = (uint64_t *)private;
-  uint64_t *const Px = coordinates + 0;
-  uint64_t *const Pz = coordinates + 4;
-  uint64_t *const Qx = coordinates + 8;
-  uint64_t *const Qz = coordinates + 12;
-  uint64_t *const X2 = Qx;
-  uint64_t *const Z2 = Qz;
-  uint64_t *const X3 = Px;
-  uint64_t *const Z3 = Pz;
-  uint64_t *const X2Z2 = Qx;
-  uint64_t *const X3Z3 = Px;
+  uint64_t *const X2 = coordinates + 0;
+  uint64_t *const Z2 = coordinates + 4;
+  uint64_t *const X3 = coordinates + 8;
+  uint64_t *const Z3 = coordinates + 12;
 
-  uint64_t *const A = workspace + 0;
-  uint64_t *const B = workspace + 4;
-  uint64_t *const D = workspace + 8;
-  uint64_t *const C = workspace + 12;
-  uint64_t *const DA = workspace + 16;
-  uint64_t *const CB = workspace + 20;
-  uint64_t *const AB = A;
-  uint64_t *const DC = D;
-  uint64_t *const DACB = DA;
-  uint64_t *const buffer_1w = buffer;
-  uint64_t *const buffer_2w = buffer;
+  copy_EltFp25519_1w_x64(X3, X1);
+  setzero_EltFp25519_1w_x64(Z3);
+  setzero_EltFp25519_1w_x64(X2);
+  setzero_EltFp25519_1w_x64(Z2);
+
+  Z3[0] = 1;
+  X2[0] = 1;
+
+  /* main-loop */
+  prev = 0;
+  j = 62;
+  for (i = 3; i >= 0; i--) {
+    while (j >= 0) {
+      uint64_t bit = (key[i] >> j) & 0x1;
+      uint64_t swap = bit ^ prev;
+      prev = bit;
+      ladder_step_EltFp25519_x64(coordinates, X1, swap);
+      j--;
+    }
+    j = 63;
+  }
+  /* Clamped keys end with a zero bit, so this swap is only for the others */
+  cswap((uint8_t)prev, X2, X3);
+  cswap((uint8_t)prev, Z2, Z3);
+
+  copy_EltFp25519_1w_x64(X, X2);
+  copy_EltFp25519_1w_x64(Z, Z2);
+}
+
+/**
+ * Runs the Montgomery ladder and returns the projective coordinates (X:Z)
+ * of the shared secret.
+ */
+static void x25519_shared_ladder_x64(uint64_t *const X, uint64_t *const Z,
+                                     argKey session_key, argKey private_key) {
+  ALIGN uint8_t session[X25519_KEYSIZE_BYTES];
+  ALIGN uint8_t private[X25519_KEYSIZE_BYTES];
 
   memcpy(private, private_key, sizeof(private));
   memcpy(session, session_key, sizeof(session));
@@ -117,55 +130,217 @@ static void x25519_shared_secret_x64(argKey shared, argKey session_key,
    **/
   session[X25519_KEYSIZE_BYTES - 1] &= (1 << (255 % 8)) - 1;
 
-  copy_EltFp25519_1w_x64(Px, X1);
-  setzero_EltFp25519_1w_x64(Pz);
-  setzero_EltFp25519_1w_x64(Qx);
-  setzero_EltFp25519_1w_x64(Qz);
+  x25519_ladder_x64(X, Z, (uint64_t *)session, (uint64_t *)private);
+}
 
-  Pz[0] = 1;
-  Qx[0] = 1;
+static void x25519_shared_secret_x64(argKey shared, argKey session_key,
+                                     argKey private_key) {
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  EltFp25519_1w_x64 X, Z, invZ;
 
-  /* main-loop */
-  prev = 0;
-  j = 62;
-  for (i = 3; i >= 0; i--) {
-    while (j >= 0) {
-      uint64_t bit = (key[i] >> j) & 0x1;
-      uint64_t swap = bit ^ prev;
-      prev = bit;
+  x25519_shared_ladder_x64(X, Z, session_key, private_key);
+
+  inv_EltFp25519_1w_x64(invZ, Z);
+  mul_EltFp25519_1w_x64((uint64_t *)shared, X, invZ);
+  fred_EltFp25519_1w_x64_inline((uint64_t *)shared);
+}
+
+/**
+ * Computes N shared secrets; the conversions to affine coordinates of each
+ * group of up to BATCH_SIZE_X25519 secrets share a single field inversion.
+ * Outputs are identical to those of x25519_shared_secret_x64.
+ */
+static void x25519_shared_secret_batch_x64(argKey *shared, argKey *session_key,
+                                           argKey *private_key,
+                                           unsigned int n) {
+  ALIGN uint64_t X[BATCH_SIZE_X25519 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t Z[BATCH_SIZE_X25519 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t invZ[BATCH_SIZE_X25519 * NUM_WORDS_ELTFP25519_X64];
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  unsigned int i = 0, k = 0, len = 0;
+
+  for (k = 0; k < n; k += len) {
+    len = n - k < BATCH_SIZE_X25519 ? n - k : BATCH_SIZE_X25519;
+    for (i = 0; i < len; i++) {
+      x25519_shared_ladder_x64(X + NUM_WORDS_ELTFP25519_X64 * i,
+                               Z + NUM_WORDS_ELTFP25519_X64 * i,
+                               session_key[k + i], private_key[k + i]);
+    }
+
+    inv_batch_EltFp25519_1w_x64(invZ, Z, len);
+    for (i = 0; i < len; i++) {
+      uint64_t *const secret = (uint64_t *)shared[k + i];
+      mul_EltFp25519_1w_x64(secret, X + NUM_WORDS_ELTFP25519_X64 * i,
+                            invZ + NUM_WORDS_ELTFP25519_X64 * i);
+      fred_EltFp25519_1w_x64_inline(secret);
+    }
+  }
+}
 
-      add_EltFp25519_1w_x64(A, X2, Z2);    /* A = (X2+Z2)                   */
-      sub_EltFp25519_1w_x64(B, X2, Z2);    /* B = (X2-Z2)                   */
-      add_EltFp25519_1w_x64(C, X3, Z3);    /* C = (X3+Z3)                   */
-      sub_EltFp25519_1w_x64(D, X3, Z3);    /* D = (X3-Z3)                   */
-      mul_EltFp25519_2w_x64(DACB, AB, DC); /* [DA|CB] = [A|B]*[D|C]         */
+/**
+ * Selects, in constant time, entry |digit| of row i of Table_Comb_24k, or
+ * (1, 1, 0) if digit is zero; negative digits select the opposite point,
+ * i.e., y-x and y+x are swapped and 2dxy is negated.
+ */
+static void x25519_comb_select_x64(uint64_t *const T, int i, int8_t digit) {
+  const uint64_t *const row = Table_Comb_24k + 8 * 3 * 4 * i;
+  const uint64_t negative = (uint64_t)(int64_t)digit >> 63;
+  const uint64_t abs = ((uint64_t)(int64_t)digit ^ -negative) + negative;
+  EltFp25519_1w_x64 zero = {0}, minus;
+  uint64_t j = 0, w = 0, mask = 0, t = 0;
+
+  for (w = 0; w < 12; w++) {
+    T[w] = w == 0 || w == 4;
+  }
+  for (j = 1; j <= 8; j++) {
+    mask = -(((abs ^ j) - 1) >> 63);
+    for (w = 0; w < 12; w++) {
+      T[w] ^= (T[w] ^ row[12 * (j - 1) + w]) & mask;
+    }
+  }
 
-      cselect(swap, A, C);
-      cselect(swap, B, D);
+  mask = -negative;
+  sub_EltFp25519_1w_x64_inline(minus, zero, T + 8);
+  for (w = 0; w < 4; w++) {
+    t = (T[w] ^ T[w + 4]) & mask;
+    T[w] ^= t;
+    T[w + 4] ^= t;
+    T[w + 8] ^= (T[w + 8] ^ minus[w]) & mask;
+  }
+}
 
-      sqr_EltFp25519_2w_x64(AB);         /* [AA|BB] = [A^2|B^2]           */
-      add_EltFp25519_1w_x64(X3, DA, CB); /* X3 = (DA+CB)                  */
-      sub_EltFp25519_1w_x64(Z3, DA, CB); /* Z3 = (DA-CB)                  */
-      sqr_EltFp25519_2w_x64(X3Z3);       /* [X3|Z3] = [(DA+CB)|(DA+CB)]^2 */
+/**
+ * Computes the point P = [X|Y|T|Z], in extended coordinates, from the
+ * values EG = [E|G] and FH = [F|H] of the addition and doubling formulas.
+ */
+static inline void x25519_comb_p1p1_x64(uint64_t *const P, uint64_t *const EG,
+                                        uint64_t *const FH) {
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t EF[2 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t HG[2 * NUM_WORDS_ELTFP25519_X64];
+  uint64_t *const buffer_2w = buffer;
 
-      copy_EltFp25519_1w_x64(X2, B);   /* X2 = B^2                      */
-      sub_EltFp25519_1w_x64(Z2, A, B); /* Z2 = E = AA-BB                */
+  copy_EltFp25519_1w_x64(EF + 0, EG + 0);
+  copy_EltFp25519_1w_x64(EF + 4, FH + 0);
+  copy_EltFp25519_1w_x64(HG + 0, FH + 4);
+  copy_EltFp25519_1w_x64(HG + 4, EG + 4);
+  mul_EltFp25519_2w_x64(P + 0, EG, FH);         /* [X|Y] = [E*F|G*H]       */
+  mul_EltFp25519_2w_x64(P + 8, EF, HG);         /* [T|Z] = [E*H|F*G]       */
+}
 
-      mul_a24_EltFp25519_1w_x64(B, Z2);      /* B = a24*E                     */
-      add_EltFp25519_1w_x64(B, B, X2);       /* B = a24*E+B                   */
-      mul_EltFp25519_2w_x64(X2Z2, X2Z2, AB); /* [X2|Z2] = [B|E]*[A|a24*E+B]   */
-      mul_EltFp25519_1w_x64(Z3, Z3, X1);     /* Z3 = Z3*X1                    */
-      j--;
+/* P = P + Q, where Q = [y-x|y+x|2dxy] is an entry of Table_Comb_24k */
+static void x25519_comb_madd_x64(uint64_t *const P, uint64_t *const Q) {
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t AB[2 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t EG[2 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t FH[2 * NUM_WORDS_ELTFP25519_X64];
+  EltFp25519_1w_x64 C, D;
+  uint64_t *const X = P + 0, *const Y = P + 4, *const T = P + 8;
+  uint64_t *const Z = P + 12, *const A = AB + 0, *const B = AB + 4;
+  uint64_t *const buffer_1w = buffer;
+  uint64_t *const buffer_2w = buffer;
+
+  sub_EltFp25519_1w_x64_inline(A, Y, X);        /* A = Y-X                 */
+  add_EltFp25519_1w_x64_inline(B, Y, X);        /* B = Y+X                 */
+  mul_EltFp25519_2w_x64(AB, AB, Q);             /* [A|B] = [A|B]*[y-x|y+x] */
+  mul_EltFp25519_1w_x64(C, T, Q + 8);           /* C = T*2dxy              */
+  add_EltFp25519_1w_x64_inline(D, Z, Z);        /* D = 2Z                  */
+  sub_EltFp25519_1w_x64_inline(EG + 0, B, A);   /* E = B-A                 */
+  add_EltFp25519_1w_x64_inline(EG + 4, D, C);   /* G = D+C                 */
+  sub_EltFp25519_1w_x64_inline(FH + 0, D, C);   /* F = D-C                 */
+  add_EltFp25519_1w_x64_inline(FH + 4, B, A);   /* H = B+A                 */
+  x25519_comb_p1p1_x64(P, EG, FH);
+}
+
+/* P = 2P */
+static void x25519_comb_dbl_x64(uint64_t *const P) {
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t XY[2 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t SZ[2 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t EG[2 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t FH[2 * NUM_WORDS_ELTFP25519_X64];
+  EltFp25519_1w_x64 C;
+  uint64_t *const X = P + 0, *const Y = P + 4, *const Z = P + 12;
+  uint64_t *const XX = XY + 0, *const YY = XY + 4;
+  uint64_t *const buffer_2w = buffer;
+
+  copy_EltFp25519_1w_x64(XX, X);
+  copy_EltFp25519_1w_x64(YY, Y);
+  add_EltFp25519_1w_x64_inline(SZ, X, Y);
+  copy_EltFp25519_1w_x64(SZ + 4, Z);
+  sqr_EltFp25519_2w_x64(XY);                    /* [XX|YY] = [X^2|Y^2]     */
+  sqr_EltFp25519_2w_x64(SZ);                    /* [S|ZZ] = [(X+Y)^2|Z^2]  */
+  add_EltFp25519_1w_x64_inline(FH + 4, YY, XX); /* H = YY+XX               */
+  sub_EltFp25519_1w_x64_inline(EG + 4, YY, XX); /* G = YY-XX               */
+  sub_EltFp25519_1w_x64_inline(EG + 0, SZ, FH + 4); /* E = S-H             */
+  add_EltFp25519_1w_x64_inline(C, SZ + 4, SZ + 4);  /* C = 2ZZ             */
+  sub_EltFp25519_1w_x64_inline(FH + 0, C, EG + 4);  /* F = C-G             */
+  x25519_comb_p1p1_x64(P, EG, FH);
+}
+
+/**
+ * Computes the public key with the signed radix-16 comb of Bernstein et
+ * al., "High-speed high-security signatures" (2011), on the Edwards curve
+ * birationally equivalent to Curve25519: the clamped key is recoded into
+ * 64 digits in [-8,8], which select 64 entries of Table_Comb_24k, and the
+ * sum k*B = (X:Y:Z) maps to the projective u-coordinate (Z+Y : Z-Y).
+ */
+static void x25519_keygen_comb_x64(uint64_t *const U, uint64_t *const Z,
+                                   argKey private_key) {
+  ALIGN uint64_t point[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t entry[3 * NUM_WORDS_ELTFP25519_X64];
+  int8_t digits[2 * X25519_KEYSIZE_BYTES];
+  int8_t carry = 0;
+  int i = 0;
+
+  for (i = 0; i < X25519_KEYSIZE_BYTES; i++) {
+    uint8_t byte = private_key[i];
+    if (i == 0) {
+      byte &= 0xF8;
+    } else if (i == X25519_KEYSIZE_BYTES - 1) {
+      byte = (byte & 0x7F) | 0x40;
     }
-    j = 63;
+    digits[2 * i + 0] = byte & 0xF;
+    digits[2 * i + 1] = byte >> 4;
+  }
+  for (i = 0; i < 2 * X25519_KEYSIZE_BYTES - 1; i++) {
+    digits[i] += carry;
+    carry = (digits[i] + 8) >> 4;
+    digits[i] -= carry << 4;
   }
+  digits[2 * X25519_KEYSIZE_BYTES - 1] += carry;
 
-  inv_EltFp25519_1w_x64(A, Qz);
-  mul_EltFp25519_1w_x64((uint64_t *)shared, Qx, A);
-  fred_EltFp25519_1w_x64((uint64_t *)shared);
+  /* point = (X:Y:T:Z) = (0:1:0:1) */
+  for (i = 0; i < 4 * NUM_WORDS_ELTFP25519_X64; i++) {
+    point[i] = i == 4 || i == 12;
+  }
+  for (i = 1; i < 2 * X25519_KEYSIZE_BYTES; i += 2) {
+    x25519_comb_select_x64(entry, i / 2, digits[i]);
+    x25519_comb_madd_x64(point, entry);
+  }
+  for (i = 0; i < 4; i++) {
+    x25519_comb_dbl_x64(point);
+  }
+  for (i = 0; i < 2 * X25519_KEYSIZE_BYTES; i += 2) {
+    x25519_comb_select_x64(entry, i / 2, digits[i]);
+    x25519_comb_madd_x64(point, entry);
+  }
+
+  add_EltFp25519_1w_x64_inline(U, point + 12, point + 4);
+  sub_EltFp25519_1w_x64_inline(Z, point + 12, point + 4);
 }
 
-static void x25519_keygen_precmp_x64(argKey session_key, argKey private_key) {
+/**
+ * Runs the precomputed ladder over the table of M_k = (u_k+1)/(u_k-1),
+ * where u_k is the u-coordinate of 2^k*P, and returns the projective
+ * coordinates (U:Z) of k*P for the clamped private key k. The ladder
+ * starts from S, a point of order 4 with u = 1, and from P-S, whose
+ * u-coordinate is start; the last three doublings remove S.
+ */
+static void x25519_precmp_ladder_x64(uint64_t *const U, uint64_t *const Z,
+                                     const uint64_t *const table,
+                                     const uint64_t *const start,
+                                     argKey private_key) {
   ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP25519_X64];
   ALIGN uint64_t coordinates[4 * NUM_WORDS_ELTFP25519_X64];
   ALIGN uint64_t workspace[4 * NUM_WORDS_ELTFP25519_X64];
@@ -191,7 +366,7 @@ static void x25519_keygen_precmp_x64(argKey session_key, argKey private_key) {
 
   uint64_t *const buffer_1w = buffer;
   uint64_t *const buffer_2w = buffer;
-  uint64_t *P = (uint64_t *)Table_Ladder_8k;
+  uint64_t *P = (uint64_t *)table;
 
   memcpy(private, private_key, sizeof(private));
 
@@ -209,11 +384,8 @@ static void x25519_keygen_precmp_x64(argKey session_key, argKey private_key) {
   Zr1[0] = 1;
   Zr2[0] = 1;
 
-  /* G-S */
-  Ur2[3] = 0x1eaecdeee27cab34;
-  Ur2[2] = 0xadc7a0b9235d48e2;
-  Ur2[1] = 0xbbf095ae14b2edf8;
-  Ur2[0] = 0x7e94e1fec82faabd;
+  /* P-S */
+  copy_EltFp25519_1w_x64(Ur2, start);
 
   /* main-loop */
   const int ite[4] = {64, 64, 64, 63};
@@ -230,13 +402,13 @@ static void x25519_keygen_precmp_x64(argKey session_key, argKey private_key) {
       cswap(swap, Zr1, Zr2);
       swap = bit;
       /** Addition */
-      sub_EltFp25519_1w_x64(B, Ur1, Zr1);     /* B = Ur1-Zr1                 */
-      add_EltFp25519_1w_x64(A, Ur1, Zr1);     /* A = Ur1+Zr1                 */
-      mul_EltFp25519_1w_x64(C, &P[4 * k], B); /* C = M0-B                    */
-      sub_EltFp25519_1w_x64(B, A, C);         /* B = (Ur1+Zr1) - M*(Ur1-Zr1) */
-      add_EltFp25519_1w_x64(A, A, C);         /* A = (Ur1+Zr1) + M*(Ur1-Zr1) */
-      sqr_EltFp25519_2w_x64(AB);              /* A = A^2      |  B = B^2     */
-      mul_EltFp25519_2w_x64(UZr1, ZUr2, AB);  /* Ur1 = Zr2*A  |  Zr1 = Ur2*B */
+      sub_EltFp25519_1w_x64_inline(B, Ur1, Zr1);  /* B = Ur1-Zr1                 */
+      add_EltFp25519_1w_x64_inline(A, Ur1, Zr1);  /* A = Ur1+Zr1                 */
+      mul_EltFp25519_1w_x64(C, &P[4 * k], B);     /* C = M0-B                    */
+      sub_EltFp25519_1w_x64_inline(B, A, C);      /* B = (Ur1+Zr1) - M*(Ur1-Zr1) */
+      add_EltFp25519_1w_x64_inline(A, A, C);      /* A = (Ur1+Zr1) + M*(Ur1-Zr1) */
+      sqr_EltFp25519_2w_x64(AB);                  /* A = A^2      |  B = B^2     */
+      mul_EltFp25519_2w_x64(UZr1, ZUr2, AB);      /* Ur1 = Zr2*A  |  Zr1 = Ur2*B */
       j++;
     }
     j = 0;
@@ -244,21 +416,243 @@ static void x25519_keygen_precmp_x64(argKey session_key, argKey private_key) {
 
   /** Doubling */
   for (i = 0; i < q; i++) {
-    add_EltFp25519_1w_x64(A, Ur1, Zr1);  /*  A = Ur1+Zr1   */
-    sub_EltFp25519_1w_x64(B, Ur1, Zr1);  /*  B = Ur1-Zr1   */
-    sqr_EltFp25519_2w_x64(AB);           /*  A = A**2     B = B**2   */
-    copy_EltFp25519_1w_x64(C, B);        /*  C = B         */
-    sub_EltFp25519_1w_x64(B, A, B);      /*  B = A-B       */
-    mul_a24_EltFp25519_1w_x64(D, B);     /*  D = my_a24*B  */
-    add_EltFp25519_1w_x64(D, D, C);      /*  D = D+C       */
-    mul_EltFp25519_2w_x64(UZr1, AB, CD); /*  Ur1 = A*B   Zr1 = Zr1*A */
+    add_EltFp25519_1w_x64_inline(A, Ur1, Zr1);  /*  A = Ur1+Zr1   */
+    sub_EltFp25519_1w_x64_inline(B, Ur1, Zr1);  /*  B = Ur1-Zr1   */
+    sqr_EltFp25519_2w_x64(AB);                  /*  A = A**2     B = B**2   */
+    copy_EltFp25519_1w_x64(C, B);               /*  C = B         */
+    sub_EltFp25519_1w_x64_inline(B, A, B);      /*  B = A-B       */
+    mul_a24_EltFp25519_1w_x64_inline(D, B);     /*  D = my_a24*B  */
+    add_EltFp25519_1w_x64_inline(D, D, C);      /*  D = D+C       */
+    mul_EltFp25519_2w_x64(UZr1, AB, CD);        /*  Ur1 = A*B   Zr1 = Zr1*A */
   }
 
+  copy_EltFp25519_1w_x64(U, Ur1);
+  copy_EltFp25519_1w_x64(Z, Zr1);
+}
+
+/* u-coordinate of the base point, used when KeyGen runs without a table */
+ALIGN static const uint8_t base_point_x25519[X25519_KEYSIZE_BYTES] = {9};
+
+/* u-coordinate of G-S, where G is the base point */
+ALIGN static const uint64_t ladder_start_x25519[NUM_WORDS_ELTFP25519_X64] = {
+    0x7e94e1fec82faabd, 0xbbf095ae14b2edf8, 0xadc7a0b9235d48e2,
+    0x1eaecdeee27cab34};
+
+/**
+ * Runs the precomputed ladder over Table_Ladder_8k and returns the
+ * projective coordinates (U:Z) of the public key. With RFC7748_TABLE_NONE,
+ * it runs the ladder of the shared secret on the base point instead, and
+ * with RFC7748_TABLE_COMB, the comb above.
+ */
+static void x25519_keygen_precmp_ladder_x64(uint64_t *const U,
+                                            uint64_t *const Z,
+                                            argKey private_key) {
+  if (keygen_table_x64 == RFC7748_TABLE_NONE) {
+    x25519_shared_ladder_x64(U, Z, (argKey)base_point_x25519, private_key);
+    return;
+  }
+  if (keygen_table_x64 == RFC7748_TABLE_COMB) {
+    x25519_keygen_comb_x64(U, Z, private_key);
+    return;
+  }
+  x25519_precmp_ladder_x64(U, Z, Table_Ladder_8k, ladder_start_x25519,
+                           private_key);
+}
+
+static void x25519_keygen_precmp_x64(argKey session_key, argKey private_key) {
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  EltFp25519_1w_x64 U, Z, invZ;
+
+  x25519_keygen_precmp_ladder_x64(U, Z, private_key);
+
   /* Convert to affine coordinates */
-  inv_EltFp25519_1w_x64(A, Zr1);
-  mul_EltFp25519_1w_x64((uint64_t *)session_key, Ur1, A);
-  fred_EltFp25519_1w_x64((uint64_t *)session_key);
+  inv_EltFp25519_1w_x64(invZ, Z);
+  mul_EltFp25519_1w_x64((uint64_t *)session_key, U, invZ);
+  fred_EltFp25519_1w_x64_inline((uint64_t *)session_key);
+}
+
+/**
+ * Computes N public keys; the conversions to affine coordinates of each
+ * group of up to BATCH_SIZE_X25519 keys share a single field inversion.
+ */
+static void x25519_keygen_precmp_batch_x64(argKey *session_key,
+                                           argKey *private_key,
+                                           unsigned int n) {
+  ALIGN uint64_t U[BATCH_SIZE_X25519 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t Z[BATCH_SIZE_X25519 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t invZ[BATCH_SIZE_X25519 * NUM_WORDS_ELTFP25519_X64];
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  unsigned int i = 0, k = 0, len = 0;
+
+  for (k = 0; k < n; k += len) {
+    len = n - k < BATCH_SIZE_X25519 ? n - k : BATCH_SIZE_X25519;
+    for (i = 0; i < len; i++) {
+      x25519_keygen_precmp_ladder_x64(U + NUM_WORDS_ELTFP25519_X64 * i,
+                                      Z + NUM_WORDS_ELTFP25519_X64 * i,
+                                      private_key[k + i]);
+    }
+
+    /* Convert to affine coordinates */
+    inv_batch_EltFp25519_1w_x64(invZ, Z, len);
+    for (i = 0; i < len; i++) {
+      uint64_t *const pub = (uint64_t *)session_key[k + i];
+      mul_EltFp25519_1w_x64(pub, U + NUM_WORDS_ELTFP25519_X64 * i,
+                            invZ + NUM_WORDS_ELTFP25519_X64 * i);
+      fred_EltFp25519_1w_x64_inline(pub);
+    }
+  }
+}
+
+/* Offsets in X25519_PEER_TABLE of the entries, start, public key and flag */
+#define PEER_ENTRIES_X25519 252
+#define PEER_START_X25519 (NUM_WORDS_ELTFP25519_X64 * PEER_ENTRIES_X25519)
+#define PEER_KEY_X25519 (PEER_START_X25519 + NUM_WORDS_ELTFP25519_X64)
+#define PEER_FLAG_X25519 (PEER_KEY_X25519 + NUM_WORDS_ELTFP25519_X64)
+
+/* Order of the base point, 2^252 + 27742317777372353535851937790883648493 */
+ALIGN static const uint64_t order_x25519[NUM_WORDS_ELTFP25519_X64] = {
+    0x5812631a5cf5d3ed, 0x14def9dea2f79cd6, 0x0000000000000000,
+    0x1000000000000000};
+
+/**
+ * Builds the table of x25519_precmp_ladder_x64 for the public key P of a
+ * peer: the M_k come from 252 doublings of P, and the start point P-S from
+ * the addition of P and S = (1, sqrt(A+2)). Every denominator shares one
+ * batch inversion. The ladder is only correct when S is not a multiple of
+ * P, so the table is flagged as unusable unless P has order l.
+ */
+static void x25519_precompute_x64(argPeerTable table, argKey session_key) {
+  ALIGN uint64_t num[(PEER_ENTRIES_X25519 + 1) * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t den[(PEER_ENTRIES_X25519 + 1) * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t coordinates[2 * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t workspace[4 * NUM_WORDS_ELTFP25519_X64];
+  EltFp25519_1w_x64 u, w1, w2, s;
+  EltFp25519_1w_x64 one = {1, 0, 0, 0};
+  EltFp25519_1w_x64 param_A = {486662, 0, 0, 0};
+
+  unsigned int k = 0;
+  uint64_t *const key = table + PEER_KEY_X25519;
+  uint64_t *const start = table + PEER_START_X25519;
+  uint64_t *const X = coordinates + 0;
+  uint64_t *const Z = coordinates + 4;
+
+  uint64_t *const A = workspace + 0;
+  uint64_t *const B = workspace + 4;
+  uint64_t *const C = workspace + 8;
+  uint64_t *const D = workspace + 12;
+
+  uint64_t *const AB = workspace + 0;
+  uint64_t *const CD = workspace + 8;
+
+  uint64_t *const buffer_1w = buffer;
+  uint64_t *const buffer_2w = buffer;
+
+  /* Masks the most significant bit, as x25519_shared_ladder_x64 does */
+  memcpy(key, session_key, X25519_KEYSIZE_BYTES);
+  key[3] &= 0x7FFFFFFFFFFFFFFF;
+  memset(table, 0, PEER_KEY_X25519 * sizeof(uint64_t));
+  setzero_EltFp25519_1w_x64(table + PEER_FLAG_X25519);
+
+  /* P has order l iff u != 0 and l*P is the point at infinity */
+  copy_EltFp25519_1w_x64(u, key);
+  fred_EltFp25519_1w_x64_inline(u);
+  x25519_ladder_x64(X, Z, u, order_x25519);
+  fred_EltFp25519_1w_x64_inline(Z);
+  if ((u[0] | u[1] | u[2] | u[3]) == 0 || (Z[0] | Z[1] | Z[2] | Z[3]) != 0) {
+    return;
+  }
+
+  /* M_k = (X_k+Z_k)/(X_k-Z_k), where (X_k:Z_k) = 2^k*P */
+  copy_EltFp25519_1w_x64(X, u);
+  setzero_EltFp25519_1w_x64(Z);
+  Z[0] = 1;
+  for (k = 0; k < PEER_ENTRIES_X25519; k++) {
+    add_EltFp25519_1w_x64_inline(A, X, Z);      /*  A = X+Z       */
+    sub_EltFp25519_1w_x64_inline(B, X, Z);      /*  B = X-Z       */
+    copy_EltFp25519_1w_x64(num + NUM_WORDS_ELTFP25519_X64 * k, A);
+    copy_EltFp25519_1w_x64(den + NUM_WORDS_ELTFP25519_X64 * k, B);
+    sqr_EltFp25519_2w_x64(AB);                  /*  A = A**2     B = B**2   */
+    copy_EltFp25519_1w_x64(C, B);               /*  C = B         */
+    sub_EltFp25519_1w_x64_inline(B, A, B);      /*  B = A-B       */
+    mul_a24_EltFp25519_1w_x64_inline(D, B);     /*  D = my_a24*B  */
+    add_EltFp25519_1w_x64_inline(D, D, C);      /*  D = D+C       */
+    mul_EltFp25519_2w_x64(coordinates, AB, CD); /*  X = A*C      Z = B*D    */
+  }
+
+  /**
+   * u(P+S) = (v-v_S)^2/(u-1)^2 - A - u - 1, where v^2 = w1 = u^3+A*u^2+u
+   * and v_S^2 = w2 = A+2, so that (v-v_S)^2 = w1 + w2 - 2*sqrt(w1*w2).
+   * Either square root gives P+S or P-S, which the ladder cannot tell apart.
+   */
+  add_EltFp25519_1w_x64_inline(w1, u, param_A);
+  mul_EltFp25519_1w_x64(w1, w1, u);
+  add_EltFp25519_1w_x64_inline(w1, w1, one);
+  mul_EltFp25519_1w_x64(w1, w1, u);
+  setzero_EltFp25519_1w_x64(w2);
+  w2[0] = 486664;
+  mul_EltFp25519_1w_x64(s, w1, w2);
+  sqrt_EltFp25519_1w_x64(s, s);
+  add_EltFp25519_1w_x64_inline(A, w1, w2);
+  sub_EltFp25519_1w_x64_inline(A, A, s);
+  sub_EltFp25519_1w_x64_inline(num + PEER_START_X25519, A, s);
+  sub_EltFp25519_1w_x64_inline(B, u, one);
+  sqr_EltFp25519_1w_x64(B);
+  copy_EltFp25519_1w_x64(den + PEER_START_X25519, B);
+
+  inv_batch_EltFp25519_1w_x64(table, den, PEER_ENTRIES_X25519 + 1);
+  for (k = 0; k <= PEER_ENTRIES_X25519; k++) {
+    uint64_t *const M = table + NUM_WORDS_ELTFP25519_X64 * k;
+    mul_EltFp25519_1w_x64(M, M, num + NUM_WORDS_ELTFP25519_X64 * k);
+    fred_EltFp25519_1w_x64_inline(M);
+  }
+  sub_EltFp25519_1w_x64_inline(start, start, param_A);
+  sub_EltFp25519_1w_x64_inline(start, start, u);
+  sub_EltFp25519_1w_x64_inline(start, start, one);
+  fred_EltFp25519_1w_x64_inline(start);
+  table[PEER_FLAG_X25519] = 1;
+}
+
+/**
+ * Computes the shared secret with the table of x25519_precompute_x64; the
+ * output is identical to that of x25519_shared_secret_x64.
+ */
+static void x25519_shared_peer_x64(argKey shared, argPeerTable table,
+                                   argKey private_key) {
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  EltFp25519_1w_x64 U, Z, invZ;
+
+  if (table[PEER_FLAG_X25519] != 0) {
+    x25519_precmp_ladder_x64(U, Z, table, table + PEER_START_X25519,
+                             private_key);
+  } else {
+    x25519_shared_ladder_x64(U, Z, (argKey)(table + PEER_KEY_X25519),
+                             private_key);
+  }
+
+  inv_EltFp25519_1w_x64(invZ, Z);
+  mul_EltFp25519_1w_x64((uint64_t *)shared, U, invZ);
+  fred_EltFp25519_1w_x64_inline((uint64_t *)shared);
+}
+
+static void x25519_to_affine_4w_x64(argKey *out, uint64_t *const X,
+                                    uint64_t *const Z) {
+  ALIGN uint64_t invZ[4 * NUM_WORDS_ELTFP25519_X64];
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  int lane = 0;
+
+  inv_batch_EltFp25519_1w_x64(invZ, Z, 4);
+  for (lane = 0; lane < 4; lane++) {
+    uint64_t *const u = (uint64_t *)out[lane];
+    mul_EltFp25519_1w_x64(u, X + NUM_WORDS_ELTFP25519_X64 * lane,
+                          invZ + NUM_WORDS_ELTFP25519_X64 * lane);
+    fred_EltFp25519_1w_x64_inline(u);
+  }
 }
 
-const KeyGen X25519_KeyGen = x25519_keygen_precmp_x64;
-const Shared X25519_Shared = x25519_shared_secret_x64;
+const X64Functions X25519_x64 = {
+    x25519_keygen_precmp_x64, x25519_shared_secret_x64,
+    x25519_keygen_precmp_batch_x64, x25519_shared_secret_batch_x64,
+    x25519_precompute_x64, x25519_shared_peer_x64, x25519_to_affine_4w_x64,
+    {Table_Ladder_8k, NULL, Table_Comb_24k},
+    {sizeof(Table_Ladder_8k), 0, sizeof(Table_Comb_24k)}};
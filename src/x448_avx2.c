@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <string.h>
+#include "fp448_avx2.h"
+#include "fp448_x64.h"
+#include "rfc7748_x64.h"
+#include "table_ladder_x448.h"
+#include "x448_avx2.h"
+
+/* Copies and clamps four private keys */
+static void clamp_4w_avx2(uint64_t *const key, argKey *private_key) {
+  int lane = 0;
+  for (lane = 0; lane < 4; lane++) {
+    uint8_t *const k = (uint8_t *)(key + NUM_WORDS_ELTFP448_X64 * lane);
+    memcpy(k, private_key[lane], X448_KEYSIZE_BYTES);
+
+    /** clamp function */
+    k[0] = k[0] & (~(uint8_t)0x3);
+    k[X448_KEYSIZE_BYTES - 1] |= 0x80;
+  }
+}
+
+/* Sets MASK to all-ones in the lanes where SWAP differs from bit I of KEY */
+static inline void swap_mask_4w_avx2(uint64_t *const mask,
+                                     uint64_t *const swap,
+                                     const uint64_t *const key, int i) {
+  int lane = 0;
+  for (lane = 0; lane < 4; lane++) {
+    const uint64_t bit =
+        (key[NUM_WORDS_ELTFP448_X64 * lane + i / 64] >> (i % 64)) & 0x1;
+    mask[lane] = -(swap[lane] ^ bit);
+    swap[lane] = bit;
+  }
+}
+
+/* Converts four projective points (X:Z) to affine coordinates */
+static void to_affine_4w_avx2(argKey *out, uint64_t *const X,
+                              uint64_t *const Z) {
+  ALIGN uint64_t x[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t z[4 * NUM_WORDS_ELTFP448_X64];
+
+  store_EltFp448_4w_avx2(x, X);
+  store_EltFp448_4w_avx2(z, Z);
+  x448_impl_x64->to_affine_4w(out, x, z);
+}
+
+void x448_shared_4w_avx2(argKey *shared, argKey *session_key,
+                         argKey *private_key) {
+  EltFp448_4w_avx2 X1, X2, Z2, X3, Z3;
+  EltFp448_4w_avx2 A, B, C, D, AA, BB, E, DA, CB;
+  ALIGN uint64_t U[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t key[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t mask[4];
+  uint64_t swap[4] = {0, 0, 0, 0};
+  int i = 0, lane = 0;
+
+  clamp_4w_avx2(key, private_key);
+  for (lane = 0; lane < 4; lane++) {
+    memcpy(U + NUM_WORDS_ELTFP448_X64 * lane, session_key[lane],
+           X448_KEYSIZE_BYTES);
+  }
+
+  load_EltFp448_4w_avx2(X1, U);
+  for (i = 0; i < NUM_WORDS_ELTFP448_AVX2; i++) {
+    X2[i] = i < 4;
+    Z2[i] = 0;
+    X3[i] = X1[i];
+    Z3[i] = i < 4;
+  }
+
+  /* main-loop, as in the RFC-7748 */
+  for (i = 447; i >= 0; i--) {
+    swap_mask_4w_avx2(mask, swap, key, i);
+    cswap_EltFp448_4w_avx2(mask, X2, X3);
+    cswap_EltFp448_4w_avx2(mask, Z2, Z3);
+
+    add_EltFp448_4w_avx2(A, X2, Z2);   /* A = (X2+Z2)          */
+    sub_EltFp448_4w_avx2(B, X2, Z2);   /* B = (X2-Z2)          */
+    add_EltFp448_4w_avx2(C, X3, Z3);   /* C = (X3+Z3)          */
+    sub_EltFp448_4w_avx2(D, X3, Z3);   /* D = (X3-Z3)          */
+    mul_EltFp448_4w_avx2(DA, D, A);    /* DA = D*A             */
+    mul_EltFp448_4w_avx2(CB, C, B);    /* CB = C*B             */
+    sqr_EltFp448_4w_avx2(AA, A);       /* AA = A^2             */
+    sqr_EltFp448_4w_avx2(BB, B);       /* BB = B^2             */
+
+    add_EltFp448_4w_avx2(X3, DA, CB);  /* X3 = (DA+CB)^2       */
+    sqr_EltFp448_4w_avx2(X3, X3);
+    sub_EltFp448_4w_avx2(Z3, DA, CB);  /* Z3 = X1*(DA-CB)^2    */
+    sqr_EltFp448_4w_avx2(Z3, Z3);
+    mul_EltFp448_4w_avx2(Z3, Z3, X1);
+
+    sub_EltFp448_4w_avx2(E, AA, BB);   /* E = AA-BB            */
+    mul_EltFp448_4w_avx2(X2, AA, BB);  /* X2 = AA*BB           */
+    mul_a24_EltFp448_4w_avx2(Z2, E);   /* Z2 = E*(BB+a24*E)    */
+    add_EltFp448_4w_avx2(Z2, Z2, BB);
+    mul_EltFp448_4w_avx2(Z2, Z2, E);
+  }
+  /* The last two bits of the keys are zero, so no final swap is needed */
+
+  to_affine_4w_avx2(shared, X2, Z2);
+}
+
+/**
+ * Computes four public keys at once with the precomputed ladder of
+ * x448_keygen_ladder_x64; all lanes read the same table entry at each
+ * step, so it is converted once and broadcast to the four lanes.
+ */
+void x448_keygen_4w_avx2(argKey *public_key, argKey *private_key) {
+  EltFp448_4w_avx2 Ur1, Zr1, Ur2, Zr2, M, A, B, C, D;
+  ALIGN uint64_t key[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t mask[4];
+  uint64_t swap[4] = {1, 1, 1, 1};
+  /* G-S */
+  ALIGN uint64_t GS[NUM_WORDS_ELTFP448_X64] = {
+      0xacb1197dc99d2720, 0x23ac33ff1c69baf8, 0xf1bd65643ace1b51,
+      0x2954459d84c1f823, 0xdacdd1031c81b967, 0x3acf03881affeb7b,
+      0xf0fab72501324442};
+  /* -1 mod p */
+  ALIGN uint64_t minus_one[NUM_WORDS_ELTFP448_X64] = {
+      0xfffffffffffffffe, 0xffffffffffffffff, 0xffffffffffffffff,
+      0xfffffffeffffffff, 0xffffffffffffffff, 0xffffffffffffffff,
+      0xffffffffffffffff};
+  const int q = 2;
+  int i = 0;
+
+  clamp_4w_avx2(key, private_key);
+
+  broadcast_EltFp448_4w_avx2(Ur1, minus_one);
+  broadcast_EltFp448_4w_avx2(Ur2, GS);
+  for (i = 0; i < NUM_WORDS_ELTFP448_AVX2; i++) {
+    Zr1[i] = i < 4;
+    Zr2[i] = i < 4;
+  }
+
+  /* main-loop */
+  for (i = q; i < 448; i++) {
+    swap_mask_4w_avx2(mask, swap, key, i);
+    cswap_EltFp448_4w_avx2(mask, Ur1, Ur2);
+    cswap_EltFp448_4w_avx2(mask, Zr1, Zr2);
+
+    broadcast_EltFp448_4w_avx2(
+        M, (uint64_t *)&Table_Ladder_24k[NUM_WORDS_ELTFP448_X64 * (i - q)]);
+    /** Addition */
+    sub_EltFp448_4w_avx2(B, Ur1, Zr1); /* B = Ur1-Zr1                 */
+    add_EltFp448_4w_avx2(A, Ur1, Zr1); /* A = Ur1+Zr1                 */
+    carry_EltFp448_4w_avx2(A);
+    mul_EltFp448_4w_avx2(C, M, B);     /* C = M*B                     */
+    sub_EltFp448_4w_avx2(B, A, C);     /* B = (Ur1+Zr1) - M*(Ur1-Zr1) */
+    add_EltFp448_4w_avx2(A, A, C);     /* A = (Ur1+Zr1) + M*(Ur1-Zr1) */
+    sqr_EltFp448_4w_avx2(A, A);        /* A = A^2                     */
+    sqr_EltFp448_4w_avx2(B, B);        /* B = B^2                     */
+    mul_EltFp448_4w_avx2(Ur1, Zr2, A); /* Ur1 = Zr2*A                 */
+    mul_EltFp448_4w_avx2(Zr1, Ur2, B); /* Zr1 = Ur2*B                 */
+  }
+
+  /** Doubling */
+  for (i = 0; i < q; i++) {
+    add_EltFp448_4w_avx2(A, Ur1, Zr1); /*  A = Ur1+Zr1   */
+    sub_EltFp448_4w_avx2(B, Ur1, Zr1); /*  B = Ur1-Zr1   */
+    sqr_EltFp448_4w_avx2(A, A);        /*  A = A**2      */
+    sqr_EltFp448_4w_avx2(B, B);        /*  B = B**2      */
+    sub_EltFp448_4w_avx2(C, A, B);     /*  C = A-B       */
+    mul_a24_EltFp448_4w_avx2(D, C);    /*  D = my_a24*C  */
+    add_EltFp448_4w_avx2(D, D, B);     /*  D = D+B       */
+    mul_EltFp448_4w_avx2(Ur1, A, B);   /*  Ur1 = A*B     */
+    mul_EltFp448_4w_avx2(Zr1, C, D);   /*  Zr1 = C*D     */
+  }
+
+  to_affine_4w_avx2(public_key, Ur1, Zr1);
+}
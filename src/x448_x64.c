@@ -31,10 +31,16 @@
  * OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <string.h>
 #include "fp448_x64.h"
-#include "rfc7748_precomputed.h"
+#include "fp448_x64_inline.h"
+#include "rfc7748_x64.h"
+#include "table_comb_x448.h"
 #include "table_ladder_x448.h"
 
+/* Number of keys sharing one inversion in the batch functions */
+#define BATCH_SIZE_X448 64
+
 static inline void cswap_x64(uint64_t bit, uint64_t *const px,
                              uint64_t *const py) {
   int i = 0;
@@ -46,17 +52,18 @@ static inline void cswap_x64(uint64_t bit, uint64_t *const px,
   }
 }
 
-static void x448_shared_x64(argKey shared, argKey session_key,
-                            argKey private_key) {
+/**
+ * Runs the Montgomery ladder over bits 447, ..., 0 of key, which is not
+ * clamped, and returns the projective coordinates (X:Z) of key*(X1:1).
+ */
+static void x448_ladder_x64(uint64_t *const X, uint64_t *const Z,
+                            uint64_t *const X1, const uint64_t *const key) {
   ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP448_X64];
   ALIGN uint64_t coordinates[4 * NUM_WORDS_ELTFP448_X64];
   ALIGN uint64_t workspace[6 * NUM_WORDS_ELTFP448_X64];
-  uint64_t save;
 
   int i = 0, j = 0;
   uint64_t prev = 0;
-  uint64_t *const X1 = (uint64_t *)session_key;
-  uint64_t *const key = (uint64_t *)private_key;
   uint64_t *const Px = coordinates + 0;
   uint64_t *const Pz = coordinates + 7;
   uint64_t *const Qx = coordinates + 14;
@@ -72,15 +79,16 @@ static void x448_shared_x64(argKey shared, argKey session_key,
   uint64_t *const C = workspace + 21;
   uint64_t *const DA = workspace + 28;
   uint64_t *const CB = workspace + 35;
+  uint64_t *const X2Z2 = Qx;
+  uint64_t *const X3Z3 = Px;
+  uint64_t *const AB = A;
+  uint64_t *const DC = D;
+  uint64_t *const DACB = DA;
   uint64_t *const buffer_1w = buffer;
-
-  /** clamp function */
-  save = private_key[X448_KEYSIZE_BYTES - 1] << 16 | private_key[0];
-  private_key[0] = private_key[0] & (~(uint8_t)0x3);
-  private_key[X448_KEYSIZE_BYTES - 1] |= 0x80;
+  uint64_t *const buffer_2w = buffer;
 
   for (i = 0; i < NUM_WORDS_ELTFP448_X64; i++) {
-    Px[i] = ((uint64_t *)session_key)[i];
+    Px[i] = X1[i];
     Pz[i] = 0;
     Qx[i] = 0;
     Qz[i] = 0;
@@ -97,68 +105,304 @@ static void x448_shared_x64(argKey shared, argKey session_key,
       uint64_t swap = bit ^ prev;
       prev = bit;
 
-      add_EltFp448_1w_x64(A, X2, Z2); /* A = (X2+Z2) */
-      sub_EltFp448_1w_x64(B, X2, Z2); /* B = (X2-Z2) */
-      add_EltFp448_1w_x64(C, X3, Z3); /* C = (X3+Z3) */
-      sub_EltFp448_1w_x64(D, X3, Z3); /* D = (X3-Z3) */
-
-      mul_EltFp448_1w_x64(DA, A, D); /* DA = A*D    */
-      mul_EltFp448_1w_x64(CB, C, B); /* CB = C*B    */
+      add_EltFp448_1w_x64_inline(A, X2, Z2);  /* A = (X2+Z2)                   */
+      sub_EltFp448_1w_x64_inline(B, X2, Z2);  /* B = (X2-Z2)                   */
+      add_EltFp448_1w_x64_inline(C, X3, Z3);  /* C = (X3+Z3)                   */
+      sub_EltFp448_1w_x64_inline(D, X3, Z3);  /* D = (X3-Z3)                   */
+      mul_EltFp448_2w_x64(DACB, AB, DC);      /* [DA|CB] = [A|B]*[D|C]         */
 
       cswap_x64(swap, A, C);
       cswap_x64(swap, B, D);
 
-      sqr_EltFp448_1w_x64(A); /* A = A^2          */
-      sqr_EltFp448_1w_x64(B); /* B = B^2          */
+      sqr_EltFp448_2w_x64(AB);                 /* [AA|BB] = [A^2|B^2]           */
+      add_EltFp448_1w_x64_inline(X3, DA, CB);  /* X3 = (DA+CB)                  */
+      sub_EltFp448_1w_x64_inline(Z3, DA, CB);  /* Z3 = (DA-CB)                  */
+      sqr_EltFp448_2w_x64(X3Z3);               /* [X3|Z3] = [(DA+CB)|(DA-CB)]^2 */
 
-      add_EltFp448_1w_x64(X3, DA, CB); /* X3 = (DA+CB)     */
-      sub_EltFp448_1w_x64(Z3, DA, CB); /* Z3 = (DA-CB)     */
-      sqr_EltFp448_1w_x64(X3);         /* X3 = (DA+CB)^2   */
-      sqr_EltFp448_1w_x64(Z3);         /* Z3 = (DA*CB)^2   */
+      copy_EltFp448_1w_x64(X2, B);           /* X2 = B^2                      */
+      sub_EltFp448_1w_x64_inline(Z2, A, B);  /* Z2 = E = AA-BB                */
 
-      copy_EltFp448_1w_x64(X2, B);     /* X2 = B^2         */
-      sub_EltFp448_1w_x64(Z2, A, B);   /* Z2 = E = AA-BB   */
-      mul_a24_EltFp448_1w_x64(B, Z2);  /*  B = a24*E       */
-      add_EltFp448_1w_x64(B, B, X2);   /*  B = a24*E+B     */
-      mul_EltFp448_1w_x64(X2, X2, A);  /* X2 = A*B         */
-      mul_EltFp448_1w_x64(Z2, Z2, B);  /* Z2 = E*(a24*E+B) */
-      mul_EltFp448_1w_x64(Z3, Z3, X1); /* Z3 = Z3*X1       */
+      mul_a24_EltFp448_1w_x64_inline(B, Z2);  /* B = a24*E                     */
+      add_EltFp448_1w_x64_inline(B, B, X2);   /* B = a24*E+B                   */
+      mul_EltFp448_2w_x64(X2Z2, X2Z2, AB);    /* [X2|Z2] = [B|E]*[A|a24*E+B]   */
+      mul_EltFp448_1w_x64(Z3, Z3, X1);        /* Z3 = Z3*X1                    */
 
       j--;
     }
     j = 63;
   }
-  inv_EltFp448_1w_x64(A, Qz);
-  mul_EltFp448_1w_x64((uint64_t *)shared, Qx, A);
-  fred_EltFp448_1w_x64((uint64_t *)shared);
-  private_key[X448_KEYSIZE_BYTES - 1] = (uint8_t)((save >> 16) & 0xFF);
-  private_key[0] = (uint8_t)(save & 0xFF);
+  /* Clamped keys end with a zero bit, so this swap is only for the others */
+  cswap_x64(prev, Px, Qx);
+  cswap_x64(prev, Pz, Qz);
+  copy_EltFp448_1w_x64(X, Qx);
+  copy_EltFp448_1w_x64(Z, Qz);
 }
 
-static void x448_keygen_x64(argKey public_key, argKey private_key) {
+/**
+ * Runs the Montgomery ladder and returns the projective coordinates (X:Z)
+ * of the shared secret.
+ */
+static void x448_shared_ladder_x64(uint64_t *const X, uint64_t *const Z,
+                                   argKey session_key, argKey private_key) {
+  ALIGN uint8_t private[X448_KEYSIZE_BYTES];
+
+  /**
+   * The key is clamped in a copy, so that several threads can use the
+   * same private key at once.
+   */
+  memcpy(private, private_key, sizeof(private));
+  private[0] = private[0] & (~(uint8_t)0x3);
+  private[X448_KEYSIZE_BYTES - 1] |= 0x80;
+
+  x448_ladder_x64(X, Z, (uint64_t *)session_key, (uint64_t *)private);
+}
+
+static void x448_shared_x64(argKey shared, argKey session_key,
+                            argKey private_key) {
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  EltFp448_1w_x64 X, Z, invZ;
+
+  x448_shared_ladder_x64(X, Z, session_key, private_key);
+
+  inv_EltFp448_1w_x64(invZ, Z);
+  mul_EltFp448_1w_x64((uint64_t *)shared, X, invZ);
+  fred_EltFp448_1w_x64_inline((uint64_t *)shared);
+}
+
+/**
+ * Computes N shared secrets; the conversions to affine coordinates of each
+ * group of up to BATCH_SIZE_X448 secrets share a single field inversion.
+ * Outputs are identical to those of x448_shared_x64.
+ */
+static void x448_shared_batch_x64(argKey *shared, argKey *session_key,
+                                  argKey *private_key, unsigned int n) {
+  ALIGN uint64_t X[BATCH_SIZE_X448 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t Z[BATCH_SIZE_X448 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t invZ[BATCH_SIZE_X448 * NUM_WORDS_ELTFP448_X64];
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  unsigned int i = 0, k = 0, len = 0;
+
+  for (k = 0; k < n; k += len) {
+    len = n - k < BATCH_SIZE_X448 ? n - k : BATCH_SIZE_X448;
+    for (i = 0; i < len; i++) {
+      x448_shared_ladder_x64(X + NUM_WORDS_ELTFP448_X64 * i,
+                             Z + NUM_WORDS_ELTFP448_X64 * i,
+                             session_key[k + i], private_key[k + i]);
+    }
+
+    inv_batch_EltFp448_1w_x64(invZ, Z, len);
+    for (i = 0; i < len; i++) {
+      uint64_t *const secret = (uint64_t *)shared[k + i];
+      mul_EltFp448_1w_x64(secret, X + NUM_WORDS_ELTFP448_X64 * i,
+                          invZ + NUM_WORDS_ELTFP448_X64 * i);
+      fred_EltFp448_1w_x64_inline(secret);
+    }
+  }
+}
+
+/**
+ * Selects, in constant time, entry |digit| of row i of Table_Comb_X448_18k
+ * into T = [x|y|dxy|x+y], or (0, 1, 0, 1) if digit is zero; negative digits
+ * select the opposite point, i.e., x and dxy are negated.
+ */
+static void x448_comb_select_x64(uint64_t *const T, int i, int8_t digit) {
+  const uint64_t *const row = Table_Comb_X448_18k + 8 * 3 * 7 * i;
+  const uint64_t negative = (uint64_t)(int64_t)digit >> 63;
+  const uint64_t abs = ((uint64_t)(int64_t)digit ^ -negative) + negative;
+  EltFp448_1w_x64 zero = {0}, minus_x, minus_dxy;
+  uint64_t j = 0, w = 0, mask = 0;
+
+  for (w = 0; w < 21; w++) {
+    T[w] = w == 7;
+  }
+  for (j = 1; j <= 8; j++) {
+    mask = -(((abs ^ j) - 1) >> 63);
+    for (w = 0; w < 21; w++) {
+      T[w] ^= (T[w] ^ row[21 * (j - 1) + w]) & mask;
+    }
+  }
+
+  mask = -negative;
+  sub_EltFp448_1w_x64_inline(minus_x, zero, T + 0);
+  sub_EltFp448_1w_x64_inline(minus_dxy, zero, T + 14);
+  for (w = 0; w < 7; w++) {
+    T[w + 0] ^= (T[w + 0] ^ minus_x[w]) & mask;
+    T[w + 14] ^= (T[w + 14] ^ minus_dxy[w]) & mask;
+  }
+  add_EltFp448_1w_x64_inline(T + 21, T + 0, T + 7);
+}
+
+/**
+ * Computes the point P = [X|Y|T|Z], in extended coordinates, from the
+ * values EG = [E|G] and FH = [F|H] of the addition and doubling formulas.
+ */
+static inline void x448_comb_p1p1_x64(uint64_t *const P, uint64_t *const EG,
+                                      uint64_t *const FH) {
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t EF[2 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t HG[2 * NUM_WORDS_ELTFP448_X64];
+  uint64_t *const buffer_2w = buffer;
+
+  copy_EltFp448_1w_x64(EF + 0, EG + 0);
+  copy_EltFp448_1w_x64(EF + 7, FH + 0);
+  copy_EltFp448_1w_x64(HG + 0, FH + 7);
+  copy_EltFp448_1w_x64(HG + 7, EG + 7);
+  mul_EltFp448_2w_x64(P + 0, EG, FH);           /* [X|Y] = [E*F|G*H]       */
+  mul_EltFp448_2w_x64(P + 14, EF, HG);          /* [T|Z] = [E*H|F*G]       */
+}
+
+/**
+ * P = P + Q, where Q = [x|y|dxy|x+y] comes from x448_comb_select_x64; since
+ * Ed448 has a = 1, the (y-x, y+x) trick of Ed25519 does not apply and the
+ * addition takes four products instead of three.
+ */
+static void x448_comb_madd_x64(uint64_t *const P, uint64_t *const Q) {
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t AB[2 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t CS[2 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t EG[2 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t FH[2 * NUM_WORDS_ELTFP448_X64];
+  uint64_t *const X = P + 0, *const Y = P + 7, *const T = P + 14;
+  uint64_t *const Z = P + 21, *const A = AB + 0, *const B = AB + 7;
+  uint64_t *const C = CS + 0, *const S = CS + 7;
+  uint64_t *const buffer_2w = buffer;
+
+  copy_EltFp448_1w_x64(C, T);
+  add_EltFp448_1w_x64_inline(S, X, Y);          /* S = X+Y                 */
+  mul_EltFp448_2w_x64(AB, P, Q);                /* [A|B] = [X*x|Y*y]       */
+  mul_EltFp448_2w_x64(CS, CS, Q + 14);          /* [C|S] = [T*dxy|S*(x+y)] */
+  sub_EltFp448_1w_x64_inline(EG + 0, S, A);
+  sub_EltFp448_1w_x64_inline(EG + 0, EG + 0, B);  /* E = S-A-B             */
+  add_EltFp448_1w_x64_inline(EG + 7, Z, C);     /* G = Z+C                 */
+  sub_EltFp448_1w_x64_inline(FH + 0, Z, C);     /* F = Z-C                 */
+  sub_EltFp448_1w_x64_inline(FH + 7, B, A);     /* H = B-A                 */
+  x448_comb_p1p1_x64(P, EG, FH);
+}
+
+/* P = 2P */
+static void x448_comb_dbl_x64(uint64_t *const P) {
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t XY[2 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t SZ[2 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t EG[2 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t FH[2 * NUM_WORDS_ELTFP448_X64];
+  EltFp448_1w_x64 C;
+  uint64_t *const X = P + 0, *const Y = P + 7, *const Z = P + 21;
+  uint64_t *const XX = XY + 0, *const YY = XY + 7;
+  uint64_t *const buffer_2w = buffer;
+
+  copy_EltFp448_1w_x64(XX, X);
+  copy_EltFp448_1w_x64(YY, Y);
+  add_EltFp448_1w_x64_inline(SZ, X, Y);
+  copy_EltFp448_1w_x64(SZ + 7, Z);
+  sqr_EltFp448_2w_x64(XY);                      /* [XX|YY] = [X^2|Y^2]     */
+  sqr_EltFp448_2w_x64(SZ);                      /* [S|ZZ] = [(X+Y)^2|Z^2]  */
+  add_EltFp448_1w_x64_inline(EG + 7, XX, YY);   /* G = XX+YY               */
+  sub_EltFp448_1w_x64_inline(FH + 7, XX, YY);   /* H = XX-YY               */
+  sub_EltFp448_1w_x64_inline(EG + 0, SZ, EG + 7);  /* E = S-G              */
+  add_EltFp448_1w_x64_inline(C, SZ + 7, SZ + 7);   /* C = 2ZZ              */
+  sub_EltFp448_1w_x64_inline(FH + 0, EG + 7, C);   /* F = G-C              */
+  x448_comb_p1p1_x64(P, EG, FH);
+}
+
+/**
+ * Computes the public key with a signed radix-16 comb on Ed448, whose base
+ * point B is sent to u = 5 by the 4-isogeny u = y^2/x^2 of RFC 7748. The
+ * clamped key k is a multiple of 4, so k*B = (k/4)*(4B): the 446 bits of
+ * k/4 are recoded into 112 digits in [-8,8], and digit 8*i+c selects an
+ * entry of row i of Table_Comb_X448_18k in the pass c = 7, ..., 0, with
+ * four doublings between passes. The sum (X:Y:Z) maps to (Y^2 : X^2).
+ */
+static void x448_keygen_comb_x64(uint64_t *const U, uint64_t *const Z,
+                                 argKey private_key) {
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t point[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t entry[4 * NUM_WORDS_ELTFP448_X64];
+  uint8_t key[X448_KEYSIZE_BYTES];
+  int8_t digits[2 * X448_KEYSIZE_BYTES];
+  int8_t carry = 0;
+  int i = 0, c = 0;
+  uint64_t *const buffer_2w = buffer;
+
+  memcpy(key, private_key, sizeof(key));
+  key[0] &= 0xFC;
+  key[X448_KEYSIZE_BYTES - 1] |= 0x80;
+  for (i = 0; i < X448_KEYSIZE_BYTES; i++) {
+    /* byte i of k/4 */
+    uint8_t byte = key[i] >> 2;
+    if (i < X448_KEYSIZE_BYTES - 1) {
+      byte |= key[i + 1] << 6;
+    }
+    digits[2 * i + 0] = byte & 0xF;
+    digits[2 * i + 1] = byte >> 4;
+  }
+  for (i = 0; i < 2 * X448_KEYSIZE_BYTES - 1; i++) {
+    digits[i] += carry;
+    carry = (digits[i] + 8) >> 4;
+    digits[i] -= carry << 4;
+  }
+  digits[2 * X448_KEYSIZE_BYTES - 1] += carry;
+
+  /* point = (X:Y:T:Z) = (0:1:0:1) */
+  for (i = 0; i < 4 * NUM_WORDS_ELTFP448_X64; i++) {
+    point[i] = i == 7 || i == 21;
+  }
+  for (c = 7; c >= 0; c--) {
+    if (c < 7) {
+      for (i = 0; i < 4; i++) {
+        x448_comb_dbl_x64(point);
+      }
+    }
+    for (i = c; i < 2 * X448_KEYSIZE_BYTES; i += 8) {
+      x448_comb_select_x64(entry, i / 8, digits[i]);
+      x448_comb_madd_x64(point, entry);
+    }
+  }
+
+  sqr_EltFp448_2w_x64(point);                   /* [X^2|Y^2]               */
+  copy_EltFp448_1w_x64(U, point + 7);
+  copy_EltFp448_1w_x64(Z, point + 0);
+}
+
+/**
+ * Runs the precomputed ladder over the table of M_k = (u_k+1)/(u_k-1),
+ * where u_k is the u-coordinate of 2^k*P, and returns the projective
+ * coordinates (U:Z) of k*P for the clamped private key k. The ladder
+ * starts from S, a point of order 4 with u = -1, and from P-S, whose
+ * u-coordinate is start; the last two doublings remove S.
+ */
+static void x448_precmp_ladder_x64(uint64_t *const U, uint64_t *const Z,
+                                   const uint64_t *const table,
+                                   const uint64_t *const start,
+                                   argKey private_key) {
   ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP448_X64];
   ALIGN uint64_t coordinates[4 * NUM_WORDS_ELTFP448_X64];
   ALIGN uint64_t workspace[4 * NUM_WORDS_ELTFP448_X64];
-  uint64_t save;
+  ALIGN uint8_t private[X448_KEYSIZE_BYTES];
 
   int i = 0, j = 0, k = 0;
-  uint64_t *const key = (uint64_t *)private_key;
+  uint64_t *const key = (uint64_t *)private;
   uint64_t *const Ur1 = coordinates + 0;
   uint64_t *const Zr1 = coordinates + 7;
-  uint64_t *const Ur2 = coordinates + 14;
-  uint64_t *const Zr2 = coordinates + 21;
+  uint64_t *const Zr2 = coordinates + 14;
+  uint64_t *const Ur2 = coordinates + 21;
+  uint64_t *const UZr1 = coordinates + 0;
+  uint64_t *const ZUr2 = coordinates + 14;
   uint64_t *const A = workspace + 0;
   uint64_t *const B = workspace + 7;
   uint64_t *const C = workspace + 14;
   uint64_t *const D = workspace + 21;
+  uint64_t *const AB = workspace + 0;
+  uint64_t *const CD = workspace + 14;
   uint64_t *const buffer_1w = buffer;
+  uint64_t *const buffer_2w = buffer;
 
-  uint64_t *P = (uint64_t *)Table_Ladder_24k;
+  uint64_t *P = (uint64_t *)table;
 
   /** clamp function */
-  save = private_key[X448_KEYSIZE_BYTES - 1] << 16 | private_key[0];
-  private_key[0] = private_key[0] & (~(uint8_t)0x3);
-  private_key[X448_KEYSIZE_BYTES - 1] |= 0x80;
+  memcpy(private, private_key, sizeof(private));
+  private[0] = private[0] & (~(uint8_t)0x3);
+  private[X448_KEYSIZE_BYTES - 1] |= 0x80;
 
   for (i = 0; i < NUM_WORDS_ELTFP448_X64; i++) {
     Ur1[i] = 0;
@@ -166,14 +410,8 @@ static void x448_keygen_x64(argKey public_key, argKey private_key) {
     Zr2[i] = 0;
   }
 
-  /* G-S */
-  Ur2[0] = 0xacb1197dc99d2720;
-  Ur2[1] = 0x23ac33ff1c69baf8;
-  Ur2[2] = 0xf1bd65643ace1b51;
-  Ur2[3] = 0x2954459d84c1f823;
-  Ur2[4] = 0xdacdd1031c81b967;
-  Ur2[5] = 0x3acf03881affeb7b;
-  Ur2[6] = 0xf0fab72501324442;
+  /* P-S */
+  copy_EltFp448_1w_x64(Ur2, start);
 
   /* Ur1 = -1 mod p */
   Ur1[0] = 0xfffffffffffffffe;
@@ -202,15 +440,13 @@ static void x448_keygen_x64(argKey public_key, argKey private_key) {
       swap = bit;
 
       /** Addition */
-      add_EltFp448_1w_x64(A, Ur1, Zr1);     /* A = Ur1+Zr1  */
-      sub_EltFp448_1w_x64(B, Ur1, Zr1);     /* B = Ur1-Zr1  */
-      mul_EltFp448_1w_x64(C, &P[7 * k], B); /* C = M0-B     */
-      sub_EltFp448_1w_x64(B, A, C);         /* B = (Ur1+Zr1) - M*(Ur1-Zr1) */
-      add_EltFp448_1w_x64(A, A, C);         /* A = (Ur1+Zr1) + M*(Ur1-Zr1) */
-      sqr_EltFp448_1w_x64(A);               /* A = A^2      */
-      sqr_EltFp448_1w_x64(B);               /* B = B^2      */
-      mul_EltFp448_1w_x64(Ur1, Zr2, A);     /* Ur1 = Zr2*A  */
-      mul_EltFp448_1w_x64(Zr1, Ur2, B);     /* Zr1 = Ur2*B  */
+      add_EltFp448_1w_x64_inline(A, Ur1, Zr1);  /* A = Ur1+Zr1  */
+      sub_EltFp448_1w_x64_inline(B, Ur1, Zr1);  /* B = Ur1-Zr1  */
+      mul_EltFp448_1w_x64(C, &P[7 * k], B);     /* C = M0-B     */
+      sub_EltFp448_1w_x64_inline(B, A, C);      /* B = (Ur1+Zr1) - M*(Ur1-Zr1) */
+      add_EltFp448_1w_x64_inline(A, A, C);      /* A = (Ur1+Zr1) + M*(Ur1-Zr1) */
+      sqr_EltFp448_2w_x64(AB);                  /* A = A^2      |  B = B^2     */
+      mul_EltFp448_2w_x64(UZr1, ZUr2, AB);      /* Ur1 = Zr2*A  |  Zr1 = Ur2*B */
 
       j++;
     }
@@ -219,25 +455,246 @@ static void x448_keygen_x64(argKey public_key, argKey private_key) {
 
   /** Doubling */
   for (i = 0; i < q; i++) {
-    add_EltFp448_1w_x64(A, Ur1, Zr1); /* A = Ur1+Zr1   */
-    sub_EltFp448_1w_x64(B, Ur1, Zr1); /* B = Ur1-Zr1   */
-    sqr_EltFp448_1w_x64(A);           /* A = A**2     B = B**2   */
-    sqr_EltFp448_1w_x64(B);           /* A = A**2     B = B**2   */
-    copy_EltFp448_1w_x64(C, B);       /* C = B         */
-    sub_EltFp448_1w_x64(B, A, B);     /* B = A-B       */
-    mul_a24_EltFp448_1w_x64(D, B);    /* D = my_a24*B  */
-    add_EltFp448_1w_x64(D, D, C);     /* D = D+C       */
-    mul_EltFp448_1w_x64(Ur1, A, C);   /* Ur1 = A*B   Zr1 = Zr1*A */
-    mul_EltFp448_1w_x64(Zr1, B, D);   /* Ur1 = A*B   Zr1 = Zr1*A */
+    add_EltFp448_1w_x64_inline(A, Ur1, Zr1);  /* A = Ur1+Zr1   */
+    sub_EltFp448_1w_x64_inline(B, Ur1, Zr1);  /* B = Ur1-Zr1   */
+    sqr_EltFp448_2w_x64(AB);                  /* A = A**2     B = B**2   */
+    copy_EltFp448_1w_x64(C, B);               /* C = B         */
+    sub_EltFp448_1w_x64_inline(B, A, B);      /* B = A-B       */
+    mul_a24_EltFp448_1w_x64_inline(D, B);     /* D = my_a24*B  */
+    add_EltFp448_1w_x64_inline(D, D, C);      /* D = D+C       */
+    mul_EltFp448_2w_x64(UZr1, AB, CD);        /* Ur1 = A*C   Zr1 = B*D */
   }
 
+  copy_EltFp448_1w_x64(U, Ur1);
+  copy_EltFp448_1w_x64(Z, Zr1);
+}
+
+/* u-coordinate of the base point, used when KeyGen runs without a table */
+ALIGN static const uint8_t base_point_x448[X448_KEYSIZE_BYTES] = {5};
+
+/* u-coordinate of G-S, where G is the base point */
+ALIGN static const uint64_t ladder_start_x448[NUM_WORDS_ELTFP448_X64] = {
+    0xacb1197dc99d2720, 0x23ac33ff1c69baf8, 0xf1bd65643ace1b51,
+    0x2954459d84c1f823, 0xdacdd1031c81b967, 0x3acf03881affeb7b,
+    0xf0fab72501324442};
+
+/**
+ * Runs the precomputed ladder over Table_Ladder_24k and returns the
+ * projective coordinates (U:Z) of the public key. With RFC7748_TABLE_NONE,
+ * it runs the ladder of the shared secret on the base point instead, and
+ * with RFC7748_TABLE_COMB, the comb above.
+ */
+static void x448_keygen_ladder_x64(uint64_t *const U, uint64_t *const Z,
+                                   argKey private_key) {
+  if (keygen_table_x64 == RFC7748_TABLE_NONE) {
+    x448_shared_ladder_x64(U, Z, (argKey)base_point_x448, private_key);
+    return;
+  }
+  if (keygen_table_x64 == RFC7748_TABLE_COMB) {
+    x448_keygen_comb_x64(U, Z, private_key);
+    return;
+  }
+  x448_precmp_ladder_x64(U, Z, Table_Ladder_24k, ladder_start_x448,
+                         private_key);
+}
+
+static void x448_keygen_x64(argKey public_key, argKey private_key) {
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  EltFp448_1w_x64 U, Z, invZ;
+
+  x448_keygen_ladder_x64(U, Z, private_key);
+
   /* Convert to affine coordinates */
-  inv_EltFp448_1w_x64(A, Zr1);
-  mul_EltFp448_1w_x64((uint64_t *)public_key, Ur1, A);
-  fred_EltFp448_1w_x64((uint64_t *)public_key);
-  private_key[X448_KEYSIZE_BYTES - 1] = (uint8_t)((save >> 16) & 0xFF);
-  private_key[0] = (uint8_t)(save & 0xFF);
+  inv_EltFp448_1w_x64(invZ, Z);
+  mul_EltFp448_1w_x64((uint64_t *)public_key, U, invZ);
+  fred_EltFp448_1w_x64_inline((uint64_t *)public_key);
+}
+
+/**
+ * Computes N public keys; the conversions to affine coordinates of each
+ * group of up to BATCH_SIZE_X448 keys share a single field inversion.
+ */
+static void x448_keygen_batch_x64(argKey *public_key, argKey *private_key,
+                                  unsigned int n) {
+  ALIGN uint64_t U[BATCH_SIZE_X448 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t Z[BATCH_SIZE_X448 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t invZ[BATCH_SIZE_X448 * NUM_WORDS_ELTFP448_X64];
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  unsigned int i = 0, k = 0, len = 0;
+
+  for (k = 0; k < n; k += len) {
+    len = n - k < BATCH_SIZE_X448 ? n - k : BATCH_SIZE_X448;
+    for (i = 0; i < len; i++) {
+      x448_keygen_ladder_x64(U + NUM_WORDS_ELTFP448_X64 * i,
+                             Z + NUM_WORDS_ELTFP448_X64 * i,
+                             private_key[k + i]);
+    }
+
+    /* Convert to affine coordinates */
+    inv_batch_EltFp448_1w_x64(invZ, Z, len);
+    for (i = 0; i < len; i++) {
+      uint64_t *const pub = (uint64_t *)public_key[k + i];
+      mul_EltFp448_1w_x64(pub, U + NUM_WORDS_ELTFP448_X64 * i,
+                          invZ + NUM_WORDS_ELTFP448_X64 * i);
+      fred_EltFp448_1w_x64_inline(pub);
+    }
+  }
+}
+
+/* Offsets in X448_PEER_TABLE of the entries, start, public key and flag */
+#define PEER_ENTRIES_X448 446
+#define PEER_START_X448 (NUM_WORDS_ELTFP448_X64 * PEER_ENTRIES_X448)
+#define PEER_KEY_X448 (PEER_START_X448 + NUM_WORDS_ELTFP448_X64)
+#define PEER_FLAG_X448 (PEER_KEY_X448 + NUM_WORDS_ELTFP448_X64)
+
+/**
+ * Order of the base point, 2^446 -
+ * 13818066809895115352007386748515426880336692474882178609894547503885
+ */
+ALIGN static const uint64_t order_x448[NUM_WORDS_ELTFP448_X64] = {
+    0x2378c292ab5844f3, 0x216cc2728dc58f55, 0xc44edb49aed63690,
+    0xffffffff7cca23e9, 0xffffffffffffffff, 0xffffffffffffffff,
+    0x3fffffffffffffff};
+
+/**
+ * Builds the table of x448_precmp_ladder_x64 for the public key P of a
+ * peer: the M_k come from 446 doublings of P, and the start point P-S from
+ * the addition of P and S = (-1, sqrt(A-2)). Every denominator shares one
+ * batch inversion. The ladder is only correct when S is not a multiple of
+ * P, so the table is flagged as unusable unless P has order l.
+ */
+static void x448_precompute_x64(argPeerTable table, argKey session_key) {
+  ALIGN uint64_t num[(PEER_ENTRIES_X448 + 1) * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t den[(PEER_ENTRIES_X448 + 1) * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t buffer[4 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t coordinates[2 * NUM_WORDS_ELTFP448_X64];
+  ALIGN uint64_t workspace[4 * NUM_WORDS_ELTFP448_X64];
+  EltFp448_1w_x64 u, w1, w2, s;
+  EltFp448_1w_x64 one = {1, 0, 0, 0, 0, 0, 0};
+  EltFp448_1w_x64 param_A = {156326, 0, 0, 0, 0, 0, 0};
+
+  unsigned int k = 0;
+  uint64_t *const key = table + PEER_KEY_X448;
+  uint64_t *const start = table + PEER_START_X448;
+  uint64_t *const X = coordinates + 0;
+  uint64_t *const Z = coordinates + 7;
+
+  uint64_t *const A = workspace + 0;
+  uint64_t *const B = workspace + 7;
+  uint64_t *const C = workspace + 14;
+  uint64_t *const D = workspace + 21;
+
+  uint64_t *const AB = workspace + 0;
+  uint64_t *const CD = workspace + 14;
+
+  uint64_t *const buffer_1w = buffer;
+  uint64_t *const buffer_2w = buffer;
+
+  memcpy(key, session_key, X448_KEYSIZE_BYTES);
+  memset(table, 0, PEER_KEY_X448 * sizeof(uint64_t));
+  setzero_EltFp448_1w_x64(table + PEER_FLAG_X448);
+
+  /* P has order l iff u != 0 and l*P is the point at infinity */
+  copy_EltFp448_1w_x64(u, key);
+  fred_EltFp448_1w_x64_inline(u);
+  x448_ladder_x64(X, Z, u, order_x448);
+  fred_EltFp448_1w_x64_inline(Z);
+  if ((u[0] | u[1] | u[2] | u[3] | u[4] | u[5] | u[6]) == 0 ||
+      (Z[0] | Z[1] | Z[2] | Z[3] | Z[4] | Z[5] | Z[6]) != 0) {
+    return;
+  }
+
+  /* M_k = (X_k+Z_k)/(X_k-Z_k), where (X_k:Z_k) = 2^k*P */
+  copy_EltFp448_1w_x64(X, u);
+  setzero_EltFp448_1w_x64(Z);
+  Z[0] = 1;
+  for (k = 0; k < PEER_ENTRIES_X448; k++) {
+    add_EltFp448_1w_x64_inline(A, X, Z);      /* A = X+Z       */
+    sub_EltFp448_1w_x64_inline(B, X, Z);      /* B = X-Z       */
+    copy_EltFp448_1w_x64(num + NUM_WORDS_ELTFP448_X64 * k, A);
+    copy_EltFp448_1w_x64(den + NUM_WORDS_ELTFP448_X64 * k, B);
+    sqr_EltFp448_2w_x64(AB);                  /* A = A**2     B = B**2   */
+    copy_EltFp448_1w_x64(C, B);               /* C = B         */
+    sub_EltFp448_1w_x64_inline(B, A, B);      /* B = A-B       */
+    mul_a24_EltFp448_1w_x64_inline(D, B);     /* D = my_a24*B  */
+    add_EltFp448_1w_x64_inline(D, D, C);      /* D = D+C       */
+    mul_EltFp448_2w_x64(coordinates, AB, CD); /* X = A*C   Z = B*D */
+  }
+
+  /**
+   * u(P+S) = (v-v_S)^2/(u+1)^2 - A - u + 1, where v^2 = w1 = u^3+A*u^2+u
+   * and v_S^2 = w2 = A-2, so that (v-v_S)^2 = w1 + w2 - 2*sqrt(w1*w2).
+   * Either square root gives P+S or P-S, which the ladder cannot tell apart.
+   */
+  add_EltFp448_1w_x64_inline(w1, u, param_A);
+  mul_EltFp448_1w_x64(w1, w1, u);
+  add_EltFp448_1w_x64_inline(w1, w1, one);
+  mul_EltFp448_1w_x64(w1, w1, u);
+  setzero_EltFp448_1w_x64(w2);
+  w2[0] = 156324;
+  mul_EltFp448_1w_x64(s, w1, w2);
+  sqrt_EltFp448_1w_x64(s, s);
+  add_EltFp448_1w_x64_inline(A, w1, w2);
+  sub_EltFp448_1w_x64_inline(A, A, s);
+  sub_EltFp448_1w_x64_inline(num + PEER_START_X448, A, s);
+  add_EltFp448_1w_x64_inline(B, u, one);
+  sqr_EltFp448_1w_x64(B);
+  copy_EltFp448_1w_x64(den + PEER_START_X448, B);
+
+  inv_batch_EltFp448_1w_x64(table, den, PEER_ENTRIES_X448 + 1);
+  for (k = 0; k <= PEER_ENTRIES_X448; k++) {
+    uint64_t *const M = table + NUM_WORDS_ELTFP448_X64 * k;
+    mul_EltFp448_1w_x64(M, M, num + NUM_WORDS_ELTFP448_X64 * k);
+    fred_EltFp448_1w_x64_inline(M);
+  }
+  sub_EltFp448_1w_x64_inline(start, start, param_A);
+  sub_EltFp448_1w_x64_inline(start, start, u);
+  add_EltFp448_1w_x64_inline(start, start, one);
+  fred_EltFp448_1w_x64_inline(start);
+  table[PEER_FLAG_X448] = 1;
+}
+
+/**
+ * Computes the shared secret with the table of x448_precompute_x64; the
+ * output is identical to that of x448_shared_x64.
+ */
+static void x448_shared_peer_x64(argKey shared, argPeerTable table,
+                                 argKey private_key) {
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  EltFp448_1w_x64 U, Z, invZ;
+
+  if (table[PEER_FLAG_X448] != 0) {
+    x448_precmp_ladder_x64(U, Z, table, table + PEER_START_X448,
+                           private_key);
+  } else {
+    x448_shared_ladder_x64(U, Z, (argKey)(table + PEER_KEY_X448),
+                           private_key);
+  }
+
+  inv_EltFp448_1w_x64(invZ, Z);
+  mul_EltFp448_1w_x64((uint64_t *)shared, U, invZ);
+  fred_EltFp448_1w_x64_inline((uint64_t *)shared);
+}
+
+static void x448_to_affine_4w_x64(argKey *out, uint64_t *const X,
+                                  uint64_t *const Z) {
+  ALIGN uint64_t invZ[4 * NUM_WORDS_ELTFP448_X64];
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  int lane = 0;
+
+  inv_batch_EltFp448_1w_x64(invZ, Z, 4);
+  for (lane = 0; lane < 4; lane++) {
+    uint64_t *const u = (uint64_t *)out[lane];
+    mul_EltFp448_1w_x64(u, X + NUM_WORDS_ELTFP448_X64 * lane,
+                        invZ + NUM_WORDS_ELTFP448_X64 * lane);
+    fred_EltFp448_1w_x64_inline(u);
+  }
 }
 
-const KeyGen X448_KeyGen = x448_keygen_x64;
-const Shared X448_Shared = x448_shared_x64;
+const X64Functions X448_x64 = {
+    x448_keygen_x64,       x448_shared_x64,
+    x448_keygen_batch_x64, x448_shared_batch_x64,
+    x448_precompute_x64,   x448_shared_peer_x64,
+    x448_to_affine_4w_x64,
+    {Table_Ladder_24k, NULL, Table_Comb_X448_18k},
+    {sizeof(Table_Ladder_24k), 0, sizeof(Table_Comb_X448_18k)}};
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "random.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <rfc7748_bulk.h>
+#include <vector>
+
+/* Arrays of n keys of the given size, with pointers to each one */
+struct Keys {
+  Keys(unsigned int n, unsigned int size) : bytes(n * size), ptr(n) {
+    for (unsigned int i = 0; i < n; i++) {
+      ptr[i] = &bytes[i * size];
+    }
+  }
+  std::vector<uint8_t> bytes;
+  std::vector<argKey> ptr;
+};
+
+typedef void (*BulkKeyGen)(Rfc7748Bulk *, argKey *, argKey *, unsigned int);
+typedef void (*BulkShared)(Rfc7748Bulk *, argKey *, argKey *, argKey *,
+                           unsigned int);
+
+/**
+ * Compares the bulk functions with KeyGen and Shared, for sizes that are
+ * and are not multiples of the chunks, and for more workers than chunks.
+ * With same_key, every entry uses the same private key buffer.
+ */
+static void check_bulk(unsigned int size, BulkKeyGen bulk_keygen,
+                       BulkShared bulk_shared, KeyGen keygen, Shared shared,
+                       bool same_key) {
+  const unsigned int threads[] = {1, 3, 8};
+  const unsigned int sizes[] = {0, 1, 63, 64, 1000};
+
+  for (unsigned int num_threads : threads) {
+    for (int pin = 0; pin < 2; pin++) {
+      Rfc7748Bulk *bulk = RFC7748_BulkCreate(num_threads, pin);
+      ASSERT_NE(bulk, nullptr);
+      ASSERT_EQ(RFC7748_BulkThreads(bulk), num_threads);
+      for (unsigned int n : sizes) {
+        Keys sk(n, size), pk(n, size), ss(n, size);
+        random_bytes(sk.bytes.data(), sk.bytes.size());
+        random_bytes(pk.bytes.data(), pk.bytes.size());
+        if (same_key) {
+          for (unsigned int i = 0; i < n; i++) {
+            sk.ptr[i] = sk.ptr[0];
+          }
+        }
+        std::vector<uint8_t> private_keys(sk.bytes);
+
+        bulk_keygen(bulk, pk.ptr.data(), sk.ptr.data(), n);
+        bulk_shared(bulk, ss.ptr.data(), pk.ptr.data(), sk.ptr.data(), n);
+        ASSERT_EQ(sk.bytes, private_keys) << "private keys were modified";
+        for (unsigned int i = 0; i < n; i++) {
+          std::vector<uint8_t> want(size);
+          keygen(want.data(), sk.ptr[i]);
+          ASSERT_EQ(memcmp(pk.ptr[i], want.data(), size), 0)
+              << "threads: " << num_threads << " n: " << n << " key: " << i;
+          shared(want.data(), pk.ptr[i], sk.ptr[i]);
+          ASSERT_EQ(memcmp(ss.ptr[i], want.data(), size), 0)
+              << "threads: " << num_threads << " n: " << n << " key: " << i;
+        }
+      }
+      RFC7748_BulkDestroy(bulk);
+    }
+  }
+}
+
+TEST(BULK, X25519) {
+  check_bulk(X25519_KEYSIZE_BYTES, RFC7748_BulkX25519_KeyGen,
+             RFC7748_BulkX25519_Shared, X25519_KeyGen, X25519_Shared, false);
+}
+
+TEST(BULK, X448) {
+  check_bulk(X448_KEYSIZE_BYTES, RFC7748_BulkX448_KeyGen,
+             RFC7748_BulkX448_Shared, X448_KeyGen, X448_Shared, false);
+}
+
+/* One private key against many peers, read by all workers at once */
+TEST(BULK, SAME_PRIVATE_KEY) {
+  check_bulk(X25519_KEYSIZE_BYTES, RFC7748_BulkX25519_KeyGen,
+             RFC7748_BulkX25519_Shared, X25519_KeyGen, X25519_Shared, true);
+  check_bulk(X448_KEYSIZE_BYTES, RFC7748_BulkX448_KeyGen,
+             RFC7748_BulkX448_Shared, X448_KeyGen, X448_Shared, true);
+}
+
+TEST(BULK, DEFAULT_THREADS) {
+  Rfc7748Bulk *bulk = RFC7748_BulkCreate(0, 1);
+  ASSERT_NE(bulk, nullptr);
+  EXPECT_GE(RFC7748_BulkThreads(bulk), 1u);
+  RFC7748_BulkDestroy(bulk);
+}
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "random.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <rfc7748_coalescer.hpp>
+#include <thread>
+#include <vector>
+
+/**
+ * Submits KeyGen and Shared requests from several threads, through both
+ * futures and callbacks, and compares them with the 1-way functions.
+ */
+template <typename Curve>
+static void check_coalescer(KeyGen keygen, Shared shared,
+                            unsigned int batch_size,
+                            unsigned int num_workers) {
+  typedef rfc7748::Coalescer<Curve> Coalescer;
+  typedef typename Coalescer::Key Key;
+  const unsigned int num_threads = 4, requests = 50;
+  typename Coalescer::Options options;
+  options.batch_size = batch_size;
+  options.num_workers = num_workers;
+  Coalescer coalescer(options);
+  std::atomic<unsigned int> errors(0), callbacks(0);
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&]() {
+      for (unsigned int i = 0; i < requests; i++) {
+        Key sk, pk, want_pk, want_ss;
+        random_bytes(sk.data(), sk.size());
+        random_bytes(pk.data(), pk.size());
+        keygen(want_pk.data(), sk.data());
+        shared(want_ss.data(), pk.data(), sk.data());
+        if (i % 2 == 0) {
+          errors += coalescer.KeyGen(sk).get() != want_pk;
+          errors += coalescer.Shared(pk, sk).get() != want_ss;
+        } else {
+          coalescer.KeyGen(sk, [&, want_pk](const Key &out) {
+            errors += out != want_pk;
+            callbacks++;
+          });
+          coalescer.Shared(pk, sk, [&, want_ss](const Key &out) {
+            errors += out != want_ss;
+            callbacks++;
+          });
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  while (callbacks < num_threads * requests) {
+    std::this_thread::yield();
+  }
+  typename Coalescer::Stats stats = coalescer.GetStats();
+
+  EXPECT_EQ(errors, 0u);
+  EXPECT_EQ(stats.requests, 2u * num_threads * requests);
+  EXPECT_LE(stats.full_batches, stats.batches);
+  EXPECT_GE(stats.batches * batch_size, stats.requests);
+}
+
+TEST(COALESCER, X25519) {
+  check_coalescer<rfc7748::X25519>(X25519_KeyGen, X25519_Shared, 1, 1);
+  check_coalescer<rfc7748::X25519>(X25519_KeyGen, X25519_Shared, 8, 1);
+  check_coalescer<rfc7748::X25519>(X25519_KeyGen, X25519_Shared, 7, 3);
+}
+
+TEST(COALESCER, X448) {
+  check_coalescer<rfc7748::X448>(X448_KeyGen, X448_Shared, 4, 1);
+  check_coalescer<rfc7748::X448>(X448_KeyGen, X448_Shared, 6, 2);
+}
+
+/* A lone request is not held back for longer than max_delay */
+TEST(COALESCER, MAX_DELAY) {
+  rfc7748::Coalescer<rfc7748::X25519>::Options options;
+  options.batch_size = 64;
+  options.max_delay = std::chrono::microseconds(1000);
+  rfc7748::Coalescer<rfc7748::X25519> coalescer(options);
+  rfc7748::Coalescer<rfc7748::X25519>::Key sk = {{1}}, want;
+
+  auto future = coalescer.KeyGen(sk);
+  EXPECT_EQ(future.wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+  X25519_KeyGen(want.data(), sk.data());
+  EXPECT_EQ(future.get(), want);
+  EXPECT_EQ(coalescer.GetStats().batches, 1u);
+  EXPECT_EQ(coalescer.GetStats().full_batches, 0u);
+}
+
+/* The destructor runs the requests still queued */
+TEST(COALESCER, DRAIN) {
+  std::future<rfc7748::Coalescer<rfc7748::X448>::Key> future;
+  rfc7748::Coalescer<rfc7748::X448>::Key sk = {{1}}, want;
+  {
+    rfc7748::Coalescer<rfc7748::X448>::Options options;
+    options.batch_size = 64;
+    options.max_delay = std::chrono::seconds(100);
+    rfc7748::Coalescer<rfc7748::X448> coalescer(options);
+    future = coalescer.KeyGen(sk);
+  }
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(0)),
+            std::future_status::ready);
+  X448_KeyGen(want.data(), sk.data());
+  EXPECT_EQ(future.get(), want);
+}
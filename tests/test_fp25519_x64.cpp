@@ -32,6 +32,8 @@
  */
 
 #include <fp25519_x64.h>
+#include <rfc7748_precomputed.h>
+#include <safegcd_x64.h>
 #include <gmp.h>
 #include <gtest/gtest.h>
 #include "random.h"
@@ -51,6 +53,36 @@ static std::ostream &operator<<(std::ostream &os,
   return os << std::endl;
 }
 
+/* The BMI2 and ADX builds of the field arithmetic (see x64_variant.h) */
+extern "C" {
+void sqrn_EltFp25519_1w_x64_bmi2(uint64_t *const c, uint64_t *const a,
+                                 unsigned int n);
+void sqrn_EltFp25519_1w_x64_adx(uint64_t *const c, uint64_t *const a,
+                                unsigned int n);
+void ladder_step_EltFp25519_x64_bmi2(uint64_t *const P, uint64_t *const X1,
+                                     uint64_t swap);
+void ladder_step_EltFp25519_x64_adx(uint64_t *const P, uint64_t *const X1,
+                                    uint64_t swap);
+}
+
+static const struct {
+  Rfc7748Impl impl;
+  void (*sqrn)(uint64_t *const c, uint64_t *const a, unsigned int n);
+} sqrn_impls[] = {
+    {RFC7748_IMPL_MULQ, sqrn_EltFp25519_1w_x64},
+    {RFC7748_IMPL_BMI2, sqrn_EltFp25519_1w_x64_bmi2},
+    {RFC7748_IMPL_ADX, sqrn_EltFp25519_1w_x64_adx},
+};
+
+static const struct {
+  Rfc7748Impl impl;
+  void (*ladder_step)(uint64_t *const P, uint64_t *const X1, uint64_t swap);
+} ladder_step_impls[] = {
+    {RFC7748_IMPL_MULQ, ladder_step_EltFp25519_x64},
+    {RFC7748_IMPL_BMI2, ladder_step_EltFp25519_x64_bmi2},
+    {RFC7748_IMPL_ADX, ladder_step_EltFp25519_x64_adx},
+};
+
 /* Verifies that (a^2-b^2) == (a+b)(a-b) */
 TEST(FP25519, MUL_VS_SQR) {
   int64_t i;
@@ -81,6 +113,44 @@ TEST(FP25519, MUL_VS_SQR) {
                              << std::endl;
 }
 
+/* Verifies that sqrn computes n consecutive squarings, also in place */
+TEST(FP25519, SQRN) {
+  for (const auto &v : sqrn_impls) {
+    if (!RFC7748_HasImpl(v.impl)) {
+      continue;
+    }
+    int64_t i;
+    int64_t cnt = 0;
+    EltFp25519_1w_x64 a, c, d;
+    EltFp25519_1w_Buffer_x64 buffer_1w;
+
+    for (i = 0; i < TEST_TIMES / 100; i++) {
+      const unsigned int n = i % 128;
+      random_EltFp25519_1w_x64(a);
+
+      copy_EltFp25519_1w_x64(d, a);
+      for (unsigned int j = 0; j < n; j++) {
+        sqr_EltFp25519_1w_x64(d);
+      }
+      v.sqrn(c, a, n);
+      v.sqrn(a, a, n);
+      fred_EltFp25519_1w_x64(a);
+      fred_EltFp25519_1w_x64(c);
+      fred_EltFp25519_1w_x64(d);
+
+      ASSERT_EQ(memcmp(c, d, SIZE_BYTES_FP25519), 0)
+          << "impl: " << v.impl << " n: " << n << std::endl
+          << "got:  " << c << "want: " << d;
+      ASSERT_EQ(memcmp(a, d, SIZE_BYTES_FP25519), 0)
+          << "impl: " << v.impl << " n: " << n << std::endl
+          << "got:  " << a << "want: " << d;
+      cnt++;
+    }
+    EXPECT_EQ(cnt, TEST_TIMES / 100) << "impl: " << v.impl << " passed: " << cnt
+                                     << "/" << TEST_TIMES / 100 << std::endl;
+  }
+}
+
 /* Verifies that (a*b*a^1) == (b) */
 TEST(FP25519, MUL_VS_INV) {
   int64_t i;
@@ -106,6 +176,39 @@ TEST(FP25519, MUL_VS_INV) {
                              << std::endl;
 }
 
+/**
+ * Verifies that sqrt(a^2)^2 == a^2, and that 2*a^2, which is not a square
+ * since p = 5 mod 8, is rejected.
+ */
+TEST(FP25519, SQRT) {
+  int64_t i;
+  int64_t cnt = 0;
+  EltFp25519_1w_x64 a, b, r, two = {2};
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+
+  for (i = 0; i < TEST_TIMES / 10; i++) {
+    random_EltFp25519_1w_x64(a);
+    if (i == 0) {
+      memset(a, 0, sizeof(a));
+    }
+
+    mul_EltFp25519_1w_x64(b, a, a);
+    ASSERT_EQ(sqrt_EltFp25519_1w_x64(r, b), 1) << "a: " << a;
+    sqr_EltFp25519_1w_x64(r);
+    fred_EltFp25519_1w_x64(r);
+    fred_EltFp25519_1w_x64(b);
+    ASSERT_EQ(memcmp(r, b, SIZE_BYTES_FP25519), 0) << "got:  " << r
+                                                   << "want: " << b;
+    if (i > 0) {
+      mul_EltFp25519_1w_x64(b, b, two);
+      ASSERT_EQ(sqrt_EltFp25519_1w_x64(r, b), 0) << "a: " << a;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, TEST_TIMES / 10) << "passed: " << cnt << "/"
+                                  << TEST_TIMES / 10 << std::endl;
+}
+
 /* Verifies that 0 <= c=a+b < 2^256 and that c be congruent to a+b mod p */
 TEST(FP25519, ADDITION) {
   int count = 0;
@@ -286,6 +389,8 @@ TEST(FP25519, SQUARING) {
 /* Verifies that 0 <= c=a^-1 < 2^256 and that c be congruent to a^-1 mod p */
 TEST(FP25519, INVERSION) {
   int count = 0;
+  const Rfc7748Inv inv = RFC7748_GetInv();
+  RFC7748_SetInv(RFC7748_INV_FERMAT);
   EltFp25519_1w_x64 a, get_c, want_c;
 
   mpz_t gmp_a, gmp_c, two_prime, prime_minus_two;
@@ -325,6 +430,106 @@ TEST(FP25519, INVERSION) {
   mpz_clear(gmp_c);
   mpz_clear(two_prime);
   mpz_clear(prime_minus_two);
+  RFC7748_SetInv(inv);
+}
+
+/**
+ * Verifies that 0 <= c=a^-1 < p for the safegcd inversion, starting with
+ * the edge cases 0, 1, p-1, p, p+1 and 2^256-1.
+ */
+TEST(FP25519, INVERSION_SAFEGCD) {
+  int count = 0;
+  EltFp25519_1w_x64 a, get_c, want_c;
+
+  mpz_t gmp_a, gmp_c, prime, prime_minus_two, edge[6];
+  mpz_init(gmp_a);
+  mpz_init(gmp_c);
+
+  // prime = 2^255-19
+  mpz_init_set_ui(prime, 1);
+  mpz_mul_2exp(prime, prime, 255);
+  mpz_sub_ui(prime, prime, 19);
+  mpz_init(prime_minus_two);
+  mpz_sub_ui(prime_minus_two, prime, 2);
+
+  mpz_init_set_ui(edge[0], 0);
+  mpz_init_set_ui(edge[1], 1);
+  mpz_init(edge[2]);
+  mpz_sub_ui(edge[2], prime, 1);
+  mpz_init_set(edge[3], prime);
+  mpz_init(edge[4]);
+  mpz_add_ui(edge[4], prime, 1);
+  mpz_init_set_ui(edge[5], 1);
+  mpz_mul_2exp(edge[5], edge[5], 256);
+  mpz_sub_ui(edge[5], edge[5], 1);
+
+  for (int i = 0; i < TEST_TIMES; i++) {
+    setzero_EltFp25519_1w_x64(a);
+    setzero_EltFp25519_1w_x64(get_c);
+    setzero_EltFp25519_1w_x64(want_c);
+
+    if (i < 6) {
+      mpz_export(a, NULL, -1, sizeof(a[0]), 0, 0, edge[i]);
+    } else {
+      random_EltFp25519_1w_x64(a);
+    }
+
+    inv_safegcd_EltFp25519_1w_x64(get_c, a);
+
+    mpz_import(gmp_a, NUM_WORDS_ELTFP25519_X64, -1, sizeof(a[0]), 0, 0, a);
+    mpz_powm(gmp_c, gmp_a, prime_minus_two, prime);
+    mpz_export(want_c, NULL, -1, SIZE_BYTES_FP25519, 0, 0, gmp_c);
+
+    ASSERT_EQ(memcmp(get_c, want_c, SIZE_BYTES_FP25519), 0)
+        << "a: " << a << "got:  " << get_c << "want: " << want_c;
+    count++;
+  }
+  EXPECT_EQ(count, TEST_TIMES) << "passed: " << count << "/" << TEST_TIMES
+                               << std::endl;
+
+  mpz_clear(gmp_a);
+  mpz_clear(gmp_c);
+  mpz_clear(prime);
+  mpz_clear(prime_minus_two);
+  for (int i = 0; i < 6; i++) {
+    mpz_clear(edge[i]);
+  }
+}
+
+/* Verifies that inv_batch computes the same inverses as inv, zero included */
+TEST(FP25519, INVERSION_BATCH) {
+  const unsigned int n = 37;
+  int count = 0;
+  ALIGN uint64_t a[n * NUM_WORDS_ELTFP25519_X64];
+  ALIGN uint64_t get_c[n * NUM_WORDS_ELTFP25519_X64];
+  EltFp25519_1w_x64 want_c;
+
+  for (int i = 0; i < TEST_TIMES / 100; i++) {
+    random_bytes(reinterpret_cast<uint8_t *>(a), n * SIZE_BYTES_FP25519);
+    /* A zero and a non-canonical zero (p = 2^255-19) */
+    setzero_EltFp25519_1w_x64(a + NUM_WORDS_ELTFP25519_X64 * (i % n));
+    uint64_t *const p = a + NUM_WORDS_ELTFP25519_X64 * ((i + 5) % n);
+    p[0] = 0xffffffffffffffed;
+    p[1] = 0xffffffffffffffff;
+    p[2] = 0xffffffffffffffff;
+    p[3] = 0x7fffffffffffffff;
+
+    inv_batch_EltFp25519_1w_x64(get_c, a, n);
+
+    for (unsigned int j = 0; j < n; j++) {
+      uint64_t *const c = get_c + NUM_WORDS_ELTFP25519_X64 * j;
+      inv_EltFp25519_1w_x64(want_c, a + NUM_WORDS_ELTFP25519_X64 * j);
+      fred_EltFp25519_1w_x64(want_c);
+      fred_EltFp25519_1w_x64(c);
+      ASSERT_EQ(memcmp(c, want_c, SIZE_BYTES_FP25519), 0)
+          << "index: " << j << std::endl
+          << "got:  " << *reinterpret_cast<EltFp25519_1w_x64 *>(c)
+          << "want: " << want_c;
+    }
+    count++;
+  }
+  EXPECT_EQ(count, TEST_TIMES / 100)
+      << "passed: " << count << "/" << TEST_TIMES / 100 << std::endl;
 }
 
 /* Verifies that 0<= c=a*b < 2^256 and that c be congruent to a*b mod p */
@@ -429,6 +634,85 @@ TEST(FP25519, MULA24) {
   mpz_clear(two_to_256);
 }
 
+/**
+ * Verifies that one ladder step on [X2|Z2|X3|Z3] is congruent mod p to
+ * doubling (X2:Z2) (or (X3:Z3) if swap = 1) and adding both points.
+ */
+TEST(FP25519, LADDER_STEP) {
+  const uint64_t a24 = 121666;
+  ALIGN uint64_t P[4 * NUM_WORDS_ELTFP25519_X64];
+  EltFp25519_1w_x64 X1, want_c;
+
+  mpz_t prime, x1, x2, z2, x3, z3, a, b, c, d, da, cb, e, t;
+  mpz_t *const coord[4] = {&x2, &z2, &x3, &z3};
+  mpz_inits(x1, x2, z2, x3, z3, a, b, c, d, da, cb, e, t, NULL);
+
+  // prime = 2^255-19
+  mpz_init_set_ui(prime, 1);
+  mpz_mul_2exp(prime, prime, 255);
+  mpz_sub_ui(prime, prime, 19);
+
+  for (const auto &v : ladder_step_impls) {
+    if (!RFC7748_HasImpl(v.impl)) {
+      continue;
+    }
+    int count = 0;
+    for (int i = 0; i < TEST_TIMES; i++) {
+      const uint64_t swap = i & 1;
+      for (int j = 0; j < 4; j++) {
+        random_EltFp25519_1w_x64(P + NUM_WORDS_ELTFP25519_X64 * j);
+        mpz_import(*coord[j], NUM_WORDS_ELTFP25519_X64, -1, sizeof(P[0]), 0,
+                   0, P + NUM_WORDS_ELTFP25519_X64 * j);
+      }
+      random_EltFp25519_1w_x64(X1);
+      mpz_import(x1, NUM_WORDS_ELTFP25519_X64, -1, sizeof(X1[0]), 0, 0, X1);
+
+      v.ladder_step(P, X1, swap);
+
+      mpz_add(a, x2, z2);
+      mpz_sub(b, x2, z2);
+      mpz_add(c, x3, z3);
+      mpz_sub(d, x3, z3);
+      mpz_mul(da, d, a);
+      mpz_mul(cb, c, b);
+      if (swap) {
+        mpz_swap(a, c);
+        mpz_swap(b, d);
+      }
+      mpz_add(x3, da, cb);
+      mpz_mul(x3, x3, x3);
+      mpz_sub(z3, da, cb);
+      mpz_mul(z3, z3, z3);
+      mpz_mul(z3, z3, x1);
+      mpz_mul(a, a, a);
+      mpz_mul(b, b, b);
+      mpz_sub(e, a, b);
+      mpz_mul(x2, a, b);
+      mpz_mul_ui(t, e, a24);
+      mpz_add(t, t, b);
+      mpz_mul(z2, e, t);
+
+      for (int j = 0; j < 4; j++) {
+        uint64_t *const get_c = P + NUM_WORDS_ELTFP25519_X64 * j;
+        fred_EltFp25519_1w_x64(get_c);
+        setzero_EltFp25519_1w_x64(want_c);
+        mpz_mod(*coord[j], *coord[j], prime);
+        mpz_export(want_c, NULL, -1, SIZE_BYTES_FP25519, 0, 0, *coord[j]);
+
+        ASSERT_EQ(memcmp(get_c, want_c, SIZE_BYTES_FP25519), 0)
+            << "impl: " << v.impl << " coordinate: " << j
+            << " swap: " << swap << std::endl
+            << "got:  " << get_c << "want: " << want_c;
+      }
+      count++;
+    }
+    EXPECT_EQ(count, TEST_TIMES) << "impl: " << v.impl << " passed: " << count
+                                 << "/" << TEST_TIMES << std::endl;
+  }
+
+  mpz_clears(prime, x1, x2, z2, x3, z3, a, b, c, d, da, cb, e, t, NULL);
+}
+
 /* Verifies that 0 <= c=a mod p < 2^255-19 for a number 0 <= a < 2^256 */
 TEST(FP25519, FREDUCTION) {
   int count = 0;
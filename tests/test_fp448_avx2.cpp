@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <fp448_avx2.h>
+#include <fp448_x64.h>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
+#include "random.h"
+
+#define TEST_TIMES 20000
+#define NUM_LANES 4
+
+typedef ALIGN uint64_t EltFp448_4x1w_x64[NUM_LANES * NUM_WORDS_ELTFP448_X64];
+
+static void random_EltFp448_4x1w_x64(uint64_t *A) {
+  random_bytes(reinterpret_cast<uint8_t *>(A), NUM_LANES * SIZE_BYTES_FP448);
+}
+
+/* Converts to x64, multiplying by one so any digit bound is accepted */
+static void store_canonical(uint64_t *c, uint64_t *a) {
+  EltFp448_4w_avx2 one, t;
+  for (int i = 0; i < NUM_WORDS_ELTFP448_AVX2; i++) {
+    one[i] = i < NUM_LANES;
+  }
+  mul_EltFp448_4w_avx2(t, a, one);
+  store_EltFp448_4w_avx2(c, t);
+  for (int j = 0; j < NUM_LANES; j++) {
+    fred_EltFp448_1w_x64(c + NUM_WORDS_ELTFP448_X64 * j);
+  }
+}
+
+static std::string to_hex(const uint64_t *number) {
+  std::ostringstream os;
+  os << "0x";
+  for (int i = NUM_WORDS_ELTFP448_X64 - 1; i >= 0; i--) {
+    os << std::setbase(16) << std::setfill('0') << std::setw(16) << number[i];
+  }
+  os << std::endl;
+  return os.str();
+}
+
+#define SKIP_WITHOUT_AVX2()                      \
+  do {                                           \
+    if (!__builtin_cpu_supports("avx2")) {       \
+      GTEST_SKIP() << "AVX2 is not supported";   \
+    }                                            \
+  } while (0)
+
+#define EXPECT_LANES_EQ(get, want)                               \
+  for (int j = 0; j < NUM_LANES; j++) {                          \
+    uint64_t *const g = get + NUM_WORDS_ELTFP448_X64 * j;      \
+    uint64_t *const w = want + NUM_WORDS_ELTFP448_X64 * j;     \
+    fred_EltFp448_1w_x64(w);                                   \
+    ASSERT_EQ(memcmp(g, w, SIZE_BYTES_FP448), 0)               \
+        << "lane: " << j << std::endl                            \
+        << "got:  " << to_hex(g) << "want: " << to_hex(w);       \
+  }
+
+/* Verifies that load followed by store preserves the value modulo p */
+TEST(FP448_AVX2, LOAD_STORE) {
+  SKIP_WITHOUT_AVX2();
+  int64_t cnt = 0;
+  EltFp448_4x1w_x64 a, get_c, want_c;
+  EltFp448_4w_avx2 A;
+
+  for (int i = 0; i < TEST_TIMES; i++) {
+    random_EltFp448_4x1w_x64(a);
+    memcpy(want_c, a, sizeof(a));
+
+    load_EltFp448_4w_avx2(A, a);
+    store_EltFp448_4w_avx2(get_c, A);
+    for (int j = 0; j < NUM_LANES; j++) {
+      fred_EltFp448_1w_x64(get_c + NUM_WORDS_ELTFP448_X64 * j);
+    }
+    EXPECT_LANES_EQ(get_c, want_c);
+    cnt++;
+  }
+  EXPECT_EQ(cnt, TEST_TIMES) << "passed: " << cnt << "/" << TEST_TIMES
+                             << std::endl;
+}
+
+/* Verifies add, sub, mul and sqr lane by lane against the x64 functions */
+TEST(FP448_AVX2, ARITHMETIC) {
+  SKIP_WITHOUT_AVX2();
+  int64_t cnt = 0;
+  EltFp448_4x1w_x64 a, b, get_c, want_c;
+  EltFp448_4w_avx2 A, B, C;
+  EltFp448_1w_Buffer_x64 buffer_1w;
+
+  for (int i = 0; i < TEST_TIMES; i++) {
+    random_EltFp448_4x1w_x64(a);
+    random_EltFp448_4x1w_x64(b);
+    load_EltFp448_4w_avx2(A, a);
+    load_EltFp448_4w_avx2(B, b);
+
+    add_EltFp448_4w_avx2(C, A, B);
+    store_canonical(get_c, C);
+    for (int j = 0; j < NUM_LANES; j++) {
+      const int k = NUM_WORDS_ELTFP448_X64 * j;
+      add_EltFp448_1w_x64(want_c + k, a + k, b + k);
+    }
+    EXPECT_LANES_EQ(get_c, want_c);
+
+    sub_EltFp448_4w_avx2(C, A, B);
+    store_canonical(get_c, C);
+    for (int j = 0; j < NUM_LANES; j++) {
+      const int k = NUM_WORDS_ELTFP448_X64 * j;
+      sub_EltFp448_1w_x64(want_c + k, a + k, b + k);
+    }
+    EXPECT_LANES_EQ(get_c, want_c);
+
+    mul_EltFp448_4w_avx2(C, A, B);
+    store_canonical(get_c, C);
+    for (int j = 0; j < NUM_LANES; j++) {
+      const int k = NUM_WORDS_ELTFP448_X64 * j;
+      mul_EltFp448_1w_x64(want_c + k, a + k, b + k);
+    }
+    EXPECT_LANES_EQ(get_c, want_c);
+
+    sqr_EltFp448_4w_avx2(C, A);
+    store_canonical(get_c, C);
+    for (int j = 0; j < NUM_LANES; j++) {
+      const int k = NUM_WORDS_ELTFP448_X64 * j;
+      memcpy(want_c + k, a + k, SIZE_BYTES_FP448);
+      sqr_EltFp448_1w_x64(want_c + k);
+    }
+    EXPECT_LANES_EQ(get_c, want_c);
+
+    mul_a24_EltFp448_4w_avx2(C, A);
+    store_canonical(get_c, C);
+    for (int j = 0; j < NUM_LANES; j++) {
+      const int k = NUM_WORDS_ELTFP448_X64 * j;
+      mul_a24_EltFp448_1w_x64(want_c + k, a + k);
+    }
+    EXPECT_LANES_EQ(get_c, want_c);
+    cnt++;
+  }
+  EXPECT_EQ(cnt, TEST_TIMES) << "passed: " << cnt << "/" << TEST_TIMES
+                             << std::endl;
+}
+
+/**
+ * Verifies mul and sqr on inputs with the largest digits allowed, i.e.
+ * sums and differences of reduced elements, as in the ladder step.
+ */
+TEST(FP448_AVX2, LARGE_DIGITS) {
+  SKIP_WITHOUT_AVX2();
+  int64_t cnt = 0;
+  EltFp448_4x1w_x64 a, b, s, d, get_c, want_c;
+  EltFp448_4w_avx2 A, B, S, D, C;
+  EltFp448_1w_Buffer_x64 buffer_1w;
+
+  for (int i = 0; i < TEST_TIMES; i++) {
+    random_EltFp448_4x1w_x64(a);
+    random_EltFp448_4x1w_x64(b);
+    if (i == 0) {
+      /* All digits are maximal after loading 2^448-1 */
+      memset(a, 0xFF, sizeof(a));
+      memset(b, 0xFF, sizeof(b));
+    }
+    load_EltFp448_4w_avx2(A, a);
+    load_EltFp448_4w_avx2(B, b);
+    mul_EltFp448_4w_avx2(A, A, A);
+    sqr_EltFp448_4w_avx2(B, B);
+    add_EltFp448_4w_avx2(S, A, B);
+    sub_EltFp448_4w_avx2(D, A, B);
+
+    mul_EltFp448_4w_avx2(C, S, D);
+    sqr_EltFp448_4w_avx2(S, S);
+    mul_EltFp448_4w_avx2(C, C, S);
+    store_EltFp448_4w_avx2(get_c, C);
+    for (int j = 0; j < NUM_LANES; j++) {
+      const int k = NUM_WORDS_ELTFP448_X64 * j;
+      fred_EltFp448_1w_x64(get_c + k);
+      sqr_EltFp448_1w_x64(a + k);
+      sqr_EltFp448_1w_x64(b + k);
+      add_EltFp448_1w_x64(s + k, a + k, b + k);
+      sub_EltFp448_1w_x64(d + k, a + k, b + k);
+      mul_EltFp448_1w_x64(want_c + k, s + k, d + k);
+      sqr_EltFp448_1w_x64(s + k);
+      mul_EltFp448_1w_x64(want_c + k, want_c + k, s + k);
+    }
+    EXPECT_LANES_EQ(get_c, want_c);
+    cnt++;
+  }
+  EXPECT_EQ(cnt, TEST_TIMES) << "passed: " << cnt << "/" << TEST_TIMES
+                             << std::endl;
+}
+
+/* Verifies that cswap only exchanges the selected lanes */
+TEST(FP448_AVX2, CSWAP) {
+  SKIP_WITHOUT_AVX2();
+  EltFp448_4x1w_x64 a, b, get_a, get_b;
+  EltFp448_4w_avx2 A, B;
+  ALIGN uint64_t mask[NUM_LANES];
+
+  for (int m = 0; m < (1 << NUM_LANES); m++) {
+    random_EltFp448_4x1w_x64(a);
+    random_EltFp448_4x1w_x64(b);
+    for (int j = 0; j < NUM_LANES; j++) {
+      mask[j] = -(uint64_t)((m >> j) & 1);
+    }
+    load_EltFp448_4w_avx2(A, a);
+    load_EltFp448_4w_avx2(B, b);
+    cswap_EltFp448_4w_avx2(mask, A, B);
+    store_EltFp448_4w_avx2(get_a, A);
+    store_EltFp448_4w_avx2(get_b, B);
+    for (int j = 0; j < NUM_LANES; j++) {
+      const int k = NUM_WORDS_ELTFP448_X64 * j;
+      uint64_t *const want_a = (m >> j) & 1 ? b + k : a + k;
+      uint64_t *const want_b = (m >> j) & 1 ? a + k : b + k;
+      fred_EltFp448_1w_x64(get_a + k);
+      fred_EltFp448_1w_x64(get_b + k);
+      fred_EltFp448_1w_x64(want_a);
+      fred_EltFp448_1w_x64(want_b);
+      ASSERT_EQ(memcmp(get_a + k, want_a, SIZE_BYTES_FP448), 0)
+          << "mask: " << m << " lane: " << j;
+      ASSERT_EQ(memcmp(get_b + k, want_b, SIZE_BYTES_FP448), 0)
+          << "mask: " << m << " lane: " << j;
+    }
+  }
+}
@@ -32,6 +32,9 @@
  */
 
 #include <fp448_x64.h>
+#include <rfc7748_precomputed.h>
+#include <safegcd_x64.h>
+#include <gmp.h>
 #include <gtest/gtest.h>
 #include "random.h"
 
@@ -41,6 +44,23 @@ static void random_EltFp448_1w_x64(uint64_t *A) {
   random_bytes(reinterpret_cast<uint8_t *>(A), SIZE_BYTES_FP448);
 }
 
+/* The BMI2 and ADX builds of the field arithmetic (see x64_variant.h) */
+extern "C" {
+void sqrn_EltFp448_1w_x64_bmi2(uint64_t *const c, uint64_t *const a,
+                               unsigned int n);
+void sqrn_EltFp448_1w_x64_adx(uint64_t *const c, uint64_t *const a,
+                              unsigned int n);
+}
+
+static const struct {
+  Rfc7748Impl impl;
+  void (*sqrn)(uint64_t *const c, uint64_t *const a, unsigned int n);
+} sqrn_impls[] = {
+    {RFC7748_IMPL_MULQ, sqrn_EltFp448_1w_x64},
+    {RFC7748_IMPL_BMI2, sqrn_EltFp448_1w_x64_bmi2},
+    {RFC7748_IMPL_ADX, sqrn_EltFp448_1w_x64_adx},
+};
+
 // Verifies that (a^2-b^2) == (a+b)(a-b)
 TEST(FP448, MUL_VS_SQR) {
   int64_t i;
@@ -71,6 +91,44 @@ TEST(FP448, MUL_VS_SQR) {
                              << std::endl;
 }
 
+/* Verifies that sqrn computes n consecutive squarings, also in place */
+TEST(FP448, SQRN) {
+  for (const auto &v : sqrn_impls) {
+    if (!RFC7748_HasImpl(v.impl)) {
+      continue;
+    }
+    int64_t i;
+    int64_t cnt = 0;
+    EltFp448_1w_x64 a, c, d;
+    EltFp448_1w_Buffer_x64 buffer_1w;
+
+    for (i = 0; i < TEST_TIMES / 100; i++) {
+      const unsigned int n = i % 128;
+      random_EltFp448_1w_x64(a);
+
+      copy_EltFp448_1w_x64(d, a);
+      for (unsigned int j = 0; j < n; j++) {
+        sqr_EltFp448_1w_x64(d);
+      }
+      v.sqrn(c, a, n);
+      v.sqrn(a, a, n);
+      fred_EltFp448_1w_x64(a);
+      fred_EltFp448_1w_x64(c);
+      fred_EltFp448_1w_x64(d);
+
+      ASSERT_EQ(memcmp(c, d, SIZE_BYTES_FP448), 0)
+          << "impl: " << v.impl << " n: " << n << std::endl
+          << "got:  " << c << "want: " << d;
+      ASSERT_EQ(memcmp(a, d, SIZE_BYTES_FP448), 0)
+          << "impl: " << v.impl << " n: " << n << std::endl
+          << "got:  " << a << "want: " << d;
+      cnt++;
+    }
+    EXPECT_EQ(cnt, TEST_TIMES / 100) << "impl: " << v.impl << " passed: " << cnt
+                                     << "/" << TEST_TIMES / 100 << std::endl;
+  }
+}
+
 // Verifies that (a*b*a^1) == (b)
 TEST(FP448, MUL_VS_INV) {
   int64_t i;
@@ -95,3 +153,138 @@ TEST(FP448, MUL_VS_INV) {
   EXPECT_EQ(cnt, TEST_TIMES) << "passed: " << cnt << "/" << TEST_TIMES
                              << std::endl;
 }
+
+/**
+ * Verifies that sqrt(a^2)^2 == a^2, and that -a^2, which is not a square
+ * since p = 3 mod 4, is rejected.
+ */
+TEST(FP448, SQRT) {
+  int64_t i;
+  int64_t cnt = 0;
+  EltFp448_1w_x64 a, b, r, zero = {0};
+  EltFp448_1w_Buffer_x64 buffer_1w;
+
+  for (i = 0; i < TEST_TIMES / 10; i++) {
+    random_EltFp448_1w_x64(a);
+    if (i == 0) {
+      memset(a, 0, sizeof(a));
+    }
+
+    mul_EltFp448_1w_x64(b, a, a);
+    ASSERT_EQ(sqrt_EltFp448_1w_x64(r, b), 1) << "a: " << a;
+    sqr_EltFp448_1w_x64(r);
+    fred_EltFp448_1w_x64(r);
+    fred_EltFp448_1w_x64(b);
+    ASSERT_EQ(memcmp(r, b, SIZE_BYTES_FP448), 0) << "got:  " << r
+                                                 << "want: " << b;
+    if (i > 0) {
+      sub_EltFp448_1w_x64(b, zero, b);
+      ASSERT_EQ(sqrt_EltFp448_1w_x64(r, b), 0) << "a: " << a;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, TEST_TIMES / 10) << "passed: " << cnt << "/"
+                                  << TEST_TIMES / 10 << std::endl;
+}
+
+/**
+ * Verifies that 0 <= c=a^-1 < p for the safegcd inversion, starting with
+ * the edge cases 0, 1, p-1, p, p+1 and 2^448-1.
+ */
+TEST(FP448, INVERSION_SAFEGCD) {
+  int count = 0;
+  EltFp448_1w_x64 a, get_c, want_c;
+
+  mpz_t gmp_a, gmp_c, prime, prime_minus_two, edge[6];
+  mpz_init(gmp_a);
+  mpz_init(gmp_c);
+
+  // prime = 2^448-2^224-1
+  mpz_init_set_ui(prime, 1);
+  mpz_mul_2exp(prime, prime, 224);
+  mpz_sub_ui(prime, prime, 1);
+  mpz_mul_2exp(prime, prime, 224);
+  mpz_sub_ui(prime, prime, 1);
+  mpz_init(prime_minus_two);
+  mpz_sub_ui(prime_minus_two, prime, 2);
+
+  mpz_init_set_ui(edge[0], 0);
+  mpz_init_set_ui(edge[1], 1);
+  mpz_init(edge[2]);
+  mpz_sub_ui(edge[2], prime, 1);
+  mpz_init_set(edge[3], prime);
+  mpz_init(edge[4]);
+  mpz_add_ui(edge[4], prime, 1);
+  mpz_init_set_ui(edge[5], 1);
+  mpz_mul_2exp(edge[5], edge[5], 448);
+  mpz_sub_ui(edge[5], edge[5], 1);
+
+  for (int i = 0; i < TEST_TIMES; i++) {
+    setzero_EltFp448_1w_x64(a);
+    setzero_EltFp448_1w_x64(get_c);
+    setzero_EltFp448_1w_x64(want_c);
+
+    if (i < 6) {
+      mpz_export(a, NULL, -1, sizeof(a[0]), 0, 0, edge[i]);
+    } else {
+      random_EltFp448_1w_x64(a);
+    }
+
+    inv_safegcd_EltFp448_1w_x64(get_c, a);
+
+    mpz_import(gmp_a, NUM_WORDS_ELTFP448_X64, -1, sizeof(a[0]), 0, 0, a);
+    mpz_powm(gmp_c, gmp_a, prime_minus_two, prime);
+    mpz_export(want_c, NULL, -1, SIZE_BYTES_FP448, 0, 0, gmp_c);
+
+    ASSERT_EQ(memcmp(get_c, want_c, SIZE_BYTES_FP448), 0)
+        << "a: " << a << "got:  " << get_c << "want: " << want_c;
+    count++;
+  }
+  EXPECT_EQ(count, TEST_TIMES) << "passed: " << count << "/" << TEST_TIMES
+                               << std::endl;
+
+  mpz_clear(gmp_a);
+  mpz_clear(gmp_c);
+  mpz_clear(prime);
+  mpz_clear(prime_minus_two);
+  for (int i = 0; i < 6; i++) {
+    mpz_clear(edge[i]);
+  }
+}
+
+/* Verifies that the 2-way mul and sqr match two calls of the 1-way ones */
+TEST(FP448, MUL_SQR_2W) {
+  int64_t i;
+  int64_t cnt = 0;
+  EltFp448_2w_x64 a, b, c, d;
+  EltFp448_2w_Buffer_x64 buffer_2w;
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  uint64_t *const a1 = a + NUM_WORDS_ELTFP448_X64;
+  uint64_t *const b1 = b + NUM_WORDS_ELTFP448_X64;
+  uint64_t *const c1 = c + NUM_WORDS_ELTFP448_X64;
+  uint64_t *const d1 = d + NUM_WORDS_ELTFP448_X64;
+
+  for (i = 0; i < TEST_TIMES; i++) {
+    random_EltFp448_1w_x64(a);
+    random_EltFp448_1w_x64(a1);
+    random_EltFp448_1w_x64(b);
+    random_EltFp448_1w_x64(b1);
+
+    mul_EltFp448_2w_x64(c, a, b);
+    mul_EltFp448_1w_x64(d, a, b);
+    mul_EltFp448_1w_x64(d1, a1, b1);
+    EXPECT_EQ(memcmp(c, d, sizeof(c)), 0) << "mul" << std::endl;
+
+    sqr_EltFp448_2w_x64(c);
+    sqr_EltFp448_1w_x64(d);
+    sqr_EltFp448_1w_x64(d1);
+    fred_EltFp448_1w_x64(c);
+    fred_EltFp448_1w_x64(c1);
+    fred_EltFp448_1w_x64(d);
+    fred_EltFp448_1w_x64(d1);
+    EXPECT_EQ(memcmp(c, d, sizeof(c)), 0) << "sqr" << std::endl;
+    cnt++;
+  }
+  EXPECT_EQ(cnt, TEST_TIMES) << "passed: " << cnt << "/" << TEST_TIMES
+                             << std::endl;
+}
@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "random.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <rfc7748_keypool.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void wait_ready(Rfc7748KeyPool *pool, unsigned int level) {
+  Rfc7748PoolStats stats;
+  do {
+    std::this_thread::yield();
+    RFC7748_PoolGetStats(pool, &stats);
+  } while (stats.ready < level);
+}
+
+TEST(KEYPOOL, CONFIG) {
+  Rfc7748PoolConfig config = {};
+  EXPECT_EQ(RFC7748_PoolCreate(RFC7748_POOL_X25519, nullptr), nullptr);
+  EXPECT_EQ(RFC7748_PoolCreate(RFC7748_POOL_X25519, &config), nullptr);
+  config.random = random_bytes;
+  EXPECT_EQ(RFC7748_PoolCreate(static_cast<Rfc7748PoolCurve>(2), &config),
+            nullptr);
+  config.capacity = 64;
+  config.high_watermark = 65;
+  EXPECT_EQ(RFC7748_PoolCreate(RFC7748_POOL_X25519, &config), nullptr);
+  config.high_watermark = 16;
+  config.low_watermark = 17;
+  EXPECT_EQ(RFC7748_PoolCreate(RFC7748_POOL_X25519, &config), nullptr);
+
+  /* The capacity is rounded up to a power of two */
+  config.capacity = 100;
+  config.high_watermark = 128;
+  config.low_watermark = 0;
+  Rfc7748KeyPool *pool = RFC7748_PoolCreate(RFC7748_POOL_X25519, &config);
+  ASSERT_NE(pool, nullptr);
+  wait_ready(pool, 128);
+  RFC7748_PoolDestroy(pool);
+
+  /* A batch larger than the high watermark is capped to it */
+  config.capacity = 64;
+  config.high_watermark = 0;
+  config.batch = ~0u;
+  pool = RFC7748_PoolCreate(RFC7748_POOL_X448, &config);
+  ASSERT_NE(pool, nullptr);
+  wait_ready(pool, 64);
+  RFC7748_PoolDestroy(pool);
+}
+
+/* Pops every pair of a full pool and then some more, checking each one */
+template <unsigned int size>
+static void pop_pairs(Rfc7748PoolCurve curve, KeyGen keygen) {
+  Rfc7748PoolConfig config = {};
+  config.capacity = 64;
+  config.low_watermark = 8;
+  config.batch = 16;
+  config.random = random_bytes;
+  Rfc7748KeyPool *pool = RFC7748_PoolCreate(curve, &config);
+  ASSERT_NE(pool, nullptr);
+  wait_ready(pool, 64);
+
+  Rfc7748PoolStats stats;
+  RFC7748_PoolGetStats(pool, &stats);
+  EXPECT_EQ(stats.ready, 64u);
+  EXPECT_EQ(stats.generated, 64u);
+  EXPECT_EQ(stats.pops, 0u);
+
+  std::set<std::string> seen;
+  unsigned int hits = 0;
+  for (int i = 0; i < 200; i++) {
+    uint8_t public_key[size], private_key[size], want[size];
+    hits += RFC7748_PoolPop(pool, public_key, private_key) == 0;
+    keygen(want, private_key);
+    ASSERT_EQ(memcmp(public_key, want, size), 0) << "pop: " << i;
+    ASSERT_TRUE(
+        seen.insert(std::string(private_key, private_key + size)).second)
+        << "pop: " << i;
+  }
+  EXPECT_GE(hits, 64u);
+
+  /* Dropping below the low watermark wakes up the background thread */
+  unsigned int pops = 200;
+  for (RFC7748_PoolGetStats(pool, &stats); stats.ready >= 8; pops++) {
+    uint8_t public_key[size], private_key[size];
+    hits += RFC7748_PoolPop(pool, public_key, private_key) == 0;
+    RFC7748_PoolGetStats(pool, &stats);
+  }
+  wait_ready(pool, 64);
+  RFC7748_PoolGetStats(pool, &stats);
+  EXPECT_EQ(stats.pops, pops);
+  EXPECT_EQ(stats.misses, pops - hits);
+  EXPECT_GE(stats.refills, 1u);
+  EXPECT_EQ(stats.generated, hits + 64u);
+  RFC7748_PoolDestroy(pool);
+}
+
+TEST(KEYPOOL, X25519_POP) {
+  pop_pairs<X25519_KEYSIZE_BYTES>(RFC7748_POOL_X25519, X25519_KeyGen);
+}
+
+TEST(KEYPOOL, X448_POP) {
+  pop_pairs<X448_KEYSIZE_BYTES>(RFC7748_POOL_X448, X448_KeyGen);
+}
+
+/* Several threads pop at once; no pair may be handed out twice */
+TEST(KEYPOOL, CONCURRENT_POP) {
+  const unsigned int num_threads = 4, pops = 500;
+  Rfc7748PoolConfig config = {};
+  config.capacity = 256;
+  config.random = random_bytes;
+  Rfc7748KeyPool *pool = RFC7748_PoolCreate(RFC7748_POOL_X25519, &config);
+  ASSERT_NE(pool, nullptr);
+
+  std::vector<std::vector<uint8_t>> keys(num_threads);
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      keys[t].resize(2 * pops * X25519_KEYSIZE_BYTES);
+      for (unsigned int i = 0; i < pops; i++) {
+        uint8_t *pair = &keys[t][2 * i * X25519_KEYSIZE_BYTES];
+        RFC7748_PoolPop(pool, pair, pair + X25519_KEYSIZE_BYTES);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  std::set<std::string> seen;
+  for (unsigned int t = 0; t < num_threads; t++) {
+    for (unsigned int i = 0; i < pops; i++) {
+      const uint8_t *pair = &keys[t][2 * i * X25519_KEYSIZE_BYTES];
+      X25519_KEY want;
+      X25519_KeyGen(want, const_cast<uint8_t *>(pair) + X25519_KEYSIZE_BYTES);
+      ASSERT_EQ(memcmp(pair, want, X25519_KEYSIZE_BYTES), 0);
+      ASSERT_TRUE(seen.insert(std::string(pair + X25519_KEYSIZE_BYTES,
+                                          pair + 2 * X25519_KEYSIZE_BYTES))
+                      .second);
+    }
+  }
+
+  Rfc7748PoolStats stats;
+  RFC7748_PoolGetStats(pool, &stats);
+  EXPECT_EQ(stats.pops, num_threads * pops);
+  EXPECT_LE(stats.pops - stats.misses, stats.generated);
+  RFC7748_PoolDestroy(pool);
+}
@@ -37,6 +37,7 @@
 #include <iomanip>
 #include <iostream>
 #include <rfc7748_precomputed.h>
+#include <vector>
 
 static std::ostream &operator<<(std::ostream &os, const X25519_KEY &key) {
   int i = 0;
@@ -210,6 +211,255 @@ TEST(X25519, IETF_CFRG1_1) {
       << "got:  " << k << "want: " << k_1000_times;
 }
 
+/* Runs every variant supported by the processor, then restores the default */
+TEST(X25519, IMPLEMENTATIONS) {
+  const Rfc7748Impl impls[] = {RFC7748_IMPL_MULQ, RFC7748_IMPL_BMI2,
+                               RFC7748_IMPL_ADX};
+  X25519_KEY k_1000_times = {0x68, 0x4c, 0xf5, 0x9b, 0xa8, 0x33, 0x09, 0x55,
+                             0x28, 0x00, 0xef, 0x56, 0x6f, 0x2f, 0x4d, 0x3c,
+                             0x1c, 0x38, 0x87, 0xc4, 0x93, 0x60, 0xe3, 0x87,
+                             0x5f, 0x2e, 0xb9, 0x4d, 0x99, 0x53, 0x2c, 0x51};
+
+  for (Rfc7748Impl impl : impls) {
+    if (!RFC7748_HasImpl(impl)) {
+      EXPECT_EQ(RFC7748_SetImpl(impl), -1);
+      continue;
+    }
+    ASSERT_EQ(RFC7748_SetImpl(impl), 0);
+    ASSERT_EQ(RFC7748_GetImpl(), impl);
+
+    X25519_KEY k;
+    times(1000, k);
+    EXPECT_EQ(memcmp(k, k_1000_times, X25519_KEYSIZE_BYTES), 0)
+        << "impl: " << impl << std::endl
+        << "got:  " << k << "want: " << k_1000_times;
+
+    for (int i = 0; i < 1000; i++) {
+      X25519_KEY secret, session, shared, base = {9};
+      random_X25519_key(secret);
+      X25519_KeyGen(session, secret);
+      X25519_Shared(shared, base, secret);
+      ASSERT_EQ(memcmp(session, shared, X25519_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << std::endl
+          << "got:  " << session << "want: " << shared;
+    }
+
+    /* The 4-way functions end with the inversion of this variant */
+    uint8_t secrets[4][X25519_KEYSIZE_BYTES], sessions[4][X25519_KEYSIZE_BYTES];
+    uint8_t shareds[4][X25519_KEYSIZE_BYTES];
+    X25519_KEY base = {9};
+    argKey secret[4], session[4], shared[4], bases[4];
+    for (int j = 0; j < 4; j++) {
+      random_X25519_key(secrets[j]);
+      secret[j] = secrets[j];
+      session[j] = sessions[j];
+      shared[j] = shareds[j];
+      bases[j] = base;
+    }
+    X25519_KeyGen_4w(session, secret);
+    X25519_Shared_4w(shared, bases, secret);
+    for (int j = 0; j < 4; j++) {
+      X25519_KEY want;
+      X25519_KeyGen(want, secrets[j]);
+      EXPECT_EQ(memcmp(sessions[j], want, X25519_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << " lane: " << j;
+      EXPECT_EQ(memcmp(shareds[j], want, X25519_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << " lane: " << j;
+    }
+  }
+  EXPECT_EQ(RFC7748_SetImpl(RFC7748_IMPL_AUTO), 0);
+}
+
+TEST(X25519, INVERSION_SAFEGCD) {
+  X25519_KEY k_1000_times = {0x68, 0x4c, 0xf5, 0x9b, 0xa8, 0x33, 0x09, 0x55,
+                             0x28, 0x00, 0xef, 0x56, 0x6f, 0x2f, 0x4d, 0x3c,
+                             0x1c, 0x38, 0x87, 0xc4, 0x93, 0x60, 0xe3, 0x87,
+                             0x5f, 0x2e, 0xb9, 0x4d, 0x99, 0x53, 0x2c, 0x51};
+
+  const Rfc7748Inv inv = RFC7748_GetInv();
+  RFC7748_SetInv(RFC7748_INV_SAFEGCD);
+  ASSERT_EQ(RFC7748_GetInv(), RFC7748_INV_SAFEGCD);
+
+  X25519_KEY k;
+  times(1000, k);
+  EXPECT_EQ(memcmp(k, k_1000_times, X25519_KEYSIZE_BYTES), 0)
+      << "got:  " << k << "want: " << k_1000_times;
+
+  for (int i = 0; i < 1000; i++) {
+    X25519_KEY secret, session, shared, base = {9};
+    random_X25519_key(secret);
+    X25519_KeyGen(session, secret);
+    X25519_Shared(shared, base, secret);
+    ASSERT_EQ(memcmp(session, shared, X25519_KEYSIZE_BYTES), 0)
+        << "got:  " << session << "want: " << shared;
+  }
+  RFC7748_SetInv(inv);
+  EXPECT_EQ(RFC7748_GetInv(), inv);
+}
+
+/* Every KeyGen precomputation must agree with the Shared function */
+TEST(X25519, KEYGEN_TABLES) {
+  const Rfc7748Table tables[] = {RFC7748_TABLE_LADDER, RFC7748_TABLE_NONE,
+                                 RFC7748_TABLE_COMB};
+  const Rfc7748Table table = RFC7748_GetTable();
+  EXPECT_EQ(RFC7748_SetTable(static_cast<Rfc7748Table>(-1)), -1);
+  EXPECT_EQ(RFC7748_GetTable(), table);
+
+  for (int i = 0; i < 1000; i++) {
+    X25519_KEY secret, session, shared, base = {9};
+    random_X25519_key(secret);
+    X25519_Shared(shared, base, secret);
+    for (Rfc7748Table t : tables) {
+      ASSERT_EQ(RFC7748_SetTable(t), 0);
+      ASSERT_EQ(RFC7748_GetTable(), t);
+      X25519_KeyGen(session, secret);
+      ASSERT_EQ(memcmp(session, shared, X25519_KEYSIZE_BYTES), 0)
+          << "table: " << t << std::endl
+          << "got:  " << session << "want: " << shared;
+    }
+  }
+
+  const unsigned int n = 100;
+  std::vector<uint8_t> sk_bytes(n * X25519_KEYSIZE_BYTES);
+  std::vector<uint8_t> pk_bytes(n * X25519_KEYSIZE_BYTES);
+  std::vector<argKey> sk(n), pk(n);
+  random_bytes(sk_bytes.data(), sk_bytes.size());
+  for (unsigned int i = 0; i < n; i++) {
+    sk[i] = &sk_bytes[i * X25519_KEYSIZE_BYTES];
+    pk[i] = &pk_bytes[i * X25519_KEYSIZE_BYTES];
+  }
+  for (Rfc7748Table t : tables) {
+    ASSERT_EQ(RFC7748_SetTable(t), 0);
+    X25519_KeyGen_batch(pk.data(), sk.data(), n);
+    ASSERT_EQ(RFC7748_SetTable(RFC7748_TABLE_LADDER), 0);
+    for (unsigned int i = 0; i < n; i++) {
+      X25519_KEY want;
+      X25519_KeyGen(want, sk[i]);
+      ASSERT_EQ(memcmp(pk[i], want, X25519_KEYSIZE_BYTES), 0)
+          << "table: " << t << " key: " << i;
+    }
+  }
+
+  const void *memory = nullptr;
+  const size_t sizes[] = {252u * 32, 0, 32u * 8 * 96};
+  for (Rfc7748Table t : tables) {
+    ASSERT_EQ(RFC7748_SetTable(t), 0);
+    EXPECT_EQ(RFC7748_X25519_TableMemory(&memory), sizes[t]);
+    EXPECT_EQ(memory == nullptr, sizes[t] == 0) << "table: " << t;
+  }
+
+  EXPECT_EQ(RFC7748_SetTable(table), 0);
+}
+
+/* Public keys of Section 6.1 of RFC 7748 computed with the comb */
+TEST(X25519, KEYGEN_COMB_RFC7748) {
+  X25519_KEY alice_sk = {0x77, 0x07, 0x6d, 0x0a, 0x73, 0x18, 0xa5, 0x7d,
+                         0x3c, 0x16, 0xc1, 0x72, 0x51, 0xb2, 0x66, 0x45,
+                         0xdf, 0x4c, 0x2f, 0x87, 0xeb, 0xc0, 0x99, 0x2a,
+                         0xb1, 0x77, 0xfb, 0xa5, 0x1d, 0xb9, 0x2c, 0x2a};
+  X25519_KEY alice_pk = {0x85, 0x20, 0xf0, 0x09, 0x89, 0x30, 0xa7, 0x54,
+                         0x74, 0x8b, 0x7d, 0xdc, 0xb4, 0x3e, 0xf7, 0x5a,
+                         0x0d, 0xbf, 0x3a, 0x0d, 0x26, 0x38, 0x1a, 0xf4,
+                         0xeb, 0xa4, 0xa9, 0x8e, 0xaa, 0x9b, 0x4e, 0x6a};
+  X25519_KEY bob_sk = {0x5d, 0xab, 0x08, 0x7e, 0x62, 0x4a, 0x8a, 0x4b,
+                       0x79, 0xe1, 0x7f, 0x8b, 0x83, 0x80, 0x0e, 0xe6,
+                       0x6f, 0x3b, 0xb1, 0x29, 0x26, 0x18, 0xb6, 0xfd,
+                       0x1c, 0x2f, 0x8b, 0x27, 0xff, 0x88, 0xe0, 0xeb};
+  X25519_KEY bob_pk = {0xde, 0x9e, 0xdb, 0x7d, 0x7b, 0x7d, 0xc1, 0xb4,
+                       0xd3, 0x5b, 0x61, 0xc2, 0xec, 0xe4, 0x35, 0x37,
+                       0x3f, 0x83, 0x43, 0xc8, 0x5b, 0x78, 0x67, 0x4d,
+                       0xad, 0xfc, 0x7e, 0x14, 0x6f, 0x88, 0x2b, 0x4f};
+  X25519_KEY pk;
+
+  const Rfc7748Table table = RFC7748_GetTable();
+  ASSERT_EQ(RFC7748_SetTable(RFC7748_TABLE_COMB), 0);
+  X25519_KeyGen(pk, alice_sk);
+  EXPECT_EQ(memcmp(pk, alice_pk, X25519_KEYSIZE_BYTES), 0)
+      << "got:  " << pk << "want: " << alice_pk;
+  X25519_KeyGen(pk, bob_sk);
+  EXPECT_EQ(memcmp(pk, bob_pk, X25519_KEYSIZE_BYTES), 0)
+      << "got:  " << pk << "want: " << bob_pk;
+  EXPECT_EQ(RFC7748_SetTable(table), 0);
+}
+
+TEST(X25519, SHARED_PEER) {
+  const Rfc7748Impl impls[] = {RFC7748_IMPL_MULQ, RFC7748_IMPL_BMI2,
+                               RFC7748_IMPL_ADX};
+  /* u = 0, 1, an order-8 point, p-1, p and p+1 */
+  const X25519_KEY small_order[] = {
+      {0x00},
+      {0x01},
+      {0xe0, 0xeb, 0x7a, 0x7c, 0x3b, 0x41, 0xb8, 0xae, 0x16, 0x56, 0xe3,
+       0xfa, 0xf1, 0x9f, 0xc4, 0x6a, 0xda, 0x09, 0x8d, 0xeb, 0x9c, 0x32,
+       0xb1, 0xfd, 0x86, 0x62, 0x05, 0x16, 0x5f, 0x49, 0xb8, 0x00},
+      {0xec, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f},
+      {0xed, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f},
+      {0xee, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f}};
+  X25519_PEER_TABLE table;
+  X25519_KEY secret, peer, got, want, base = {9};
+
+  for (Rfc7748Impl impl : impls) {
+    if (RFC7748_SetImpl(impl) != 0) {
+      continue;
+    }
+    /* The table of the base point gives the public key */
+    X25519_Precompute(table, base);
+    ASSERT_NE(table[X25519_PEER_TABLE_WORDS - 4], 0u);
+    for (int i = 0; i < 100; i++) {
+      random_X25519_key(secret);
+      X25519_Shared_peer(got, table, secret);
+      X25519_KeyGen(want, secret);
+      ASSERT_EQ(memcmp(got, want, X25519_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << std::endl
+          << "got:  " << got << "want: " << want;
+    }
+    /* Public keys of order l use the table */
+    for (int i = 0; i < 20; i++) {
+      random_X25519_key(secret);
+      X25519_KeyGen(peer, secret);
+      X25519_Precompute(table, peer);
+      ASSERT_NE(table[X25519_PEER_TABLE_WORDS - 4], 0u) << "peer: " << peer;
+      for (int j = 0; j < 20; j++) {
+        random_X25519_key(secret);
+        X25519_Shared_peer(got, table, secret);
+        X25519_Shared(want, peer, secret);
+        ASSERT_EQ(memcmp(got, want, X25519_KEYSIZE_BYTES), 0)
+            << "impl: " << impl << std::endl
+            << "peer: " << peer << "got:  " << got << "want: " << want;
+      }
+    }
+    /* Any other string, which is almost never of order l, falls back */
+    for (int i = 0; i < 100; i++) {
+      random_X25519_key(peer);
+      random_X25519_key(secret);
+      X25519_Precompute(table, peer);
+      X25519_Shared_peer(got, table, secret);
+      X25519_Shared(want, peer, secret);
+      ASSERT_EQ(memcmp(got, want, X25519_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << std::endl
+          << "peer: " << peer << "got:  " << got << "want: " << want;
+    }
+    for (const uint8_t *u : small_order) {
+      memcpy(peer, u, X25519_KEYSIZE_BYTES);
+      random_X25519_key(secret);
+      X25519_Precompute(table, peer);
+      EXPECT_EQ(table[X25519_PEER_TABLE_WORDS - 4], 0u) << "peer: " << peer;
+      X25519_Shared_peer(got, table, secret);
+      X25519_Shared(want, peer, secret);
+      ASSERT_EQ(memcmp(got, want, X25519_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << std::endl
+          << "peer: " << peer << "got:  " << got << "want: " << want;
+    }
+  }
+  EXPECT_EQ(RFC7748_SetImpl(RFC7748_IMPL_AUTO), 0);
+}
+
 TEST(X25519, DISABLED_IETF_CFRG1_2) {
   X25519_KEY k;
   X25519_KEY k_1000000_times = {0x7c, 0x39, 0x11, 0xe0, 0xab, 0x25, 0x86, 0xfd,
@@ -245,3 +495,130 @@ TEST(X25519, DIFFIE_HELLMAN) {
   }
   EXPECT_EQ(cnt, TIMES) << "passed: " << cnt << "/" << TIMES << std::endl;
 }
+
+TEST(X25519, KEYGEN_BATCH) {
+  const unsigned int sizes[] = {1, 2, 3, 63, 64, 65, 200};
+  int64_t cnt = 0;
+
+  for (unsigned int n : sizes) {
+    std::vector<uint8_t> secret(n * X25519_KEYSIZE_BYTES);
+    std::vector<uint8_t> batch(n * X25519_KEYSIZE_BYTES);
+    std::vector<argKey> sk(n), pk(n);
+    random_bytes(secret.data(), n * X25519_KEYSIZE_BYTES);
+    for (unsigned int i = 0; i < n; i++) {
+      sk[i] = &secret[i * X25519_KEYSIZE_BYTES];
+      pk[i] = &batch[i * X25519_KEYSIZE_BYTES];
+    }
+
+    X25519_KeyGen_batch(pk.data(), sk.data(), n);
+
+    for (unsigned int i = 0; i < n; i++) {
+      X25519_KEY want;
+      X25519_KeyGen(want, sk[i]);
+      ASSERT_EQ(memcmp(pk[i], want, X25519_KEYSIZE_BYTES), 0)
+          << "batch size: " << n << " index: " << i << std::endl
+          << "want: " << want;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, 7) << "passed: " << cnt << "/" << 7 << std::endl;
+}
+
+TEST(X25519, SHARED_BATCH) {
+  const unsigned int sizes[] = {1, 2, 3, 63, 64, 65, 200};
+  int64_t cnt = 0;
+
+  for (unsigned int n : sizes) {
+    std::vector<uint8_t> secret(n * X25519_KEYSIZE_BYTES);
+    std::vector<uint8_t> session(n * X25519_KEYSIZE_BYTES);
+    std::vector<uint8_t> batch(n * X25519_KEYSIZE_BYTES);
+    std::vector<argKey> sk(n), pk(n), ss(n);
+    random_bytes(secret.data(), n * X25519_KEYSIZE_BYTES);
+    random_bytes(session.data(), n * X25519_KEYSIZE_BYTES);
+    for (unsigned int i = 0; i < n; i++) {
+      sk[i] = &secret[i * X25519_KEYSIZE_BYTES];
+      pk[i] = &session[i * X25519_KEYSIZE_BYTES];
+      ss[i] = &batch[i * X25519_KEYSIZE_BYTES];
+    }
+    /* Points of small order (u=0 and u=1) yield an all-zero secret */
+    memset(pk[n / 2], 0, X25519_KEYSIZE_BYTES);
+    memset(pk[n - 1], 0, X25519_KEYSIZE_BYTES);
+    pk[n - 1][0] = 1;
+
+    X25519_Shared_batch(ss.data(), pk.data(), sk.data(), n);
+
+    for (unsigned int i = 0; i < n; i++) {
+      X25519_KEY want;
+      X25519_Shared(want, pk[i], sk[i]);
+      ASSERT_EQ(memcmp(ss[i], want, X25519_KEYSIZE_BYTES), 0)
+          << "batch size: " << n << " index: " << i << std::endl
+          << "want: " << want;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, 7) << "passed: " << cnt << "/" << 7 << std::endl;
+}
+
+TEST(X25519, KEYGEN_4W) {
+  const int64_t num_tests = 1000;
+  int64_t cnt = 0;
+  X25519_KEY secret[4], session[4];
+  argKey sk[4], pk[4];
+
+  for (int i = 0; i < num_tests; i++) {
+    for (int j = 0; j < 4; j++) {
+      random_X25519_key(secret[j]);
+      sk[j] = secret[j];
+      pk[j] = session[j];
+    }
+
+    X25519_KeyGen_4w(pk, sk);
+
+    for (int j = 0; j < 4; j++) {
+      X25519_KEY want;
+      X25519_KeyGen(want, sk[j]);
+      ASSERT_EQ(memcmp(pk[j], want, X25519_KEYSIZE_BYTES), 0)
+          << "lane: " << j << std::endl
+          << "want: " << want;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, num_tests) << "passed: " << cnt << "/" << num_tests
+                            << std::endl;
+}
+
+TEST(X25519, SHARED_4W) {
+  const int64_t num_tests = 1000;
+  int64_t cnt = 0;
+  X25519_KEY secret[4], session[4], shared[4];
+  argKey sk[4], pk[4], ss[4];
+
+  for (int i = 0; i < num_tests; i++) {
+    for (int j = 0; j < 4; j++) {
+      random_X25519_key(secret[j]);
+      random_X25519_key(session[j]);
+      sk[j] = secret[j];
+      pk[j] = session[j];
+      ss[j] = shared[j];
+    }
+    /* Points of small order (u=0 and u=1) in some lanes */
+    if (i == 0) {
+      memset(session[1], 0, X25519_KEYSIZE_BYTES);
+      memset(session[3], 0, X25519_KEYSIZE_BYTES);
+      session[3][0] = 1;
+    }
+
+    X25519_Shared_4w(ss, pk, sk);
+
+    for (int j = 0; j < 4; j++) {
+      X25519_KEY want;
+      X25519_Shared(want, pk[j], sk[j]);
+      ASSERT_EQ(memcmp(ss[j], want, X25519_KEYSIZE_BYTES), 0)
+          << "lane: " << j << std::endl
+          << "want: " << want;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, num_tests) << "passed: " << cnt << "/" << num_tests
+                             << std::endl;
+}
@@ -37,6 +37,7 @@
 #include <iomanip>
 #include <iostream>
 #include <rfc7748_precomputed.h>
+#include <vector>
 
 static std::ostream &operator<<(std::ostream &os, const X448_KEY &key) {
   int i = 0;
@@ -204,6 +205,283 @@ TEST(X448, IETF_CFRG1_1) {
       << "got:  " << k << "want: " << k_1000_times;
 }
 
+/* Runs every variant supported by the processor, then restores the default */
+TEST(X448, IMPLEMENTATIONS) {
+  const Rfc7748Impl impls[] = {RFC7748_IMPL_MULQ, RFC7748_IMPL_BMI2,
+                               RFC7748_IMPL_ADX};
+  X448_KEY k_1000_times = {
+      0xaa, 0x3b, 0x47, 0x49, 0xd5, 0x5b, 0x9d, 0xaf, 0x1e, 0x5b, 0x00, 0x28,
+      0x88, 0x26, 0xc4, 0x67, 0x27, 0x4c, 0xe3, 0xeb, 0xbd, 0xd5, 0xc1, 0x7b,
+      0x97, 0x5e, 0x09, 0xd4, 0xaf, 0x6c, 0x67, 0xcf, 0x10, 0xd0, 0x87, 0x20,
+      0x2d, 0xb8, 0x82, 0x86, 0xe2, 0xb7, 0x9f, 0xce, 0xea, 0x3e, 0xc3, 0x53,
+      0xef, 0x54, 0xfa, 0xa2, 0x6e, 0x21, 0x9f, 0x38};
+
+  for (Rfc7748Impl impl : impls) {
+    if (!RFC7748_HasImpl(impl)) {
+      EXPECT_EQ(RFC7748_SetImpl(impl), -1);
+      continue;
+    }
+    ASSERT_EQ(RFC7748_SetImpl(impl), 0);
+    ASSERT_EQ(RFC7748_GetImpl(), impl);
+
+    X448_KEY k;
+    times(1000, k);
+    EXPECT_EQ(memcmp(k, k_1000_times, X448_KEYSIZE_BYTES), 0)
+        << "impl: " << impl << std::endl
+        << "got:  " << k << "want: " << k_1000_times;
+
+    for (int i = 0; i < 1000; i++) {
+      X448_KEY secret, session, shared, base = {5};
+      random_X448_key(secret);
+      X448_KeyGen(session, secret);
+      X448_Shared(shared, base, secret);
+      ASSERT_EQ(memcmp(session, shared, X448_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << std::endl
+          << "got:  " << session << "want: " << shared;
+    }
+
+    /* The 4-way functions end with the inversion of this variant */
+    uint8_t secrets[4][X448_KEYSIZE_BYTES], sessions[4][X448_KEYSIZE_BYTES];
+    uint8_t shareds[4][X448_KEYSIZE_BYTES];
+    X448_KEY base = {5};
+    argKey secret[4], session[4], shared[4], bases[4];
+    for (int j = 0; j < 4; j++) {
+      random_X448_key(secrets[j]);
+      secret[j] = secrets[j];
+      session[j] = sessions[j];
+      shared[j] = shareds[j];
+      bases[j] = base;
+    }
+    X448_KeyGen_4w(session, secret);
+    X448_Shared_4w(shared, bases, secret);
+    for (int j = 0; j < 4; j++) {
+      X448_KEY want;
+      X448_KeyGen(want, secrets[j]);
+      EXPECT_EQ(memcmp(sessions[j], want, X448_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << " lane: " << j;
+      EXPECT_EQ(memcmp(shareds[j], want, X448_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << " lane: " << j;
+    }
+  }
+  EXPECT_EQ(RFC7748_SetImpl(RFC7748_IMPL_AUTO), 0);
+}
+
+TEST(X448, INVERSION_SAFEGCD) {
+  X448_KEY k_1000_times = {
+      0xaa, 0x3b, 0x47, 0x49, 0xd5, 0x5b, 0x9d, 0xaf, 0x1e, 0x5b, 0x00, 0x28,
+      0x88, 0x26, 0xc4, 0x67, 0x27, 0x4c, 0xe3, 0xeb, 0xbd, 0xd5, 0xc1, 0x7b,
+      0x97, 0x5e, 0x09, 0xd4, 0xaf, 0x6c, 0x67, 0xcf, 0x10, 0xd0, 0x87, 0x20,
+      0x2d, 0xb8, 0x82, 0x86, 0xe2, 0xb7, 0x9f, 0xce, 0xea, 0x3e, 0xc3, 0x53,
+      0xef, 0x54, 0xfa, 0xa2, 0x6e, 0x21, 0x9f, 0x38};
+
+  const Rfc7748Inv inv = RFC7748_GetInv();
+  RFC7748_SetInv(RFC7748_INV_SAFEGCD);
+  ASSERT_EQ(RFC7748_GetInv(), RFC7748_INV_SAFEGCD);
+
+  X448_KEY k;
+  times(1000, k);
+  EXPECT_EQ(memcmp(k, k_1000_times, X448_KEYSIZE_BYTES), 0)
+      << "got:  " << k << "want: " << k_1000_times;
+
+  for (int i = 0; i < 1000; i++) {
+    X448_KEY secret, session, shared, base = {5};
+    random_X448_key(secret);
+    X448_KeyGen(session, secret);
+    X448_Shared(shared, base, secret);
+    ASSERT_EQ(memcmp(session, shared, X448_KEYSIZE_BYTES), 0)
+        << "got:  " << session << "want: " << shared;
+  }
+  RFC7748_SetInv(inv);
+  EXPECT_EQ(RFC7748_GetInv(), inv);
+}
+
+/* Both KeyGen precomputations must agree with the Shared function */
+TEST(X448, KEYGEN_TABLES) {
+  const Rfc7748Table tables[] = {RFC7748_TABLE_LADDER, RFC7748_TABLE_NONE,
+                                 RFC7748_TABLE_COMB};
+  const Rfc7748Table table = RFC7748_GetTable();
+  EXPECT_EQ(RFC7748_SetTable(static_cast<Rfc7748Table>(-1)), -1);
+  EXPECT_EQ(RFC7748_GetTable(), table);
+
+  for (int i = 0; i < 1000; i++) {
+    X448_KEY secret, session, shared, base = {5};
+    random_X448_key(secret);
+    X448_Shared(shared, base, secret);
+    for (Rfc7748Table t : tables) {
+      ASSERT_EQ(RFC7748_SetTable(t), 0);
+      ASSERT_EQ(RFC7748_GetTable(), t);
+      X448_KeyGen(session, secret);
+      ASSERT_EQ(memcmp(session, shared, X448_KEYSIZE_BYTES), 0)
+          << "table: " << t << std::endl
+          << "got:  " << session << "want: " << shared;
+    }
+  }
+
+  const unsigned int n = 100;
+  std::vector<uint8_t> sk_bytes(n * X448_KEYSIZE_BYTES);
+  std::vector<uint8_t> pk_bytes(n * X448_KEYSIZE_BYTES);
+  std::vector<argKey> sk(n), pk(n);
+  random_bytes(sk_bytes.data(), sk_bytes.size());
+  for (unsigned int i = 0; i < n; i++) {
+    sk[i] = &sk_bytes[i * X448_KEYSIZE_BYTES];
+    pk[i] = &pk_bytes[i * X448_KEYSIZE_BYTES];
+  }
+  for (Rfc7748Table t : tables) {
+    ASSERT_EQ(RFC7748_SetTable(t), 0);
+    X448_KeyGen_batch(pk.data(), sk.data(), n);
+    ASSERT_EQ(RFC7748_SetTable(RFC7748_TABLE_LADDER), 0);
+    for (unsigned int i = 0; i < n; i++) {
+      X448_KEY want;
+      X448_KeyGen(want, sk[i]);
+      ASSERT_EQ(memcmp(pk[i], want, X448_KEYSIZE_BYTES), 0)
+          << "table: " << t << " key: " << i;
+    }
+  }
+
+  const void *memory = nullptr;
+  const size_t sizes[] = {446u * 56, 0, 14u * 8 * 168};
+  for (Rfc7748Table t : tables) {
+    ASSERT_EQ(RFC7748_SetTable(t), 0);
+    EXPECT_EQ(RFC7748_X448_TableMemory(&memory), sizes[t]);
+    EXPECT_EQ(memory == nullptr, sizes[t] == 0) << "table: " << t;
+  }
+
+  EXPECT_EQ(RFC7748_SetTable(table), 0);
+}
+
+/**
+ * Public keys of Section 6.2 of RFC 7748 computed with the comb, and the
+ * clamped key 4*l, where l is the order of the base point, for which the
+ * comb ends at the neutral point of Ed448.
+ */
+TEST(X448, KEYGEN_COMB_RFC7748) {
+  X448_KEY alice_sk = {
+      0x9a, 0x8f, 0x49, 0x25, 0xd1, 0x51, 0x9f, 0x57, 0x75, 0xcf, 0x46, 0xb0,
+      0x4b, 0x58, 0x00, 0xd4, 0xee, 0x9e, 0xe8, 0xba, 0xe8, 0xbc, 0x55, 0x65,
+      0xd4, 0x98, 0xc2, 0x8d, 0xd9, 0xc9, 0xba, 0xf5, 0x74, 0xa9, 0x41, 0x97,
+      0x44, 0x89, 0x73, 0x91, 0x00, 0x63, 0x82, 0xa6, 0xf1, 0x27, 0xab, 0x1d,
+      0x9a, 0xc2, 0xd8, 0xc0, 0xa5, 0x98, 0x72, 0x6b};
+  X448_KEY alice_pk = {
+      0x9b, 0x08, 0xf7, 0xcc, 0x31, 0xb7, 0xe3, 0xe6, 0x7d, 0x22, 0xd5, 0xae,
+      0xa1, 0x21, 0x07, 0x4a, 0x27, 0x3b, 0xd2, 0xb8, 0x3d, 0xe0, 0x9c, 0x63,
+      0xfa, 0xa7, 0x3d, 0x2c, 0x22, 0xc5, 0xd9, 0xbb, 0xc8, 0x36, 0x64, 0x72,
+      0x41, 0xd9, 0x53, 0xd4, 0x0c, 0x5b, 0x12, 0xda, 0x88, 0x12, 0x0d, 0x53,
+      0x17, 0x7f, 0x80, 0xe5, 0x32, 0xc4, 0x1f, 0xa0};
+  X448_KEY bob_sk = {
+      0x1c, 0x30, 0x6a, 0x7a, 0xc2, 0xa0, 0xe2, 0xe0, 0x99, 0x0b, 0x29, 0x44,
+      0x70, 0xcb, 0xa3, 0x39, 0xe6, 0x45, 0x37, 0x72, 0xb0, 0x75, 0x81, 0x1d,
+      0x8f, 0xad, 0x0d, 0x1d, 0x69, 0x27, 0xc1, 0x20, 0xbb, 0x5e, 0xe8, 0x97,
+      0x2b, 0x0d, 0x3e, 0x21, 0x37, 0x4c, 0x9c, 0x92, 0x1b, 0x09, 0xd1, 0xb0,
+      0x36, 0x6f, 0x10, 0xb6, 0x51, 0x73, 0x99, 0x2d};
+  X448_KEY bob_pk = {
+      0x3e, 0xb7, 0xa8, 0x29, 0xb0, 0xcd, 0x20, 0xf5, 0xbc, 0xfc, 0x0b, 0x59,
+      0x9b, 0x6f, 0xec, 0xcf, 0x6d, 0xa4, 0x62, 0x71, 0x07, 0xbd, 0xb0, 0xd4,
+      0xf3, 0x45, 0xb4, 0x30, 0x27, 0xd8, 0xb9, 0x72, 0xfc, 0x3e, 0x34, 0xfb,
+      0x42, 0x32, 0xa1, 0x3c, 0xa7, 0x06, 0xdc, 0xb5, 0x7a, 0xec, 0x3d, 0xae,
+      0x07, 0xbd, 0xc1, 0xc6, 0x7b, 0xf3, 0x36, 0x09};
+  X448_KEY order_sk = {
+      0xcc, 0x13, 0x61, 0xad, 0x4a, 0x0a, 0xe3, 0x8d, 0x54, 0x3d, 0x16, 0x37,
+      0xca, 0x09, 0xb3, 0x85, 0x40, 0xda, 0x58, 0xbb, 0x26, 0x6d, 0x3b, 0x11,
+      0xa7, 0x8f, 0x28, 0xf3, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+  X448_KEY order_pk = {0}, pk;
+
+  const Rfc7748Table table = RFC7748_GetTable();
+  ASSERT_EQ(RFC7748_SetTable(RFC7748_TABLE_COMB), 0);
+  X448_KeyGen(pk, alice_sk);
+  EXPECT_EQ(memcmp(pk, alice_pk, X448_KEYSIZE_BYTES), 0)
+      << "got:  " << pk << "want: " << alice_pk;
+  X448_KeyGen(pk, bob_sk);
+  EXPECT_EQ(memcmp(pk, bob_pk, X448_KEYSIZE_BYTES), 0)
+      << "got:  " << pk << "want: " << bob_pk;
+  X448_KeyGen(pk, order_sk);
+  EXPECT_EQ(memcmp(pk, order_pk, X448_KEYSIZE_BYTES), 0)
+      << "got:  " << pk << "want: " << order_pk;
+  EXPECT_EQ(RFC7748_SetTable(table), 0);
+}
+
+TEST(X448, SHARED_PEER) {
+  const Rfc7748Impl impls[] = {RFC7748_IMPL_MULQ, RFC7748_IMPL_BMI2,
+                               RFC7748_IMPL_ADX};
+  /* u = 0, 1, p-1, p and p+1 */
+  const uint8_t small_order[][X448_KEYSIZE_BYTES] = {
+      {0x00},
+      {0x01},
+      {0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+      {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+      {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+       0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}};
+  X448_PEER_TABLE table;
+  X448_KEY secret, peer, got, want, base = {5};
+
+  for (Rfc7748Impl impl : impls) {
+    if (RFC7748_SetImpl(impl) != 0) {
+      continue;
+    }
+    /* The table of the base point gives the public key */
+    X448_Precompute(table, base);
+    ASSERT_NE(table[X448_PEER_TABLE_WORDS - 7], 0u);
+    for (int i = 0; i < 100; i++) {
+      random_X448_key(secret);
+      X448_Shared_peer(got, table, secret);
+      X448_KeyGen(want, secret);
+      ASSERT_EQ(memcmp(got, want, X448_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << std::endl
+          << "got:  " << got << "want: " << want;
+    }
+    /* Public keys of order l use the table */
+    for (int i = 0; i < 20; i++) {
+      random_X448_key(secret);
+      X448_KeyGen(peer, secret);
+      X448_Precompute(table, peer);
+      ASSERT_NE(table[X448_PEER_TABLE_WORDS - 7], 0u) << "peer: " << peer;
+      for (int j = 0; j < 20; j++) {
+        random_X448_key(secret);
+        X448_Shared_peer(got, table, secret);
+        X448_Shared(want, peer, secret);
+        ASSERT_EQ(memcmp(got, want, X448_KEYSIZE_BYTES), 0)
+            << "impl: " << impl << std::endl
+            << "peer: " << peer << "got:  " << got << "want: " << want;
+      }
+    }
+    /* Any other string, which is almost never of order l, falls back */
+    for (int i = 0; i < 100; i++) {
+      random_X448_key(peer);
+      random_X448_key(secret);
+      X448_Precompute(table, peer);
+      X448_Shared_peer(got, table, secret);
+      X448_Shared(want, peer, secret);
+      ASSERT_EQ(memcmp(got, want, X448_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << std::endl
+          << "peer: " << peer << "got:  " << got << "want: " << want;
+    }
+    for (const uint8_t *u : small_order) {
+      memcpy(peer, u, X448_KEYSIZE_BYTES);
+      random_X448_key(secret);
+      X448_Precompute(table, peer);
+      EXPECT_EQ(table[X448_PEER_TABLE_WORDS - 7], 0u) << "peer: " << peer;
+      X448_Shared_peer(got, table, secret);
+      X448_Shared(want, peer, secret);
+      ASSERT_EQ(memcmp(got, want, X448_KEYSIZE_BYTES), 0)
+          << "impl: " << impl << std::endl
+          << "peer: " << peer << "got:  " << got << "want: " << want;
+    }
+  }
+  EXPECT_EQ(RFC7748_SetImpl(RFC7748_IMPL_AUTO), 0);
+}
+
 TEST(X448, DISABLED_IETF_CFRG1_2) {
   X448_KEY k;
   X448_KEY k_1000000_times = {
@@ -241,3 +519,133 @@ TEST(X448, DIFFIE_HELLMAN) {
   }
   EXPECT_EQ(cnt, TIMES) << "passed: " << cnt << "/" << TIMES << std::endl;
 }
+
+TEST(X448, KEYGEN_BATCH) {
+  const unsigned int sizes[] = {1, 2, 3, 63, 64, 65, 200};
+  int64_t cnt = 0;
+
+  for (unsigned int n : sizes) {
+    std::vector<uint8_t> secret(n * X448_KEYSIZE_BYTES);
+    std::vector<uint8_t> batch(n * X448_KEYSIZE_BYTES);
+    std::vector<argKey> sk(n), pk(n);
+    random_bytes(secret.data(), n * X448_KEYSIZE_BYTES);
+    for (unsigned int i = 0; i < n; i++) {
+      sk[i] = &secret[i * X448_KEYSIZE_BYTES];
+      pk[i] = &batch[i * X448_KEYSIZE_BYTES];
+    }
+
+    X448_KeyGen_batch(pk.data(), sk.data(), n);
+
+    for (unsigned int i = 0; i < n; i++) {
+      X448_KEY want;
+      X448_KeyGen(want, sk[i]);
+      ASSERT_EQ(memcmp(pk[i], want, X448_KEYSIZE_BYTES), 0)
+          << "batch size: " << n << " index: " << i << std::endl
+          << "want: " << want;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, 7) << "passed: " << cnt << "/" << 7 << std::endl;
+}
+
+TEST(X448, SHARED_BATCH) {
+  const unsigned int sizes[] = {1, 2, 3, 63, 64, 65, 200};
+  int64_t cnt = 0;
+
+  for (unsigned int n : sizes) {
+    std::vector<uint8_t> secret(n * X448_KEYSIZE_BYTES);
+    std::vector<uint8_t> session(n * X448_KEYSIZE_BYTES);
+    std::vector<uint8_t> batch(n * X448_KEYSIZE_BYTES);
+    std::vector<argKey> sk(n), pk(n), ss(n);
+    random_bytes(secret.data(), n * X448_KEYSIZE_BYTES);
+    random_bytes(session.data(), n * X448_KEYSIZE_BYTES);
+    for (unsigned int i = 0; i < n; i++) {
+      sk[i] = &secret[i * X448_KEYSIZE_BYTES];
+      pk[i] = &session[i * X448_KEYSIZE_BYTES];
+      ss[i] = &batch[i * X448_KEYSIZE_BYTES];
+    }
+    /* Points of small order (u=0 and u=1) yield an all-zero secret */
+    memset(pk[n / 2], 0, X448_KEYSIZE_BYTES);
+    memset(pk[n - 1], 0, X448_KEYSIZE_BYTES);
+    pk[n - 1][0] = 1;
+
+    X448_Shared_batch(ss.data(), pk.data(), sk.data(), n);
+
+    for (unsigned int i = 0; i < n; i++) {
+      X448_KEY want;
+      X448_Shared(want, pk[i], sk[i]);
+      ASSERT_EQ(memcmp(ss[i], want, X448_KEYSIZE_BYTES), 0)
+          << "batch size: " << n << " index: " << i << std::endl
+          << "want: " << want;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, 7) << "passed: " << cnt << "/" << 7 << std::endl;
+}
+
+TEST(X448, KEYGEN_4W) {
+  const int64_t num_tests = 1000;
+  int64_t cnt = 0;
+  uint8_t secret[4][X448_KEYSIZE_BYTES];
+  uint8_t session[4][X448_KEYSIZE_BYTES];
+  argKey sk[4], pk[4];
+
+  for (int i = 0; i < num_tests; i++) {
+    for (int j = 0; j < 4; j++) {
+      random_X448_key(secret[j]);
+      sk[j] = secret[j];
+      pk[j] = session[j];
+    }
+
+    X448_KeyGen_4w(pk, sk);
+
+    for (int j = 0; j < 4; j++) {
+      X448_KEY want;
+      X448_KeyGen(want, sk[j]);
+      ASSERT_EQ(memcmp(pk[j], want, X448_KEYSIZE_BYTES), 0)
+          << "lane: " << j << std::endl
+          << "want: " << want;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, num_tests) << "passed: " << cnt << "/" << num_tests
+                            << std::endl;
+}
+
+TEST(X448, SHARED_4W) {
+  const int64_t num_tests = 1000;
+  int64_t cnt = 0;
+  uint8_t secret[4][X448_KEYSIZE_BYTES];
+  uint8_t session[4][X448_KEYSIZE_BYTES];
+  uint8_t shared[4][X448_KEYSIZE_BYTES];
+  argKey sk[4], pk[4], ss[4];
+
+  for (int i = 0; i < num_tests; i++) {
+    for (int j = 0; j < 4; j++) {
+      random_X448_key(secret[j]);
+      random_X448_key(session[j]);
+      sk[j] = secret[j];
+      pk[j] = session[j];
+      ss[j] = shared[j];
+    }
+    /* Points of small order (u=0 and u=1) in some lanes */
+    if (i == 0) {
+      memset(session[1], 0, X448_KEYSIZE_BYTES);
+      memset(session[3], 0, X448_KEYSIZE_BYTES);
+      session[3][0] = 1;
+    }
+
+    X448_Shared_4w(ss, pk, sk);
+
+    for (int j = 0; j < 4; j++) {
+      X448_KEY want;
+      X448_Shared(want, pk[j], sk[j]);
+      ASSERT_EQ(memcmp(ss[j], want, X448_KEYSIZE_BYTES), 0)
+          << "lane: " << j << std::endl
+          << "want: " << want;
+    }
+    cnt++;
+  }
+  EXPECT_EQ(cnt, num_tests) << "passed: " << cnt << "/" << num_tests
+                             << std::endl;
+}
@@ -0,0 +1,347 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Generates the tables of the signed combs used by KeyGen with
+ * RFC7748_TABLE_COMB (include/table_comb_x25519.h and
+ * include/table_comb_x448.h).
+ *
+ * X25519: entry (i, j), for i = 0, ..., 31 and j = 1, ..., 8, holds
+ * j*256^i*B as (y-x, y+x, 2*d*x*y), where (x, y) are the affine coordinates
+ * on Ed25519 and B is its base point, which the map u = (1+y)/(1-y) sends
+ * to u = 9.
+ *
+ * X448: entry (i, j), for i = 0, ..., 13 and j = 1, ..., 8, holds
+ * j*2^(32*i)*4B as (x, y, d*x*y), where (x, y) are the affine coordinates
+ * on Ed448 and B is its base point, which the 4-isogeny u = y^2/x^2 sends
+ * to u = 5. The factor 4 absorbs the two bits cleared by the clamping.
+ *
+ * Usage: gen_table_comb x25519|x448 [output]
+ *   output header to write, or standard output if omitted or "-"
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fp25519_x64.h"
+#include "fp448_x64.h"
+
+#define COMB_TEETH_X25519 32
+#define COMB_TEETH_X448 14
+#define COMB_DIGITS 8
+
+static const char *const license[] = {
+    "/**",
+    " * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.",
+    " * Institute of Computing.",
+    " * University of Campinas, Brazil.",
+    " *",
+    " * Redistribution and use in source and binary forms, with or without",
+    " * modification, are permitted provided that the following conditions",
+    " * are met:",
+    " *",
+    " *  * Redistributions of source code must retain the above copyright",
+    " *    notice, this list of conditions and the following disclaimer.",
+    " *  * Redistributions in binary form must reproduce the above",
+    " *    copyright notice, this list of conditions and the following",
+    " *    disclaimer in the documentation and/or other materials provided",
+    " *    with the distribution.",
+    " *  * Neither the name of University of Campinas nor the names of its",
+    " *    contributors may be used to endorse or promote products derived",
+    " *    from this software without specific prior written permission.",
+    " *",
+    " * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS",
+    " * \"AS IS\" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT",
+    " * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS",
+    " * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE",
+    " * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,",
+    " * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES",
+    " * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR",
+    " * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)",
+    " * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,",
+    " * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)",
+    " * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED",
+    " * OF THE POSSIBILITY OF SUCH DAMAGE.",
+    " */",
+};
+
+/* d = -121665/121666 */
+static const EltFp25519_1w_x64 param_d_x25519 = {
+    0x75eb4dca135978a3, 0x00700a4d4141d8ab, 0x8cc740797779e898,
+    0x52036cee2b6ffe73};
+
+/* Base point of Ed25519 */
+static const EltFp25519_1w_x64 base_x_x25519 = {
+    0xc9562d608f25d51a, 0x692cc7609525a7b2, 0xc0a4e231fdd6dc5c,
+    0x216936d3cd6e53fe};
+static const EltFp25519_1w_x64 base_y_x25519 = {
+    0x6666666666666658, 0x6666666666666666, 0x6666666666666666,
+    0x6666666666666666};
+
+/* d = -39081 */
+static const EltFp448_1w_x64 param_d_x448 = {
+    0xffffffffffff6756, 0xffffffffffffffff, 0xffffffffffffffff,
+    0xfffffffeffffffff, 0xffffffffffffffff, 0xffffffffffffffff,
+    0xffffffffffffffff};
+
+/* Base point of Ed448 */
+static const EltFp448_1w_x64 base_x_x448 = {
+    0x2626a82bc70cc05e, 0x433b80e18b00938e, 0x12ae1af72ab66511,
+    0xea6de324a3d3a464, 0x9e146570470f1767, 0x221d15a622bf36da,
+    0x4f1970c66bed0ded};
+static const EltFp448_1w_x64 base_y_x448 = {
+    0x9808795bf230fa14, 0xfdbd132c4ed7c8ad, 0x3ad3ff1ce67c39c4,
+    0x87789c1e05a0c2d7, 0x4bea73736ca39840, 0x8876203756c9c762,
+    0x693f46716eb6bc24};
+
+static void mul_x25519(uint64_t *const c, uint64_t *const a,
+                       uint64_t *const b) {
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  mul_EltFp25519_1w_x64(c, a, b);
+}
+
+static void mul_x448(uint64_t *const c, uint64_t *const a,
+                     uint64_t *const b) {
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  mul_EltFp448_1w_x64(c, a, b);
+}
+
+/**
+ * Computes (x3, y3) = (x1, y1) + (x2, y2) on Ed25519 with the formulas
+ *   x3 = (x1*y2 + y1*x2) / (1 + d*x1*x2*y1*y2)
+ *   y3 = (y1*y2 + x1*x2) / (1 - d*x1*x2*y1*y2)
+ * The outputs are fully reduced and may overlap the inputs.
+ */
+static void add_point_x25519(uint64_t *const x3, uint64_t *const y3,
+                             uint64_t *const x1, uint64_t *const y1,
+                             uint64_t *const x2, uint64_t *const y2) {
+  EltFp25519_1w_x64 one = {1}, t0, t1, t2, t3, den;
+
+  mul_x25519(t0, x1, y2);
+  mul_x25519(t1, y1, x2);
+  add_EltFp25519_1w_x64(t0, t0, t1);   /* t0 = x1*y2 + y1*x2            */
+  mul_x25519(t1, y1, y2);
+  mul_x25519(t2, x1, x2);
+  add_EltFp25519_1w_x64(t1, t1, t2);   /* t1 = y1*y2 + x1*x2            */
+  mul_x25519(t2, t2, y1);
+  mul_x25519(t2, t2, y2);
+  mul_x25519(t2, t2, (uint64_t *)param_d_x25519); /* t2 = d*x1*x2*y1*y2 */
+  add_EltFp25519_1w_x64(t3, one, t2);
+  inv_EltFp25519_1w_x64(den, t3);
+  mul_x25519(x3, t0, den);
+  sub_EltFp25519_1w_x64(t3, one, t2);
+  inv_EltFp25519_1w_x64(den, t3);
+  mul_x25519(y3, t1, den);
+  fred_EltFp25519_1w_x64(x3);
+  fred_EltFp25519_1w_x64(y3);
+}
+
+/**
+ * Computes (x3, y3) = (x1, y1) + (x2, y2) on Ed448 with the formulas
+ *   x3 = (x1*y2 + y1*x2) / (1 + d*x1*x2*y1*y2)
+ *   y3 = (y1*y2 - x1*x2) / (1 - d*x1*x2*y1*y2)
+ * The outputs are fully reduced and may overlap the inputs.
+ */
+static void add_point_x448(uint64_t *const x3, uint64_t *const y3,
+                           uint64_t *const x1, uint64_t *const y1,
+                           uint64_t *const x2, uint64_t *const y2) {
+  EltFp448_1w_x64 one = {1}, t0, t1, t2, t3, den;
+
+  mul_x448(t0, x1, y2);
+  mul_x448(t1, y1, x2);
+  add_EltFp448_1w_x64(t0, t0, t1);     /* t0 = x1*y2 + y1*x2            */
+  mul_x448(t1, y1, y2);
+  mul_x448(t2, x1, x2);
+  sub_EltFp448_1w_x64(t1, t1, t2);     /* t1 = y1*y2 - x1*x2            */
+  mul_x448(t2, t2, y1);
+  mul_x448(t2, t2, y2);
+  mul_x448(t2, t2, (uint64_t *)param_d_x448); /* t2 = d*x1*x2*y1*y2     */
+  add_EltFp448_1w_x64(t3, one, t2);
+  inv_EltFp448_1w_x64(den, t3);
+  mul_x448(x3, t0, den);
+  sub_EltFp448_1w_x64(t3, one, t2);
+  inv_EltFp448_1w_x64(den, t3);
+  mul_x448(y3, t1, den);
+  fred_EltFp448_1w_x64(x3);
+  fred_EltFp448_1w_x64(y3);
+}
+
+static void print_words(FILE *out, const uint64_t *const a,
+                        unsigned int num_words, unsigned int words_per_line,
+                        int last) {
+  unsigned int i = 0;
+
+  for (i = 0; i < num_words; i++) {
+    if (i == 0) {
+    } else if (i % words_per_line == 0) {
+      fprintf(out, ",\n               ");
+    } else {
+      fprintf(out, ", ");
+    }
+    fprintf(out, "0x%016" PRIx64, a[i]);
+  }
+  fprintf(out, last ? "};\n" : ",\n");
+}
+
+static void print_license(FILE *out) {
+  unsigned int i = 0;
+
+  for (i = 0; i < sizeof(license) / sizeof(license[0]); i++) {
+    fprintf(out, "%s\n", license[i]);
+  }
+}
+
+static void print_table_x25519(FILE *out) {
+  EltFp25519_1w_x64 px, py, qx, qy, ymx, ypx, xy2d, d2;
+  unsigned int i = 0, j = 0, k = 0;
+  const unsigned int n = NUM_WORDS_ELTFP25519_X64;
+
+  print_license(out);
+  fprintf(out,
+          "\n#ifndef TABLE_COMB_X25519_H\n#define TABLE_COMB_X25519_H\n"
+          "#include <stdint.h>\n\n"
+          "/* Entry (i,j) is j*256^i*B as (y-x, y+x, 2*d*x*y); see "
+          "gen_table_comb.c */\n"
+          "ALIGN static const uint64_t Table_Comb_24k[%u * %u * 3 * "
+          "NUM_WORDS_ELTFP25519_X64] = {\n",
+          COMB_TEETH_X25519, COMB_DIGITS);
+
+  add_EltFp25519_1w_x64(d2, (uint64_t *)param_d_x25519,
+                        (uint64_t *)param_d_x25519);
+  copy_EltFp25519_1w_x64(px, base_x_x25519);
+  copy_EltFp25519_1w_x64(py, base_y_x25519);
+  for (i = 0; i < COMB_TEETH_X25519; i++) {
+    copy_EltFp25519_1w_x64(qx, px);
+    copy_EltFp25519_1w_x64(qy, py);
+    for (j = 1; j <= COMB_DIGITS; j++) {
+      sub_EltFp25519_1w_x64(ymx, qy, qx);
+      add_EltFp25519_1w_x64(ypx, qy, qx);
+      mul_x25519(xy2d, qx, qy);
+      mul_x25519(xy2d, xy2d, d2);
+      fred_EltFp25519_1w_x64(ymx);
+      fred_EltFp25519_1w_x64(ypx);
+      fred_EltFp25519_1w_x64(xy2d);
+
+      fprintf(out, "    /* %2u,%u */ ", i, j);
+      print_words(out, ymx, n, 2, 0);
+      fprintf(out, "               ");
+      print_words(out, ypx, n, 2, 0);
+      fprintf(out, "               ");
+      print_words(out, xy2d, n, 2,
+                  i + 1 == COMB_TEETH_X25519 && j == COMB_DIGITS);
+
+      add_point_x25519(qx, qy, qx, qy, px, py);
+    }
+    /* P = 256*P */
+    for (k = 0; k < 8; k++) {
+      add_point_x25519(px, py, px, py, px, py);
+    }
+  }
+  fprintf(out, "\n#endif /* TABLE_COMB_X25519_H */\n");
+}
+
+static void print_table_x448(FILE *out) {
+  EltFp448_1w_x64 px, py, qx, qy, dxy;
+  unsigned int i = 0, j = 0, k = 0;
+  const unsigned int n = NUM_WORDS_ELTFP448_X64;
+
+  print_license(out);
+  fprintf(out,
+          "\n#ifndef TABLE_COMB_X448_H\n#define TABLE_COMB_X448_H\n"
+          "#include <stdint.h>\n\n"
+          "/* Entry (i,j) is j*2^(32*i)*4B as (x, y, d*x*y); see "
+          "gen_table_comb.c */\n"
+          "ALIGN static const uint64_t Table_Comb_X448_18k[%u * %u * 3 * "
+          "NUM_WORDS_ELTFP448_X64] = {\n",
+          COMB_TEETH_X448, COMB_DIGITS);
+
+  copy_EltFp448_1w_x64(px, base_x_x448);
+  copy_EltFp448_1w_x64(py, base_y_x448);
+  /* P = 4*B */
+  for (k = 0; k < 2; k++) {
+    add_point_x448(px, py, px, py, px, py);
+  }
+  for (i = 0; i < COMB_TEETH_X448; i++) {
+    copy_EltFp448_1w_x64(qx, px);
+    copy_EltFp448_1w_x64(qy, py);
+    for (j = 1; j <= COMB_DIGITS; j++) {
+      mul_x448(dxy, qx, qy);
+      mul_x448(dxy, dxy, (uint64_t *)param_d_x448);
+      fred_EltFp448_1w_x64(dxy);
+
+      fprintf(out, "    /* %2u,%u */ ", i, j);
+      print_words(out, qx, n, 2, 0);
+      fprintf(out, "               ");
+      print_words(out, qy, n, 2, 0);
+      fprintf(out, "               ");
+      print_words(out, dxy, n, 2,
+                  i + 1 == COMB_TEETH_X448 && j == COMB_DIGITS);
+
+      add_point_x448(qx, qy, qx, qy, px, py);
+    }
+    /* P = 2^32*P */
+    for (k = 0; k < 32; k++) {
+      add_point_x448(px, py, px, py, px, py);
+    }
+  }
+  fprintf(out, "\n#endif /* TABLE_COMB_X448_H */\n");
+}
+
+int main(int argc, char *argv[]) {
+  void (*print_table)(FILE *) = NULL;
+  FILE *out = stdout;
+
+  if (argc > 1 && strcmp(argv[1], "x25519") == 0) {
+    print_table = print_table_x25519;
+  } else if (argc > 1 && strcmp(argv[1], "x448") == 0) {
+    print_table = print_table_x448;
+  }
+  if (print_table == NULL || argc > 3) {
+    fprintf(stderr, "usage: %s x25519|x448 [output]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (argc > 2 && strcmp(argv[2], "-") != 0) {
+    out = fopen(argv[2], "w");
+    if (out == NULL) {
+      perror(argv[2]);
+      return EXIT_FAILURE;
+    }
+  }
+  print_table(out);
+  if (out != stdout && fclose(out) != 0) {
+    perror(argv[2]);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,359 @@
+/**
+ * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.
+ * Institute of Computing.
+ * University of Campinas, Brazil.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of University of Campinas nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Generates the tables of the precomputed Montgomery ladder used by
+ * KeyGen (include/table_ladder_x25519.h and include/table_ladder_x448.h).
+ *
+ * Entry k, for k = 0, ..., bits-q-1, is M_k = (u_k+1)/(u_k-1), where u_k
+ * is the u-coordinate of 2^k times the base point; the ladder adds these
+ * points for the scalar bits q, q+1, ..., and then performs q doublings.
+ * The ladder also starts from the point G-S (see x25519_x64.c and
+ * x448_x64.c), which has to be updated when the base point G changes.
+ *
+ * Usage: gen_table_ladder x25519|x448 [q [u [output]]]
+ *   q      number of trailing doublings (3 for X25519, 2 for X448)
+ *   u      u-coordinate of the base point (9 for X25519, 5 for X448),
+ *          written in decimal, as a 0x-prefixed hexadecimal number, or
+ *          as the 64 (X25519) or 112 (X448) hexadecimal digits of its
+ *          little-endian encoding of RFC 7748; it must be less than p
+ *          and belong to the curve, not to its twist
+ *   output header to write, or standard output if omitted or "-"
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fp25519_x64.h"
+#include "fp448_x64.h"
+
+static const char *const license[] = {
+    "/**",
+    " * Copyright (c) 2017, Armando Faz <armfazh@ic.unicamp.br>. All rights reserved.",
+    " * Institute of Computing.",
+    " * University of Campinas, Brazil.",
+    " *",
+    " * Redistribution and use in source and binary forms, with or without",
+    " * modification, are permitted provided that the following conditions",
+    " * are met:",
+    " *",
+    " *  * Redistributions of source code must retain the above copyright",
+    " *    notice, this list of conditions and the following disclaimer.",
+    " *  * Redistributions in binary form must reproduce the above",
+    " *    copyright notice, this list of conditions and the following",
+    " *    disclaimer in the documentation and/or other materials provided",
+    " *    with the distribution.",
+    " *  * Neither the name of University of Campinas nor the names of its",
+    " *    contributors may be used to endorse or promote products derived",
+    " *    from this software without specific prior written permission.",
+    " *",
+    " * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS",
+    " * \"AS IS\" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT",
+    " * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS",
+    " * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE",
+    " * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,",
+    " * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES",
+    " * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR",
+    " * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)",
+    " * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,",
+    " * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)",
+    " * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED",
+    " * OF THE POSSIBILITY OF SUCH DAMAGE.",
+    " */",
+};
+
+typedef struct {
+  const char *name;
+  const char *guard;
+  const char *table;
+  const char *num_words_macro;
+  unsigned int num_words;
+  unsigned int words_per_line;
+  unsigned int bits; /* Length of the clamped scalars */
+  unsigned int q;
+  uint64_t u;
+  /* Sets M to (u+1)/(u-1) and replaces u by the u-coordinate of 2*(u,v) */
+  void (*next)(uint64_t *const M, uint64_t *const u);
+  /* Returns NULL if u can be the base point, or else the reason why not */
+  const char *(*check)(uint64_t *const u);
+} Curve;
+
+static void next_x25519(uint64_t *const M, uint64_t *const U) {
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  EltFp25519_1w_x64 one = {1}, A, B, E, T;
+
+  add_EltFp25519_1w_x64(A, U, one);    /* A = u+1                       */
+  sub_EltFp25519_1w_x64(B, U, one);    /* B = u-1                       */
+  inv_EltFp25519_1w_x64(T, B);         /* T = 1/(u-1)                   */
+  mul_EltFp25519_1w_x64(M, A, T);      /* M = (u+1)/(u-1)               */
+  fred_EltFp25519_1w_x64(M);
+
+  sqr_EltFp25519_1w_x64(A);            /* A = AA                        */
+  sqr_EltFp25519_1w_x64(B);            /* B = BB                        */
+  sub_EltFp25519_1w_x64(E, A, B);      /* E = AA-BB                     */
+  mul_a24_EltFp25519_1w_x64(T, E);     /* T = a24*E                     */
+  add_EltFp25519_1w_x64(T, T, B);      /* T = a24*E+BB                  */
+  mul_EltFp25519_1w_x64(T, T, E);      /* T = E*(a24*E+BB)              */
+  inv_EltFp25519_1w_x64(E, T);         /* E = 1/T                       */
+  mul_EltFp25519_1w_x64(T, A, B);      /* T = AA*BB                     */
+  mul_EltFp25519_1w_x64(U, T, E);      /* u = AA*BB/(E*(a24*E+BB))      */
+  fred_EltFp25519_1w_x64(U);
+}
+
+static void next_x448(uint64_t *const M, uint64_t *const U) {
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  EltFp448_1w_x64 one = {1}, A, B, E, T;
+
+  add_EltFp448_1w_x64(A, U, one);      /* A = u+1                       */
+  sub_EltFp448_1w_x64(B, U, one);      /* B = u-1                       */
+  inv_EltFp448_1w_x64(T, B);           /* T = 1/(u-1)                   */
+  mul_EltFp448_1w_x64(M, A, T);        /* M = (u+1)/(u-1)               */
+  fred_EltFp448_1w_x64(M);
+
+  sqr_EltFp448_1w_x64(A);              /* A = AA                        */
+  sqr_EltFp448_1w_x64(B);              /* B = BB                        */
+  sub_EltFp448_1w_x64(E, A, B);        /* E = AA-BB                     */
+  mul_a24_EltFp448_1w_x64(T, E);       /* T = a24*E                     */
+  add_EltFp448_1w_x64(T, T, B);        /* T = a24*E+BB                  */
+  mul_EltFp448_1w_x64(T, T, E);        /* T = E*(a24*E+BB)              */
+  inv_EltFp448_1w_x64(E, T);           /* E = 1/T                       */
+  mul_EltFp448_1w_x64(T, A, B);        /* T = AA*BB                     */
+  mul_EltFp448_1w_x64(U, T, E);        /* u = AA*BB/(E*(a24*E+BB))      */
+  fred_EltFp448_1w_x64(U);
+}
+
+/**
+ * The base point must be a point (u,v) with u < p and v in GF(p), that
+ * is, u^3+A*u^2+u must be a square; a non-square puts it on the twist.
+ * The ladder also needs u != 1 for M, and u^3+A*u^2+u != 0 excludes the
+ * points of order 2.
+ */
+static const char *check_x25519(uint64_t *const U) {
+  EltFp25519_1w_Buffer_x64 buffer_1w;
+  EltFp25519_1w_x64 one = {1}, A = {486662}, W, T;
+  uint64_t zero[NUM_WORDS_ELTFP25519_X64] = {0};
+
+  copy_EltFp25519_1w_x64(T, U);
+  fred_EltFp25519_1w_x64(T);
+  if (memcmp(T, U, SIZE_BYTES_FP25519) != 0) {
+    return "u is not less than p";
+  }
+  if (memcmp(U, one, SIZE_BYTES_FP25519) == 0) {
+    return "u = 1 has no entry (u+1)/(u-1)";
+  }
+  add_EltFp25519_1w_x64(W, U, A);      /* W = u+A                       */
+  mul_EltFp25519_1w_x64(W, W, U);      /* W = u^2+A*u                   */
+  add_EltFp25519_1w_x64(W, W, one);    /* W = u^2+A*u+1                 */
+  mul_EltFp25519_1w_x64(W, W, U);      /* W = u^3+A*u^2+u               */
+  fred_EltFp25519_1w_x64(W);
+  if (memcmp(W, zero, SIZE_BYTES_FP25519) == 0) {
+    return "u is a point of order 2";
+  }
+  if (!sqrt_EltFp25519_1w_x64(T, W)) {
+    return "u is a point of the twist";
+  }
+  return NULL;
+}
+
+static const char *check_x448(uint64_t *const U) {
+  EltFp448_1w_Buffer_x64 buffer_1w;
+  EltFp448_1w_x64 one = {1}, A = {156326}, W, T;
+  uint64_t zero[NUM_WORDS_ELTFP448_X64] = {0};
+
+  copy_EltFp448_1w_x64(T, U);
+  fred_EltFp448_1w_x64(T);
+  if (memcmp(T, U, SIZE_BYTES_FP448) != 0) {
+    return "u is not less than p";
+  }
+  if (memcmp(U, one, SIZE_BYTES_FP448) == 0) {
+    return "u = 1 has no entry (u+1)/(u-1)";
+  }
+  add_EltFp448_1w_x64(W, U, A);        /* W = u+A                       */
+  mul_EltFp448_1w_x64(W, W, U);        /* W = u^2+A*u                   */
+  add_EltFp448_1w_x64(W, W, one);      /* W = u^2+A*u+1                 */
+  mul_EltFp448_1w_x64(W, W, U);        /* W = u^3+A*u^2+u               */
+  fred_EltFp448_1w_x64(W);
+  if (memcmp(W, zero, SIZE_BYTES_FP448) == 0) {
+    return "u is a point of order 2";
+  }
+  if (!sqrt_EltFp448_1w_x64(T, W)) {
+    return "u is a point of the twist";
+  }
+  return NULL;
+}
+
+static const Curve curves[] = {
+    {"x25519", "TABLE_LADDER_8K_H", "Table_Ladder_8k",
+     "NUM_WORDS_ELTFP25519_X64", NUM_WORDS_ELTFP25519_X64, 2, 255, 3, 9,
+     next_x25519, check_x25519},
+    {"x448", "TABLE_LADDER_X448_24K_H", "Table_Ladder_24k",
+     "NUM_WORDS_ELTFP448_X64", NUM_WORDS_ELTFP448_X64, 1, 448, 2, 5,
+     next_x448, check_x448}};
+
+/* Returns the value of the hexadecimal digit c, or -1 if it is not one */
+static int hex_digit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  c = (char)tolower((unsigned char)c);
+  return c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+}
+
+/**
+ * Reads u into U[0..num_words-1], accepting the three formats described
+ * in the usage; returns 0 on success and -1 if str is not a number that
+ * fits in num_words words.
+ */
+static int parse_u(uint64_t *const U, const char *str,
+                   unsigned int num_words) {
+  const size_t digits = 16 * num_words;
+  const int hex = str[0] == '0' && (str[1] == 'x' || str[1] == 'X');
+  const size_t len = strlen(str) - (hex ? 2 : 0);
+  size_t i = 0;
+  char *end = NULL;
+
+  memset(U, 0, num_words * sizeof(U[0]));
+  if (hex || len == digits) {
+    if (len == 0 || len > digits) {
+      return -1;
+    }
+    for (i = 0; i < len; i++) {
+      /* Nibble i is the i-th last digit of a hexadecimal number, and the
+       * other digit of its byte in the little-endian encoding */
+      const int d = hex_digit(hex ? str[2 + len - 1 - i] : str[i ^ 1]);
+      if (d < 0) {
+        return -1;
+      }
+      U[i / 16] |= (uint64_t)d << (4 * (i % 16));
+    }
+    return 0;
+  }
+  if (!isdigit((unsigned char)str[0])) {
+    return -1;
+  }
+  errno = 0;
+  U[0] = strtoull(str, &end, 10);
+  return errno != 0 || *end != '\0' ? -1 : 0;
+}
+
+static void print_table(FILE *out, const Curve *curve, unsigned int q,
+                        const uint64_t *const u) {
+  ALIGN uint64_t U[NUM_WORDS_ELTFP448_X64] = {0};
+  ALIGN uint64_t M[NUM_WORDS_ELTFP448_X64] = {0};
+  const unsigned int entries = curve->bits - q;
+  unsigned int i = 0, j = 0;
+
+  for (i = 0; i < sizeof(license) / sizeof(license[0]); i++) {
+    fprintf(out, "%s\n", license[i]);
+  }
+  fprintf(out, "\n#ifndef %s\n#define %s\n#include <stdint.h>\n\n",
+          curve->guard, curve->guard);
+  fprintf(out, "ALIGN static const uint64_t %s[%u * %s] = {\n", curve->table,
+          entries, curve->num_words_macro);
+
+  memcpy(U, u, curve->num_words * sizeof(U[0]));
+  for (i = 0; i < entries; i++) {
+    curve->next(M, U);
+    for (j = 0; j < curve->num_words; j++) {
+      if (j == 0) {
+        fprintf(out, "    /* %3u */ ", i + 1);
+      } else if (j % curve->words_per_line == 0) {
+        fprintf(out, "\n              ");
+      } else {
+        fprintf(out, " ");
+      }
+      fprintf(out, "0x%016" PRIx64 "%s", M[j],
+              i + 1 == entries && j + 1 == curve->num_words ? "};\n" : ",");
+    }
+    if (i + 1 < entries) {
+      fprintf(out, "\n");
+    }
+  }
+  fprintf(out, "\n#endif /* %s */\n", curve->guard);
+}
+
+int main(int argc, char *argv[]) {
+  const Curve *curve = NULL;
+  unsigned int i = 0, q = 0;
+  ALIGN uint64_t u[NUM_WORDS_ELTFP448_X64] = {0};
+  const char *invalid = NULL;
+  FILE *out = stdout;
+
+  for (i = 0; argc > 1 && i < sizeof(curves) / sizeof(curves[0]); i++) {
+    if (strcmp(argv[1], curves[i].name) == 0) {
+      curve = &curves[i];
+    }
+  }
+  if (curve == NULL || argc > 5) {
+    fprintf(stderr,
+            "usage: %s x25519|x448 [q [u [output]]]\n"
+            "  u: decimal, 0x-prefixed hexadecimal, or the 64 (x25519) or\n"
+            "     112 (x448) hexadecimal digits of its little-endian\n"
+            "     encoding; a point of the curve, not of the twist\n",
+            argv[0]);
+    return EXIT_FAILURE;
+  }
+  q = argc > 2 ? (unsigned int)strtoul(argv[2], NULL, 0) : curve->q;
+  if (q >= curve->bits) {
+    fprintf(stderr, "%s: q must be less than %u\n", argv[0], curve->bits);
+    return EXIT_FAILURE;
+  }
+  if (argc <= 3) {
+    u[0] = curve->u;
+  } else if (parse_u(u, argv[3], curve->num_words) != 0) {
+    fprintf(stderr, "%s: u is not a number of %u bytes: %s\n", argv[0],
+            8 * curve->num_words, argv[3]);
+    return EXIT_FAILURE;
+  }
+  invalid = curve->check(u);
+  if (invalid != NULL) {
+    fprintf(stderr, "%s: %s\n", argv[0], invalid);
+    return EXIT_FAILURE;
+  }
+  if (argc > 4 && strcmp(argv[4], "-") != 0) {
+    out = fopen(argv[4], "w");
+    if (out == NULL) {
+      perror(argv[4]);
+      return EXIT_FAILURE;
+    }
+  }
+  print_table(out, curve, q, u);
+  if (out != stdout && fclose(out) != 0) {
+    perror(argv[4]);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}